@@ -26,13 +26,14 @@ class LRUCacheTest : public testing::Test {
   }
 
   void NewCache(size_t capacity, double high_pri_pool_ratio = 0.0,
+                double low_pri_pool_ratio = 0.0,
                 bool use_adaptive_mutex = kDefaultToAdaptiveMutex) {
     DeleteCache();
     cache_ = reinterpret_cast<LRUCacheShard*>(
         port::cacheline_aligned_alloc(sizeof(LRUCacheShard)));
     new (cache_) LRUCacheShard(capacity, false /*strict_capcity_limit*/,
-                               high_pri_pool_ratio, use_adaptive_mutex,
-                               kDontChargeCacheMetadata);
+                               high_pri_pool_ratio, low_pri_pool_ratio,
+                               use_adaptive_mutex, kDontChargeCacheMetadata);
   }
 
   void Insert(const std::string& key,
@@ -60,14 +61,22 @@ class LRUCacheTest : public testing::Test {
   void Erase(const std::string& key) { cache_->Erase(key, 0 /*hash*/); }
 
   void ValidateLRUList(std::vector<std::string> keys,
-                       size_t num_high_pri_pool_keys = 0) {
+                       size_t num_high_pri_pool_keys = 0,
+                       size_t num_low_pri_pool_keys = 0) {
     LRUHandle* lru;
     LRUHandle* lru_low_pri;
-    cache_->TEST_GetLRUList(&lru, &lru_low_pri);
+    LRUHandle* lru_bottom_pri;
+    cache_->TEST_GetLRUList(&lru, &lru_low_pri, &lru_bottom_pri);
     LRUHandle* iter = lru;
+    bool in_low_pri_pool = false;
     bool in_high_pri_pool = false;
     size_t high_pri_pool_keys = 0;
+    size_t low_pri_pool_keys = 0;
+    if (iter == lru_bottom_pri) {
+      in_low_pri_pool = true;
+    }
     if (iter == lru_low_pri) {
+      in_low_pri_pool = false;
       in_high_pri_pool = true;
     }
     for (const auto& key : keys) {
@@ -75,17 +84,32 @@ class LRUCacheTest : public testing::Test {
       ASSERT_NE(lru, iter);
       ASSERT_EQ(key, iter->key().ToString());
       ASSERT_EQ(in_high_pri_pool, iter->InHighPriPool());
+      ASSERT_EQ(in_low_pri_pool, iter->InLowPriPool());
       if (in_high_pri_pool) {
         high_pri_pool_keys++;
+      } else if (in_low_pri_pool) {
+        low_pri_pool_keys++;
+      }
+      if (iter == lru_bottom_pri) {
+        ASSERT_FALSE(in_low_pri_pool);
+        ASSERT_FALSE(in_high_pri_pool);
+        in_low_pri_pool = true;
       }
       if (iter == lru_low_pri) {
+        ASSERT_TRUE(in_low_pri_pool);
         ASSERT_FALSE(in_high_pri_pool);
+        in_low_pri_pool = false;
         in_high_pri_pool = true;
       }
     }
     ASSERT_EQ(lru, iter->next);
     ASSERT_TRUE(in_high_pri_pool);
     ASSERT_EQ(num_high_pri_pool_keys, high_pri_pool_keys);
+    ASSERT_EQ(num_low_pri_pool_keys, low_pri_pool_keys);
+  }
+
+  size_t GetPriorityPoolUsage(Cache::Priority priority) {
+    return cache_->GetPriorityPoolUsage(priority);
   }
 
  private:
@@ -191,6 +215,66 @@ TEST_F(LRUCacheTest, EntriesWithPriority) {
   ValidateLRUList({"e", "f", "g", "Z", "d"}, 2);
 }
 
+TEST_F(LRUCacheTest, ThreeTierPriority) {
+  // Allocate 2 cache entries to high-pri pool and 2 to low-pri pool.
+  NewCache(6, 0.34, 0.34);
+
+  Insert("a", Cache::Priority::BOTTOM);
+  Insert("b", Cache::Priority::BOTTOM);
+  Insert("c", Cache::Priority::LOW);
+  Insert("d", Cache::Priority::LOW);
+  Insert("x", Cache::Priority::HIGH);
+  Insert("y", Cache::Priority::HIGH);
+  ValidateLRUList({"a", "b", "c", "d", "x", "y"}, 2, 2);
+  ASSERT_EQ(GetPriorityPoolUsage(Cache::Priority::HIGH), 2);
+  ASSERT_EQ(GetPriorityPoolUsage(Cache::Priority::LOW), 2);
+  ASSERT_EQ(GetPriorityPoolUsage(Cache::Priority::BOTTOM), 2);
+
+  // High-pri entries overflow to the low-pri pool, and low-pri entries
+  // overflow to the bottom-pri pool.
+  Insert("z", Cache::Priority::HIGH);
+  ValidateLRUList({"b", "c", "d", "x", "y", "z"}, 2, 2);
+
+  // Low-pri entries will be inserted to head of low-pri pool.
+  Insert("e", Cache::Priority::LOW);
+  ValidateLRUList({"c", "d", "x", "e", "y", "z"}, 2, 2);
+
+  // Bottom-pri entries will be inserted to head of bottom-pri pool.
+  Insert("f", Cache::Priority::BOTTOM);
+  ValidateLRUList({"d", "f", "x", "e", "y", "z"}, 2, 2);
+
+  // Bottom-pri entries will be inserted to head of high-pri pool after lookup.
+  ASSERT_TRUE(Lookup("d"));
+  ValidateLRUList({"f", "x", "e", "y", "z", "d"}, 2, 2);
+
+  Erase("e");
+  Erase("y");
+  ValidateLRUList({"f", "x", "z", "d"}, 2, 0);
+  ASSERT_EQ(GetPriorityPoolUsage(Cache::Priority::HIGH), 2);
+  ASSERT_EQ(GetPriorityPoolUsage(Cache::Priority::LOW), 0);
+  ASSERT_EQ(GetPriorityPoolUsage(Cache::Priority::BOTTOM), 2);
+
+  Insert("g", Cache::Priority::LOW);
+  ValidateLRUList({"f", "x", "g", "z", "d"}, 2, 1);
+}
+
+TEST_F(LRUCacheTest, LowPriPoolWithoutHighPriPool) {
+  // Allocate 2 cache entries to low-pri pool only. High-pri entries are then
+  // inserted to the low-pri pool.
+  NewCache(4, 0.0, 0.5);
+
+  Insert("a", Cache::Priority::BOTTOM);
+  Insert("x", Cache::Priority::HIGH);
+  Insert("b", Cache::Priority::LOW);
+  ValidateLRUList({"a", "x", "b"}, 0, 2);
+
+  Insert("c", Cache::Priority::LOW);
+  ValidateLRUList({"a", "x", "b", "c"}, 0, 2);
+
+  Insert("d", Cache::Priority::BOTTOM);
+  ValidateLRUList({"x", "d", "b", "c"}, 0, 2);
+}
+
 }  // namespace ROCKSDB_NAMESPACE
 
 int main(int argc, char** argv) {
@@ -153,7 +153,7 @@ Status BuildTable(
       file_writer.reset(new WritableFileWriter(
           std::move(file), fname, file_options, env, io_tracer,
           ioptions.statistics, ioptions.listeners,
-          ioptions.file_checksum_gen_factory));
+          ioptions.file_checksum_gen_factory, fs));
 
       builder = NewTableBuilder(
           ioptions, mutable_cf_options, internal_comparator,
@@ -117,6 +117,8 @@ void GetIntTblPropCollectorFactory(
     int_tbl_prop_collector_factories->emplace_back(
         new UserKeyTablePropertiesCollectorFactory(collector_factories[i]));
   }
+  int_tbl_prop_collector_factories->emplace_back(
+      new TombstoneRunsCollectorFactory());
 }
 
 Status CheckCompressionSupported(const ColumnFamilyOptions& cf_options) {
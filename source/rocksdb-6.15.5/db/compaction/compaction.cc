@@ -351,6 +351,37 @@ bool Compaction::IsTrivialMove() const {
   return true;
 }
 
+bool Compaction::CanSplitForTrivialMove() const {
+  if (!mutable_cf_options_.allow_partial_trivial_move ||
+      immutable_cf_options_.compaction_style != kCompactionStyleLevel ||
+      is_manual_compaction_) {
+    return false;
+  }
+  // L0 files may overlap each other, so only files of sorted levels are split.
+  if (start_level_ == 0 || output_level_ != start_level_ + 1 ||
+      num_input_levels() != 2 || inputs_[0].size() != 1 ||
+      inputs_[1].empty()) {
+    return false;
+  }
+  const FileMetaData* file = input(0, 0);
+  if (file->fd.GetPathId() != output_path_id() ||
+      !InputCompressionMatchesOutput() ||
+      immutable_cf_options_.sst_partitioner_factory != nullptr) {
+    return false;
+  }
+
+  // Like for a trivial move, avoid moving data onto lots of grandparent data.
+  if (output_level_ + 1 < number_levels_) {
+    std::vector<FileMetaData*> file_grand_parents;
+    input_vstorage_->GetOverlappingInputs(output_level_ + 1, &file->smallest,
+                                          &file->largest, &file_grand_parents);
+    if (TotalFileSize(file_grand_parents) > max_compaction_bytes_) {
+      return false;
+    }
+  }
+  return true;
+}
+
 void Compaction::AddInputDeletions(VersionEdit* out_edit) {
   for (size_t which = 0; which < num_input_levels(); which++) {
     for (size_t i = 0; i < inputs_[which].size(); i++) {
@@ -556,6 +587,20 @@ bool Compaction::IsOutputLevelEmpty() const {
   return inputs_.back().level != output_level_ || inputs_.back().empty();
 }
 
+bool Compaction::DoesInputReferenceBlobFiles() const {
+  for (size_t i = 0; i < inputs_.size(); ++i) {
+    for (const FileMetaData* meta : inputs_[i].files) {
+      assert(meta);
+
+      if (meta->oldest_blob_file_number != kInvalidBlobFileNumber) {
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
 bool Compaction::ShouldFormSubcompactions() const {
   if (max_subcompactions_ <= 1 || cfd_ == nullptr) {
     return false;
@@ -173,6 +173,11 @@ class Compaction {
   // moving a single input file to the next level (no merging or splitting)
   bool IsTrivialMove() const;
 
+  // Whether the parts of the single start level input file that do not
+  // overlap the output level inputs may be moved to the output level without
+  // rewriting them, see DBImpl::PartialTrivialMove().
+  bool CanSplitForTrivialMove() const;
+
   // If true, then the compaction can be done by simply deleting input files.
   bool deletion_compaction() const { return deletion_compaction_; }
 
@@ -266,6 +271,9 @@ class Compaction {
   // Should this compaction be broken up into smaller ones run in parallel?
   bool ShouldFormSubcompactions() const;
 
+  // Does any of the input files reference a blob file?
+  bool DoesInputReferenceBlobFiles() const;
+
   // test function to validate the functionality of IsBottommostLevel()
   // function -- determines if compaction with inputs and storage is bottommost
   static bool TEST_IsBottommostLevel(
@@ -6,8 +6,11 @@
 #include "db/compaction/compaction_iterator.h"
 
 #include <cinttypes>
+#include <iterator>
+#include <limits>
 
 #include "db/blob/blob_file_builder.h"
+#include "db/blob/blob_index.h"
 #include "db/snapshot_checker.h"
 #include "port/likely.h"
 #include "rocksdb/listener.h"
@@ -104,6 +107,39 @@ CompactionIterator::CompactionIterator(
                                 !compaction_->allow_ingest_behind();
   if (compaction_ != nullptr) {
     level_ptrs_ = std::vector<size_t>(compaction_->number_levels(), 0);
+
+    if (compaction_->enable_blob_garbage_collection() &&
+        compaction_->input_version() != nullptr) {
+      const VersionStorageInfo* const storage_info =
+          compaction_->input_version()->storage_info();
+      assert(storage_info);
+
+      const auto& blob_files = storage_info->GetBlobFiles();
+
+      auto it = blob_files.begin();
+      std::advance(it, static_cast<size_t>(
+                           compaction_->blob_garbage_collection_age_cutoff() *
+                           blob_files.size()));
+      blob_garbage_collection_cutoff_file_number_ =
+          it != blob_files.end() ? it->first
+                                 : std::numeric_limits<uint64_t>::max();
+
+      const double force_threshold =
+          compaction_->blob_garbage_collection_force_threshold();
+      if (force_threshold < 1.0) {
+        for (const auto& pair : blob_files) {
+          const auto& meta = pair.second;
+          assert(meta);
+
+          const uint64_t total_bytes = meta->GetTotalBlobBytes();
+          if (total_bytes > 0 &&
+              static_cast<double>(meta->GetGarbageBlobBytes()) >=
+                  force_threshold * static_cast<double>(total_bytes)) {
+            forced_blob_gc_file_numbers_.insert(pair.first);
+          }
+        }
+      }
+    }
   }
   if (snapshots_->size() == 0) {
     // optimize for fast path if there are no snapshots
@@ -117,6 +153,18 @@ CompactionIterator::CompactionIterator(
     earliest_snapshot_ = snapshots_->at(0);
     latest_snapshot_ = snapshots_->back();
   }
+  // The batches are filtered on the first entry of each user key, which is
+  // only where the filter runs without a snapshot checker or timestamps.
+  if (compaction_filter_ != nullptr &&
+      compaction_->compaction_filter_batch_size() > 0 &&
+      snapshot_checker_ == nullptr && timestamp_size_ == 0) {
+    filter_batch_iter_.reset(new FilterBatchIterator(
+        input_, compaction_filter_, compaction_->level(), cmp_,
+        compaction_->compaction_filter_batch_size(),
+        compaction_->compaction_filter_batch_threads(), env_,
+        report_detailed_time_));
+    input_ = filter_batch_iter_.get();
+  }
 #ifndef NDEBUG
   // findEarliestVisibleSnapshot assumes this ordering.
   for (size_t i = 1; i < snapshots_->size(); ++i) {
@@ -214,7 +262,13 @@ bool CompactionIterator::InvokeFilterIfNeeded(bool* need_skip,
     // Hack: pass internal key to BlobIndexCompactionFilter since it needs
     // to get sequence number.
     Slice& filter_key = ikey_.type == kTypeValue ? ikey_.user_key : key_;
-    {
+    uint64_t filter_nanos = 0;
+    if (filter_batch_iter_ != nullptr &&
+        filter_batch_iter_->GetFilterDecision(
+            &filter, &compaction_filter_value_,
+            compaction_filter_skip_until_.rep(), &filter_nanos)) {
+      iter_stats_.total_filter_time += filter_nanos;
+    } else {
       StopWatchNano timer(env_, report_detailed_time_);
       filter = compaction_filter_->FilterV2(
           compaction_->level(), filter_key, value_type, value_,
@@ -733,40 +787,135 @@ void CompactionIterator::NextFromInput() {
   }
 }
 
+bool CompactionIterator::ExtractLargeValueIfNeededImpl() {
+  if (!blob_file_builder_) {
+    return false;
+  }
+
+  blob_index_.clear();
+  const Status s = blob_file_builder_->Add(user_key(), value_, &blob_index_);
+
+  if (!s.ok()) {
+    status_ = s;
+    valid_ = false;
+
+    return false;
+  }
+
+  if (blob_index_.empty()) {
+    return false;
+  }
+
+  value_ = blob_index_;
+
+  return true;
+}
+
+void CompactionIterator::ExtractLargeValueIfNeeded() {
+  assert(ikey_.type == kTypeValue);
+
+  if (!ExtractLargeValueIfNeededImpl()) {
+    return;
+  }
+
+  ikey_.type = kTypeBlobIndex;
+  current_key_.UpdateInternalKey(ikey_.sequence, ikey_.type);
+}
+
+bool CompactionIterator::IsBlobFileEligibleForGC(
+    uint64_t blob_file_number) const {
+  return blob_file_number < blob_garbage_collection_cutoff_file_number_ ||
+         forced_blob_gc_file_numbers_.count(blob_file_number) > 0;
+}
+
+void CompactionIterator::GarbageCollectBlobIfNeeded() {
+  assert(ikey_.type == kTypeBlobIndex);
+
+  if (!compaction_) {
+    return;
+  }
+
+  // GC for integrated BlobDB
+  if (compaction_->enable_blob_garbage_collection()) {
+    BlobIndex blob_index;
+
+    {
+      const Status s = blob_index.DecodeFrom(value_);
+
+      if (!s.ok()) {
+        status_ = s;
+        valid_ = false;
+
+        return;
+      }
+    }
+
+    if (blob_index.IsInlined() || blob_index.HasTTL()) {
+      status_ = Status::Corruption("Unexpected TTL/inlined blob index");
+      valid_ = false;
+
+      return;
+    }
+
+    if (!IsBlobFileEligibleForGC(blob_index.file_number())) {
+      return;
+    }
+
+    const Version* const version = compaction_->input_version();
+    assert(version);
+
+    {
+      const Status s =
+          version->GetBlob(ReadOptions(), user_key(), blob_index, &blob_value_);
+
+      if (!s.ok()) {
+        status_ = s;
+        valid_ = false;
+
+        return;
+      }
+    }
+
+    value_ = blob_value_;
+
+    if (ExtractLargeValueIfNeededImpl()) {
+      return;
+    }
+
+    if (!valid_) {
+      return;
+    }
+
+    ikey_.type = kTypeValue;
+    current_key_.UpdateInternalKey(ikey_.sequence, ikey_.type);
+
+    return;
+  }
+
+  // GC for stacked BlobDB
+  if (compaction_filter_) {
+    const auto blob_decision = compaction_filter_->PrepareBlobOutput(
+        user_key(), value_, &compaction_filter_value_);
+
+    if (blob_decision == CompactionFilter::BlobDecision::kCorruption) {
+      status_ =
+          Status::Corruption("Corrupted blob reference encountered during GC");
+      valid_ = false;
+    } else if (blob_decision == CompactionFilter::BlobDecision::kIOError) {
+      status_ = Status::IOError("Could not relocate blob during GC");
+      valid_ = false;
+    } else if (blob_decision == CompactionFilter::BlobDecision::kChangeValue) {
+      value_ = compaction_filter_value_;
+    }
+  }
+}
+
 void CompactionIterator::PrepareOutput() {
   if (valid_) {
     if (ikey_.type == kTypeValue) {
-      if (blob_file_builder_) {
-        blob_index_.clear();
-        const Status s =
-            blob_file_builder_->Add(user_key(), value_, &blob_index_);
-
-        if (!s.ok()) {
-          status_ = s;
-          valid_ = false;
-        } else if (!blob_index_.empty()) {
-          value_ = blob_index_;
-          ikey_.type = kTypeBlobIndex;
-          current_key_.UpdateInternalKey(ikey_.sequence, ikey_.type);
-        }
-      }
+      ExtractLargeValueIfNeeded();
     } else if (ikey_.type == kTypeBlobIndex) {
-      if (compaction_filter_) {
-        const auto blob_decision = compaction_filter_->PrepareBlobOutput(
-            user_key(), value_, &compaction_filter_value_);
-
-        if (blob_decision == CompactionFilter::BlobDecision::kCorruption) {
-          status_ = Status::Corruption(
-              "Corrupted blob reference encountered during GC");
-          valid_ = false;
-        } else if (blob_decision == CompactionFilter::BlobDecision::kIOError) {
-          status_ = Status::IOError("Could not relocate blob during GC");
-          valid_ = false;
-        } else if (blob_decision ==
-                   CompactionFilter::BlobDecision::kChangeValue) {
-          value_ = compaction_filter_value_;
-        }
-      }
+      GarbageCollectBlobIfNeeded();
     }
 
     // Zeroing out the sequence number leads to better compression.
@@ -10,8 +10,10 @@
 #include <unordered_set>
 #include <vector>
 
+#include "db/blob/blob_constants.h"
 #include "db/compaction/compaction.h"
 #include "db/compaction/compaction_iteration_stats.h"
+#include "db/compaction/filter_batch_iterator.h"
 #include "db/merge_helper.h"
 #include "db/pinned_iterators_manager.h"
 #include "db/range_del_aggregator.h"
@@ -45,6 +47,18 @@ class CompactionIterator {
     virtual bool allow_ingest_behind() const = 0;
 
     virtual bool preserve_deletes() const = 0;
+
+    virtual bool enable_blob_garbage_collection() const = 0;
+
+    virtual double blob_garbage_collection_age_cutoff() const = 0;
+
+    virtual double blob_garbage_collection_force_threshold() const = 0;
+
+    virtual size_t compaction_filter_batch_size() const = 0;
+
+    virtual int compaction_filter_batch_threads() const = 0;
+
+    virtual const Version* input_version() const = 0;
   };
 
   class RealCompaction : public CompactionProxy {
@@ -80,6 +94,33 @@ class CompactionIterator {
       return compaction_->immutable_cf_options()->preserve_deletes;
     }
 
+    bool enable_blob_garbage_collection() const override {
+      return compaction_->mutable_cf_options()->enable_blob_garbage_collection;
+    }
+
+    double blob_garbage_collection_age_cutoff() const override {
+      return compaction_->mutable_cf_options()
+          ->blob_garbage_collection_age_cutoff;
+    }
+
+    double blob_garbage_collection_force_threshold() const override {
+      return compaction_->mutable_cf_options()
+          ->blob_garbage_collection_force_threshold;
+    }
+
+    size_t compaction_filter_batch_size() const override {
+      return compaction_->mutable_cf_options()->compaction_filter_batch_size;
+    }
+
+    int compaction_filter_batch_threads() const override {
+      return compaction_->mutable_cf_options()
+          ->compaction_filter_batch_threads;
+    }
+
+    const Version* input_version() const override {
+      return compaction_->input_version();
+    }
+
    private:
     const Compaction* compaction_;
   };
@@ -151,6 +192,32 @@ class CompactionIterator {
   // compression.
   void PrepareOutput();
 
+  // Passes the output value to the blob file builder (if any), and replaces it
+  // with the corresponding blob reference if it has been actually written to a
+  // blob file (i.e. if it passed the value size check). Returns true if the
+  // value got extracted to a blob file, false otherwise.
+  bool ExtractLargeValueIfNeededImpl();
+
+  // Extracts large values as described above, and updates the internal key's
+  // type to kTypeBlobIndex if the value got extracted. Should only be called
+  // for regular values (kTypeValue).
+  void ExtractLargeValueIfNeeded();
+
+  // Relocates valid blobs residing in the oldest blob files (or in blob files
+  // whose garbage ratio exceeds the force threshold) if garbage collection is
+  // enabled. Relocated blobs are written to new blob files or inlined in the
+  // LSM tree depending on the current settings (i.e. enable_blob_files and
+  // min_blob_size). Should only be called for blob references
+  // (kTypeBlobIndex).
+  //
+  // Note: the stacked BlobDB implementation's compaction filter based GC
+  // algorithm is also called from here.
+  void GarbageCollectBlobIfNeeded();
+
+  // Returns true if the blob file with the given number is subject to
+  // garbage collection during this compaction.
+  bool IsBlobFileEligibleForGC(uint64_t blob_file_number) const;
+
   // Invoke compaction filter if needed.
   // Return true on success, false on failures (e.g.: kIOError).
   bool InvokeFilterIfNeeded(bool* need_skip, Slice* skip_until);
@@ -192,6 +259,9 @@ class CompactionIterator {
   }
 
   InternalIterator* input_;
+  // Wraps the input when the compaction filter runs in batches, see
+  // compaction_filter_batch_size. input_ then points to it.
+  std::unique_ptr<FilterBatchIterator> filter_batch_iter_;
   const Comparator* cmp_;
   MergeHelper* merge_helper_;
   const std::vector<SequenceNumber>* snapshots_;
@@ -274,6 +344,13 @@ class CompactionIterator {
   // merge operands and then releasing them after consuming them.
   PinnedIteratorsManager pinned_iters_mgr_;
   std::string blob_index_;
+  PinnableSlice blob_value_;
+  // Blob files with numbers less than this one are relocated by garbage
+  // collection; see blob_garbage_collection_age_cutoff.
+  uint64_t blob_garbage_collection_cutoff_file_number_ = kInvalidBlobFileNumber;
+  // Blob files whose garbage ratio reached
+  // blob_garbage_collection_force_threshold.
+  std::unordered_set<uint64_t> forced_blob_gc_file_numbers_;
   std::string compaction_filter_value_;
   InternalKey compaction_filter_skip_until_;
   // "level_ptrs" holds indices that remember which file of an associated
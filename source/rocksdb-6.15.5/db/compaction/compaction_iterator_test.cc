@@ -176,11 +176,33 @@ class FakeCompaction : public CompactionIterator::CompactionProxy {
 
   bool preserve_deletes() const override { return false; }
 
+  bool enable_blob_garbage_collection() const override { return false; }
+
+  double blob_garbage_collection_age_cutoff() const override { return 0.0; }
+
+  double blob_garbage_collection_force_threshold() const override {
+    return 1.0;
+  }
+
+  size_t compaction_filter_batch_size() const override {
+    return filter_batch_size;
+  }
+
+  int compaction_filter_batch_threads() const override {
+    return filter_batch_threads;
+  }
+
+  const Version* input_version() const override { return nullptr; }
+
   bool key_not_exists_beyond_output_level = false;
 
   bool is_bottommost_level = false;
 
   bool is_allow_ingest_behind = false;
+
+  size_t filter_batch_size = 0;
+
+  int filter_batch_threads = 0;
 };
 
 // A simplifed snapshot checker which assumes each snapshot has a global
@@ -250,6 +272,8 @@ class CompactionIteratorTest : public testing::TestWithParam<bool> {
       compaction_proxy_->is_allow_ingest_behind = AllowIngestBehind();
       compaction_proxy_->key_not_exists_beyond_output_level =
           key_not_exists_beyond_output_level;
+      compaction_proxy_->filter_batch_size = filter_batch_size_;
+      compaction_proxy_->filter_batch_threads = filter_batch_threads_;
       compaction.reset(compaction_proxy_);
     }
     bool use_snapshot_checker = UseSnapshotChecker() || GetParam();
@@ -336,6 +360,8 @@ class CompactionIteratorTest : public testing::TestWithParam<bool> {
   std::unique_ptr<SnapshotChecker> snapshot_checker_;
   std::atomic<bool> shutting_down_{false};
   FakeCompaction* compaction_proxy_;
+  size_t filter_batch_size_ = 0;
+  int filter_batch_threads_ = 0;
 };
 
 // It is possible that the output of the compaction iterator is empty even if
@@ -520,6 +546,76 @@ TEST_P(CompactionIteratorTest, CompactionFilterSkipUntil) {
   ASSERT_EQ(expected_actions, iter_->log);
 }
 
+TEST_P(CompactionIteratorTest, CompactionFilterBatch) {
+  class Filter : public CompactionFilter {
+   public:
+    Decision FilterV2(int /*level*/, const Slice& key, ValueType /*t*/,
+                      const Slice& /*existing_value*/, std::string* new_value,
+                      std::string* skip_until) const override {
+      num_single_calls.fetch_add(1);
+      if (key == "b") {
+        return Decision::kRemove;
+      }
+      if (key == "c") {
+        *new_value = "cv-new";
+        return Decision::kChangeValue;
+      }
+      if (key == "d") {
+        *skip_until = "e+";
+        return Decision::kRemoveAndSkipUntil;
+      }
+      return Decision::kKeep;
+    }
+
+    void FilterBatch(int level, std::vector<BatchEntry>* batch) const override {
+      num_batches.fetch_add(1);
+      EXPECT_LE(batch->size(), 2u);
+      CompactionFilter::FilterBatch(level, batch);
+    }
+
+    const char* Name() const override {
+      return "CompactionIteratorTest.CompactionFilterBatch::Filter";
+    }
+
+    mutable std::atomic<int> num_single_calls{0};
+    mutable std::atomic<int> num_batches{0};
+  };
+
+  const std::vector<std::string> input_keys = {
+      test::KeyStr("a", 50, kTypeValue), test::KeyStr("a", 45, kTypeValue),
+      test::KeyStr("b", 60, kTypeValue), test::KeyStr("c", 35, kTypeValue),
+      test::KeyStr("d", 70, kTypeValue), test::KeyStr("e", 71, kTypeValue),
+      test::KeyStr("f", 65, kTypeValue), test::KeyStr("g", 90, kTypeDeletion),
+      test::KeyStr("g", 80, kTypeValue), test::KeyStr("h", 91, kTypeValue)};
+  const std::vector<std::string> input_values = {
+      "av50", "av45", "bv60", "cv35", "dv70",
+      "ev71", "fv65", "",     "gv80", "hv91"};
+  const std::vector<std::string> expected_keys = {
+      test::KeyStr("a", 50, kTypeValue), test::KeyStr("b", 60, kTypeDeletion),
+      test::KeyStr("c", 35, kTypeValue), test::KeyStr("f", 65, kTypeValue),
+      test::KeyStr("g", 90, kTypeDeletion), test::KeyStr("h", 91, kTypeValue)};
+  const std::vector<std::string> expected_values = {"av50", "",   "cv-new",
+                                                    "fv65", "",   "hv91"};
+
+  for (int num_threads : {0, 2}) {
+    filter_batch_size_ = 2;
+    filter_batch_threads_ = num_threads;
+    Filter filter;
+    RunTest(input_keys, input_values, expected_keys, expected_values,
+            kMaxSequenceNumber, nullptr, &filter);
+    // With a snapshot checker the filter runs on each key as it goes.
+    if (GetParam()) {
+      ASSERT_EQ(0, filter.num_batches.load());
+    } else {
+      ASSERT_GT(filter.num_batches.load(), 0);
+    }
+    // "e" is read ahead and filtered, but skipped by the compaction.
+    ASSERT_GE(filter.num_single_calls.load(), 6);
+  }
+  filter_batch_size_ = 0;
+  filter_batch_threads_ = 0;
+}
+
 TEST_P(CompactionIteratorTest, ShuttingDownInFilter) {
   NoMergingMergeOp merge_op;
   StallingFilter filter;
@@ -20,8 +20,10 @@
 #include <utility>
 #include <vector>
 
+#include "db/blob/blob_counting_iterator.h"
 #include "db/blob/blob_file_addition.h"
 #include "db/blob/blob_file_builder.h"
+#include "db/blob/blob_garbage_meter.h"
 #include "db/builder.h"
 #include "db/db_impl/db_impl.h"
 #include "db/db_iter.h"
@@ -101,6 +103,12 @@ const char* GetCompactionReasonString(CompactionReason compaction_reason) {
       return "ExternalSstIngestion";
     case CompactionReason::kPeriodicCompaction:
       return "PeriodicCompaction";
+    case CompactionReason::kForcedBlobGC:
+      return "ForcedBlobGC";
+    case CompactionReason::kReadTriggered:
+      return "ReadTriggered";
+    case CompactionReason::kTemperatureMigration:
+      return "TemperatureMigration";
     case CompactionReason::kNumOfReasons:
       // fall through
     default:
@@ -144,6 +152,10 @@ struct CompactionJob::SubcompactionState {
   std::unique_ptr<WritableFileWriter> outfile;
   std::unique_ptr<TableBuilder> builder;
 
+  // Measures the blob inflow and outflow of this subcompaction; only set if
+  // the compaction input references blob files.
+  std::unique_ptr<BlobGarbageMeter> blob_garbage_meter;
+
   Output* current_output() {
     if (outputs.empty()) {
       // This subcompaction's output could be empty if compaction was aborted
@@ -171,9 +183,21 @@ struct CompactionJob::SubcompactionState {
   uint64_t overlapped_bytes = 0;
   // A flag determine whether the key has been seen in ShouldStopBefore()
   bool seen_key = false;
-
-  SubcompactionState(Compaction* c, Slice* _start, Slice* _end, uint64_t size)
-      : compaction(c), start(_start), end(_end), approx_size(size) {
+  // Index of this subcompaction within its compaction job.
+  uint32_t sub_job_id;
+  // Work stealing state, protected by CompactionJob::split_mu_: whether the
+  // subcompaction finished processing keys, and whether it failed to give
+  // up part of its range before.
+  bool done = false;
+  bool split_tried = false;
+
+  SubcompactionState(Compaction* c, Slice* _start, Slice* _end, uint64_t size,
+                     uint32_t _sub_job_id)
+      : compaction(c),
+        start(_start),
+        end(_end),
+        approx_size(size),
+        sub_job_id(_sub_job_id) {
     assert(compaction != nullptr);
   }
 
@@ -187,6 +211,12 @@ struct CompactionJob::SubcompactionState {
     if (!s.ok()) {
       return s;
     }
+    if (blob_garbage_meter) {
+      s = blob_garbage_meter->ProcessOutFlow(key, value);
+      if (!s.ok()) {
+        return s;
+      }
+    }
     builder->Add(key, value);
     return Status::OK();
   }
@@ -229,8 +259,9 @@ struct CompactionJob::SubcompactionState {
 struct CompactionJob::CompactionState {
   Compaction* const compaction;
 
-  // REQUIRED: subcompaction states are stored in order of increasing
-  // key-range
+  // Subcompaction states are stored in order of increasing key-range,
+  // except for the ones split off running subcompactions, which are
+  // appended.
   std::vector<CompactionJob::SubcompactionState> sub_compact_states;
   Status status;
 
@@ -243,26 +274,35 @@ struct CompactionJob::CompactionState {
   explicit CompactionState(Compaction* c) : compaction(c) {}
 
   Slice SmallestUserKey() {
+    const Comparator* ucmp = compaction->column_family_data()->user_comparator();
+    Slice smallest(nullptr, 0);
     for (const auto& sub_compact_state : sub_compact_states) {
       if (!sub_compact_state.outputs.empty() &&
           sub_compact_state.outputs[0].finished) {
-        return sub_compact_state.outputs[0].meta.smallest.user_key();
+        Slice key = sub_compact_state.outputs[0].meta.smallest.user_key();
+        if (smallest.data() == nullptr || ucmp->Compare(key, smallest) < 0) {
+          smallest = key;
+        }
       }
     }
     // If there is no finished output, return an empty slice.
-    return Slice(nullptr, 0);
+    return smallest;
   }
 
   Slice LargestUserKey() {
-    for (auto it = sub_compact_states.rbegin(); it < sub_compact_states.rend();
-         ++it) {
-      if (!it->outputs.empty() && it->current_output()->finished) {
-        assert(it->current_output() != nullptr);
-        return it->current_output()->meta.largest.user_key();
+    const Comparator* ucmp = compaction->column_family_data()->user_comparator();
+    Slice largest(nullptr, 0);
+    for (auto& sub_compact_state : sub_compact_states) {
+      if (!sub_compact_state.outputs.empty() &&
+          sub_compact_state.current_output()->finished) {
+        Slice key = sub_compact_state.current_output()->meta.largest.user_key();
+        if (largest.data() == nullptr || ucmp->Compare(key, largest) > 0) {
+          largest = key;
+        }
       }
     }
     // If there is no finished output, return an empty slice.
-    return Slice(nullptr, 0);
+    return largest;
   }
 };
 
@@ -343,6 +383,12 @@ CompactionJob::CompactionJob(
       bottommost_level_(false),
       paranoid_file_checks_(paranoid_file_checks),
       measure_io_stats_(measure_io_stats),
+      enable_subcompaction_stealing_(false),
+      split_cv_(&split_mu_),
+      split_victim_(nullptr),
+      split_pending_(false),
+      split_responded_(false),
+      split_result_(nullptr),
       write_hint_(Env::WLTH_NOT_SET),
       thread_pri_(thread_pri),
       full_history_ts_low_(std::move(full_history_ts_low)) {
@@ -424,10 +470,23 @@ void CompactionJob::Prepare() {
     }
     assert(sizes_.size() == boundaries_.size() + 1);
 
+    // Subcompactions that finish early take over part of the range of the
+    // ones still running. Remote compactions and compactions that keep track
+    // of blob garbage need the ranges to stay fixed. Splitting may at most
+    // double the number of subcompactions; reserve the space up front so
+    // that running subcompactions never see their states move.
+    enable_subcompaction_stealing_ =
+        boundaries_.size() > 0 && !anchors_.empty() &&
+        db_options_.compaction_service == nullptr &&
+        !c->DoesInputReferenceBlobFiles();
+    compact_->sub_compact_states.reserve(
+        (boundaries_.size() + 1) * (enable_subcompaction_stealing_ ? 2 : 1));
+
     for (size_t i = 0; i <= boundaries_.size(); i++) {
       Slice* start = i == 0 ? nullptr : &boundaries_[i - 1];
       Slice* end = i == boundaries_.size() ? nullptr : &boundaries_[i];
-      compact_->sub_compact_states.emplace_back(c, start, end, sizes_[i]);
+      compact_->sub_compact_states.emplace_back(c, start, end, sizes_[i],
+                                                static_cast<uint32_t>(i));
     }
     RecordInHistogram(stats_, NUM_SUBCOMPACTIONS_SCHEDULED,
                       compact_->sub_compact_states.size());
@@ -435,8 +494,10 @@ void CompactionJob::Prepare() {
     constexpr Slice* start = nullptr;
     constexpr Slice* end = nullptr;
     constexpr uint64_t size = 0;
+    constexpr uint32_t sub_job_id = 0;
 
-    compact_->sub_compact_states.emplace_back(c, start, end, size);
+    compact_->sub_compact_states.emplace_back(c, start, end, size,
+                                              sub_job_id);
   }
 }
 
@@ -452,130 +513,235 @@ void CompactionJob::GenSubcompactionBoundaries() {
   auto* c = compact_->compaction;
   auto* cfd = c->column_family_data();
   const Comparator* cfd_comparator = cfd->user_comparator();
-  std::vector<Slice> bounds;
   int start_lvl = c->start_level();
   int out_lvl = c->output_level();
 
-  // Add the starting and/or ending key of certain input files as a potential
-  // boundary
+  // Sample each input file into key anchors. A file much larger than the
+  // others, e.g. a big L0 file covering the whole key range, gets
+  // proportionally more anchors and thus more candidate boundaries. Sampling
+  // may read index blocks. Unlock db mutex to reduce contention; the input
+  // version is referenced by the compaction and will not change.
+  std::vector<TableReader::Anchor> all_anchors;
+  db_mutex_->Unlock();
   for (size_t lvl_idx = 0; lvl_idx < c->num_input_levels(); lvl_idx++) {
     int lvl = c->level(lvl_idx);
-    if (lvl >= start_lvl && lvl <= out_lvl) {
-      const LevelFilesBrief* flevel = c->input_levels(lvl_idx);
-      size_t num_files = flevel->num_files;
-
-      if (num_files == 0) {
-        continue;
-      }
-
-      if (lvl == 0) {
-        // For level 0 add the starting and ending key of each file since the
-        // files may have greatly differing key ranges (not range-partitioned)
-        for (size_t i = 0; i < num_files; i++) {
-          bounds.emplace_back(flevel->files[i].smallest_key);
-          bounds.emplace_back(flevel->files[i].largest_key);
-        }
-      } else {
-        // For all other levels add the smallest/largest key in the level to
-        // encompass the range covered by that level
-        bounds.emplace_back(flevel->files[0].smallest_key);
-        bounds.emplace_back(flevel->files[num_files - 1].largest_key);
-        if (lvl == out_lvl) {
-          // For the last level include the starting keys of all files since
-          // the last level is the largest and probably has the widest key
-          // range. Since it's range partitioned, the ending key of one file
-          // and the starting key of the next are very close (or identical).
-          for (size_t i = 1; i < num_files; i++) {
-            bounds.emplace_back(flevel->files[i].smallest_key);
-          }
-        }
+    if (lvl < start_lvl || lvl > out_lvl) {
+      continue;
+    }
+    const LevelFilesBrief* flevel = c->input_levels(lvl_idx);
+    for (size_t i = 0; i < flevel->num_files; i++) {
+      const FdWithKeyRange& file = flevel->files[i];
+      std::vector<TableReader::Anchor> file_anchors;
+      Status s = cfd->table_cache()->ApproximateKeyAnchors(
+          ReadOptions(), cfd->internal_comparator(), file.fd, file_anchors);
+      if (!s.ok() || file_anchors.empty()) {
+        // The table format does not support sampling; treat the whole file
+        // as one range.
+        s.PermitUncheckedError();
+        file_anchors.clear();
+        file_anchors.emplace_back(ExtractUserKey(file.largest_key),
+                                  file.fd.GetFileSize());
       }
+      all_anchors.insert(all_anchors.end(),
+                         std::make_move_iterator(file_anchors.begin()),
+                         std::make_move_iterator(file_anchors.end()));
     }
   }
+  db_mutex_->Lock();
 
-  std::sort(bounds.begin(), bounds.end(),
-            [cfd_comparator](const Slice& a, const Slice& b) -> bool {
-              return cfd_comparator->Compare(ExtractUserKey(a),
-                                             ExtractUserKey(b)) < 0;
+  std::sort(all_anchors.begin(), all_anchors.end(),
+            [cfd_comparator](const TableReader::Anchor& a,
+                             const TableReader::Anchor& b) -> bool {
+              return cfd_comparator->Compare(a.user_key, b.user_key) < 0;
             });
-  // Remove duplicated entries from bounds
-  bounds.erase(
-      std::unique(bounds.begin(), bounds.end(),
-                  [cfd_comparator](const Slice& a, const Slice& b) -> bool {
-                    return cfd_comparator->Compare(ExtractUserKey(a),
-                                                   ExtractUserKey(b)) == 0;
-                  }),
-      bounds.end());
-
-  // Combine consecutive pairs of boundaries into ranges with an approximate
-  // size of data covered by keys in that range
+  // Merge anchors with the same user key, boundaries must be distinct
   uint64_t sum = 0;
-  std::vector<RangeWithSize> ranges;
-  // Get input version from CompactionState since it's already referenced
-  // earlier in SetInputVersioCompaction::SetInputVersion and will not change
-  // when db_mutex_ is released below
-  auto* v = compact_->compaction->input_version();
-  for (auto it = bounds.begin();;) {
-    const Slice a = *it;
-    ++it;
-
-    if (it == bounds.end()) {
-      break;
+  for (const auto& anchor : all_anchors) {
+    sum += anchor.range_size;
+    if (!anchors_.empty() &&
+        cfd_comparator->Compare(anchors_.back().user_key, anchor.user_key) ==
+            0) {
+      anchors_.back().range_size += anchor.range_size;
+    } else {
+      anchors_.push_back(anchor);
     }
-
-    const Slice b = *it;
-
-    // ApproximateSize could potentially create table reader iterator to seek
-    // to the index block and may incur I/O cost in the process. Unlock db
-    // mutex to reduce contention
-    db_mutex_->Unlock();
-    uint64_t size = versions_->ApproximateSize(SizeApproximationOptions(), v, a,
-                                               b, start_lvl, out_lvl + 1,
-                                               TableReaderCaller::kCompaction);
-    db_mutex_->Lock();
-    ranges.emplace_back(a, b, size);
-    sum += size;
   }
 
-  // Group the ranges into subcompactions
+  // Group the anchors into subcompactions
   const double min_file_fill_percent = 4.0 / 5;
-  int base_level = v->storage_info()->base_level();
+  int base_level = compact_->compaction->input_version()
+                       ->storage_info()
+                       ->base_level();
   uint64_t max_output_files = static_cast<uint64_t>(std::ceil(
       sum / min_file_fill_percent /
       MaxFileSizeForLevel(*(c->mutable_cf_options()), out_lvl,
           c->immutable_cf_options()->compaction_style, base_level,
           c->immutable_cf_options()->level_compaction_dynamic_level_bytes)));
   uint64_t subcompactions =
-      std::min({static_cast<uint64_t>(ranges.size()),
+      std::min({static_cast<uint64_t>(anchors_.size()),
                 static_cast<uint64_t>(c->max_subcompactions()),
                 max_output_files});
 
   if (subcompactions > 1) {
-    double mean = sum * 1.0 / subcompactions;
-    // Greedily add ranges to the subcompaction until the sum of the ranges'
+    const double mean = sum * 1.0 / subcompactions;
+    // Greedily add anchor ranges to the subcompaction until the sum of their
     // sizes becomes >= the expected mean size of a subcompaction
+    const uint64_t total = sum;
+    uint64_t scheduled = 0;
     sum = 0;
-    for (size_t i = 0; i + 1 < ranges.size(); i++) {
-      sum += ranges[i].size;
+    for (size_t i = 0; i + 1 < anchors_.size(); i++) {
+      sum += anchors_[i].range_size;
       if (subcompactions == 1) {
         // If there's only one left to schedule then it goes to the end so no
         // need to put an end boundary
-        continue;
+        break;
       }
       if (sum >= mean) {
-        boundaries_.emplace_back(ExtractUserKey(ranges[i].range.limit));
+        boundaries_.emplace_back(anchors_[i].user_key);
         sizes_.emplace_back(sum);
+        scheduled += sum;
         subcompactions--;
         sum = 0;
       }
     }
-    sizes_.emplace_back(sum + ranges.back().size);
+    sizes_.emplace_back(total - scheduled);
   } else {
     // Only one range so its size is the total sum of sizes computed above
     sizes_.emplace_back(sum);
   }
 }
 
+void CompactionJob::ProcessKeyValueCompactionAndSteal(
+    SubcompactionState* sub_compact) {
+  while (sub_compact != nullptr) {
+    ProcessKeyValueCompaction(sub_compact);
+    if (!enable_subcompaction_stealing_) {
+      break;
+    }
+    sub_compact = StealSubcompaction(sub_compact);
+  }
+}
+
+CompactionJob::SubcompactionState* CompactionJob::StealSubcompaction(
+    SubcompactionState* finished) {
+  MutexLock l(&split_mu_);
+  finished->done = true;
+  if (split_victim_.load(std::memory_order_relaxed) == finished) {
+    // A subcompaction is waiting for us to split; there is nothing left.
+    split_victim_.store(nullptr, std::memory_order_relaxed);
+    split_responded_ = true;
+    split_cv_.SignalAll();
+  }
+  if (!finished->status.ok() ||
+      shutting_down_->load(std::memory_order_relaxed)) {
+    return nullptr;
+  }
+
+  while (true) {
+    while (split_pending_) {
+      split_cv_.Wait();
+    }
+    if (compact_->sub_compact_states.size() ==
+        compact_->sub_compact_states.capacity()) {
+      return nullptr;
+    }
+    // Ask the largest subcompaction still running
+    SubcompactionState* victim = nullptr;
+    for (auto& state : compact_->sub_compact_states) {
+      if (!state.done && !state.split_tried &&
+          (victim == nullptr || state.approx_size > victim->approx_size)) {
+        victim = &state;
+      }
+    }
+    if (victim == nullptr) {
+      return nullptr;
+    }
+
+    split_pending_ = true;
+    split_responded_ = false;
+    split_result_ = nullptr;
+    split_victim_.store(victim, std::memory_order_relaxed);
+    while (!split_responded_) {
+      split_cv_.Wait();
+    }
+    SubcompactionState* stolen = split_result_;
+    split_pending_ = false;
+    split_cv_.SignalAll();
+    if (stolen != nullptr) {
+      return stolen;
+    }
+    victim->split_tried = true;
+  }
+}
+
+void CompactionJob::MaybeSplitSubcompaction(SubcompactionState* sub_compact,
+                                            const Slice& current_user_key) {
+  MutexLock l(&split_mu_);
+  if (split_victim_.load(std::memory_order_relaxed) != sub_compact) {
+    return;
+  }
+  split_victim_.store(nullptr, std::memory_order_relaxed);
+  split_responded_ = true;
+  split_cv_.SignalAll();
+
+  // The anchors strictly between the key being processed and the end of the
+  // range are the candidates for the new boundary.
+  const Comparator* ucmp =
+      sub_compact->compaction->column_family_data()->user_comparator();
+  auto anchor_less = [ucmp](const TableReader::Anchor& a, const Slice& b) {
+    return ucmp->Compare(a.user_key, b) < 0;
+  };
+  auto first = std::lower_bound(anchors_.begin(), anchors_.end(),
+                                current_user_key, anchor_less);
+  while (first != anchors_.end() &&
+         ucmp->Compare(first->user_key, current_user_key) <= 0) {
+    ++first;
+  }
+  auto last = sub_compact->end == nullptr
+                  ? anchors_.end()
+                  : std::lower_bound(anchors_.begin(), anchors_.end(),
+                                     *sub_compact->end, anchor_less);
+  if (first >= last) {
+    return;
+  }
+
+  uint64_t remaining = 0;
+  for (auto it = first; it != last; ++it) {
+    remaining += it->range_size;
+  }
+  // Split in the middle of the remaining data, but only if the part handed
+  // over is worth at least half an output file.
+  uint64_t kept = 0;
+  auto split = first;
+  for (; split != last; ++split) {
+    kept += split->range_size;
+    if (kept * 2 >= remaining) {
+      break;
+    }
+  }
+  if (split == last ||
+      (remaining - kept) * 2 < sub_compact->compaction->max_output_file_size()) {
+    return;
+  }
+
+  split_keys_.emplace_back(split->user_key);
+  split_bounds_.emplace_back(split_keys_.back());
+  Slice* boundary = &split_bounds_.back();
+  assert(compact_->sub_compact_states.size() <
+         compact_->sub_compact_states.capacity());
+  compact_->sub_compact_states.emplace_back(
+      compact_->compaction, boundary, sub_compact->end, remaining - kept,
+      static_cast<uint32_t>(compact_->sub_compact_states.size()));
+  sub_compact->end = boundary;
+  sub_compact->approx_size =
+      sub_compact->approx_size > remaining - kept
+          ? sub_compact->approx_size - (remaining - kept)
+          : 0;
+  split_result_ = &compact_->sub_compact_states.back();
+  TEST_SYNC_POINT_CALLBACK("CompactionJob::MaybeSplitSubcompaction:Split",
+                           split_result_);
+}
+
 Status CompactionJob::Run() {
   AutoThreadOperationStageUpdater stage_updater(
       ThreadStatus::STAGE_COMPACTION_RUN);
@@ -590,14 +756,14 @@ Status CompactionJob::Run() {
   // Launch a thread for each of subcompactions 1...num_threads-1
   std::vector<port::Thread> thread_pool;
   thread_pool.reserve(num_threads - 1);
-  for (size_t i = 1; i < compact_->sub_compact_states.size(); i++) {
-    thread_pool.emplace_back(&CompactionJob::ProcessKeyValueCompaction, this,
-                             &compact_->sub_compact_states[i]);
+  for (size_t i = 1; i < num_threads; i++) {
+    thread_pool.emplace_back(&CompactionJob::ProcessKeyValueCompactionAndSteal,
+                             this, &compact_->sub_compact_states[i]);
   }
 
   // Always schedule the first subcompaction (whether or not there are also
   // others) in the current thread to be efficient with resources
-  ProcessKeyValueCompaction(&compact_->sub_compact_states[0]);
+  ProcessKeyValueCompactionAndSteal(&compact_->sub_compact_states[0]);
 
   // Wait for all other threads (if there are any) to finish execution
   for (auto& thread : thread_pool) {
@@ -775,6 +941,17 @@ Status CompactionJob::Install(const MutableCFOptions& mutable_cf_options) {
 
   cfd->internal_stats()->AddCompactionStats(
       compact_->compaction->output_level(), thread_pri_, compaction_stats_);
+  if (cfd->ioptions()->cf_paths.size() > 1) {
+    const Compaction* compaction = compact_->compaction;
+    for (size_t i = 0; i < compaction->num_input_levels(); ++i) {
+      for (const FileMetaData* f : *compaction->inputs(i)) {
+        cfd->internal_stats()->AddPathCompactionBytesRead(
+            f->fd.GetPathId(), f->fd.GetFileSize());
+      }
+    }
+    cfd->internal_stats()->AddPathBytesWritten(compaction->output_path_id(),
+                                               compact_->total_bytes);
+  }
 
   if (status.ok()) {
     status = InstallCompactionResults(mutable_cf_options);
@@ -896,6 +1073,18 @@ void CompactionJob::ProcessKeyValueCompaction(SubcompactionState* sub_compact) {
 
   uint64_t prev_cpu_micros = env_->NowCPUNanos() / 1000;
 
+#ifndef ROCKSDB_LITE
+  if (db_options_.compaction_service) {
+    CompactionServiceJobStatus comp_status =
+        ProcessKeyValueCompactionWithCompactionService(sub_compact);
+    if (comp_status != CompactionServiceJobStatus::kUseLocal) {
+      return;
+    }
+    // fallback to local compaction
+    assert(comp_status == CompactionServiceJobStatus::kUseLocal);
+  }
+#endif  // !ROCKSDB_LITE
+
   ColumnFamilyData* cfd = sub_compact->compaction->column_family_data();
 
   // Create compaction filter and fail the compaction if
@@ -928,9 +1117,20 @@ void CompactionJob::ProcessKeyValueCompaction(SubcompactionState* sub_compact) {
 
   // Although the v2 aggregator is what the level iterator(s) know about,
   // the AddTombstones calls will be propagated down to the v1 aggregator.
-  std::unique_ptr<InternalIterator> input(
+  std::unique_ptr<InternalIterator> raw_input(
       versions_->MakeInputIterator(read_options, sub_compact->compaction,
                                    &range_del_agg, file_options_for_read_));
+  InternalIterator* input = raw_input.get();
+
+  std::unique_ptr<InternalIterator> blob_counter;
+
+  if (sub_compact->compaction->DoesInputReferenceBlobFiles()) {
+    sub_compact->blob_garbage_meter.reset(new BlobGarbageMeter);
+    blob_counter.reset(new BlobCountingIterator(
+        input, sub_compact->blob_garbage_meter.get(), cfd->user_comparator(),
+        sub_compact->start, sub_compact->end));
+    input = blob_counter.get();
+  }
 
   AutoThreadOperationStageUpdater stage_updater(
       ThreadStatus::STAGE_COMPACTION_PROCESS_KV);
@@ -999,7 +1199,7 @@ void CompactionJob::ProcessKeyValueCompaction(SubcompactionState* sub_compact) {
   const std::string* const full_history_ts_low =
       full_history_ts_low_.empty() ? nullptr : &full_history_ts_low_;
   sub_compact->c_iter.reset(new CompactionIterator(
-      input.get(), cfd->user_comparator(), &merge, versions_->LastSequence(),
+      input, cfd->user_comparator(), &merge, versions_->LastSequence(),
       &existing_snapshots_, earliest_write_conflict_snapshot_,
       snapshot_checker_, env_, ShouldReportDetailedTime(env_, stats_),
       /*expect_valid_internal_key=*/true, &range_del_agg,
@@ -1030,6 +1230,12 @@ void CompactionJob::ProcessKeyValueCompaction(SubcompactionState* sub_compact) {
     const Slice& key = c_iter->key();
     const Slice& value = c_iter->value();
 
+    // An idle subcompaction asked to take over part of our remaining range.
+    if (split_victim_.load(std::memory_order_relaxed) == sub_compact) {
+      MaybeSplitSubcompaction(sub_compact, c_iter->user_key());
+      end = sub_compact->end;
+    }
+
     // If an end key (exclusive) is specified, check if the current key is
     // >= than it and exit if it is because the iterator is out of its range
     if (end != nullptr &&
@@ -1215,7 +1421,8 @@ void CompactionJob::ProcessKeyValueCompaction(SubcompactionState* sub_compact) {
 #endif  // ROCKSDB_ASSERT_STATUS_CHECKED
 
   sub_compact->c_iter.reset();
-  input.reset();
+  blob_counter.reset();
+  raw_input.reset();
   sub_compact->status = status;
 }
 
@@ -1497,9 +1704,7 @@ Status CompactionJob::FinishCompactionOutputFile(
     // If there is nothing to output, no necessary to generate a sst file.
     // This happens when the output level is bottom level, at the same time
     // the sub_compact output nothing.
-    std::string fname =
-        TableFileName(sub_compact->compaction->immutable_cf_options()->cf_paths,
-                      meta->fd.GetNumber(), meta->fd.GetPathId());
+    std::string fname = GetTableFileName(meta->fd.GetNumber());
     env_->DeleteFile(fname);
 
     // Also need to remove the file from outputs, or it will be added to the
@@ -1524,9 +1729,7 @@ Status CompactionJob::FinishCompactionOutputFile(
   FileDescriptor output_fd;
   uint64_t oldest_blob_file_number = kInvalidBlobFileNumber;
   if (meta != nullptr) {
-    fname =
-        TableFileName(sub_compact->compaction->immutable_cf_options()->cf_paths,
-                      meta->fd.GetNumber(), meta->fd.GetPathId());
+    fname = GetTableFileName(meta->fd.GetNumber());
     output_fd = meta->fd;
     oldest_blob_file_number = meta->oldest_blob_file_number;
   } else {
@@ -1604,6 +1807,8 @@ Status CompactionJob::InstallCompactionResults(
   // Add compaction inputs
   compaction->AddInputDeletions(edit);
 
+  BlobGarbageMeter blob_garbage_meter;
+
   for (const auto& sub_compact : compact_->sub_compact_states) {
     for (const auto& out : sub_compact.outputs) {
       edit->AddFile(compaction->output_level(), out.meta);
@@ -1612,6 +1817,34 @@ Status CompactionJob::InstallCompactionResults(
     for (const auto& blob : sub_compact.blob_file_additions) {
       edit->AddBlobFile(blob);
     }
+
+    if (sub_compact.blob_garbage_meter) {
+      blob_garbage_meter.Merge(*sub_compact.blob_garbage_meter);
+    }
+  }
+
+  // Record the additional garbage generated by the compaction. Blob references
+  // that point to files not tracked by the current version (e.g. those written
+  // by the stacked BlobDB implementation) are ignored.
+  const VersionStorageInfo* const storage_info =
+      compaction->column_family_data()->current()->storage_info();
+  assert(storage_info);
+
+  const auto& blob_files = storage_info->GetBlobFiles();
+
+  for (const auto& pair : blob_garbage_meter.flows()) {
+    const uint64_t blob_file_number = pair.first;
+    const BlobGarbageMeter::BlobInOutFlow& flow = pair.second;
+
+    if (!flow.IsValid()) {
+      return Status::Corruption("Invalid blob inflow/outflow");
+    }
+
+    if (flow.HasGarbage() &&
+        blob_files.find(blob_file_number) != blob_files.end()) {
+      edit->AddBlobFileGarbage(blob_file_number, flow.GetGarbageCount(),
+                               flow.GetGarbageBytes());
+    }
   }
 
   return versions_->LogAndApply(compaction->column_family_data(),
@@ -1648,9 +1881,7 @@ Status CompactionJob::OpenCompactionOutputFile(
   assert(sub_compact->builder == nullptr);
   // no need to lock because VersionSet::next_file_number_ is atomic
   uint64_t file_number = versions_->NewFileNumber();
-  std::string fname =
-      TableFileName(sub_compact->compaction->immutable_cf_options()->cf_paths,
-                    file_number, sub_compact->compaction->output_path_id());
+  std::string fname = GetTableFileName(file_number);
   // Fire events.
   ColumnFamilyData* cfd = sub_compact->compaction->column_family_data();
 #ifndef ROCKSDB_LITE
@@ -1731,7 +1962,7 @@ Status CompactionJob::OpenCompactionOutputFile(
   sub_compact->outfile.reset(new WritableFileWriter(
       std::move(writable_file), fname, file_options_, env_, io_tracer_,
       db_options_.statistics.get(), listeners,
-      db_options_.file_checksum_gen_factory.get()));
+      db_options_.file_checksum_gen_factory.get(), fs_.get()));
 
   // If the Column family flag is to only optimize filters for hits,
   // we can skip creating filters if this is the bottommost_level where
@@ -1754,6 +1985,11 @@ Status CompactionJob::OpenCompactionOutputFile(
   return s;
 }
 
+std::string CompactionJob::GetTableFileName(uint64_t file_number) {
+  return TableFileName(compact_->compaction->immutable_cf_options()->cf_paths,
+                       file_number, compact_->compaction->output_path_id());
+}
+
 void CompactionJob::CleanupCompaction() {
   for (SubcompactionState& sub_compact : compact_->sub_compact_states) {
     const auto& sub_status = sub_compact.status;
@@ -1905,4 +2141,537 @@ void CompactionJob::LogCompaction() {
   }
 }
 
+#ifndef ROCKSDB_LITE
+CompactionServiceJobStatus
+CompactionJob::ProcessKeyValueCompactionWithCompactionService(
+    SubcompactionState* sub_compact) {
+  assert(sub_compact);
+  assert(sub_compact->compaction);
+  assert(db_options_.compaction_service);
+
+  Compaction* compaction = compact_->compaction;
+  // A worker can neither evaluate a snapshot checker nor account for blob
+  // files on behalf of this DB, so such compactions always run locally.
+  if (snapshot_checker_ != nullptr || !full_history_ts_low_.empty() ||
+      compaction->mutable_cf_options()->enable_blob_files ||
+      compaction->DoesInputReferenceBlobFiles()) {
+    return CompactionServiceJobStatus::kUseLocal;
+  }
+
+  CompactionServiceInput compaction_input;
+  compaction_input.cf_name = compaction->column_family_data()->GetName();
+  compaction_input.snapshots = existing_snapshots_;
+  compaction_input.earliest_write_conflict_snapshot =
+      earliest_write_conflict_snapshot_;
+  compaction_input.preserve_deletes_seqnum = preserve_deletes_seqnum_;
+  for (size_t i = 0; i < compaction->num_input_levels(); ++i) {
+    for (const FileMetaData* file : *compaction->inputs(i)) {
+      compaction_input.input_files.emplace_back(
+          MakeTableFileName(file->fd.GetNumber()));
+    }
+  }
+  compaction_input.output_level = compaction->output_level();
+  if (sub_compact->start != nullptr) {
+    compaction_input.has_begin = true;
+    compaction_input.begin = sub_compact->start->ToString();
+  }
+  if (sub_compact->end != nullptr) {
+    compaction_input.has_end = true;
+    compaction_input.end = sub_compact->end->ToString();
+  }
+  compaction_input.approx_size = sub_compact->approx_size;
+
+  std::string compaction_input_binary;
+  compaction_input.Write(&compaction_input_binary);
+
+  const uint64_t compaction_id =
+      (static_cast<uint64_t>(job_id_) << 32) | sub_compact->sub_job_id;
+  ROCKS_LOG_INFO(db_options_.info_log,
+                 "[%s] [JOB %d] Starting remote compaction %" PRIu64
+                 " (output level: %d) with %" ROCKSDB_PRIszt " input files",
+                 compaction_input.cf_name.c_str(), job_id_, compaction_id,
+                 compaction_input.output_level,
+                 compaction_input.input_files.size());
+
+  CompactionServiceJobStatus compaction_status =
+      db_options_.compaction_service->Start(compaction_input_binary,
+                                            compaction_id);
+  if (compaction_status == CompactionServiceJobStatus::kUseLocal) {
+    ROCKS_LOG_INFO(db_options_.info_log,
+                   "[%s] [JOB %d] Remote compaction %" PRIu64
+                   " not started, falling back to local compaction",
+                   compaction_input.cf_name.c_str(), job_id_, compaction_id);
+    return compaction_status;
+  }
+  if (compaction_status == CompactionServiceJobStatus::kFailure) {
+    sub_compact->status =
+        Status::Incomplete("CompactionService failed to start compaction job");
+    return compaction_status;
+  }
+
+  std::string compaction_result_binary;
+  compaction_status = db_options_.compaction_service->WaitForComplete(
+      compaction_id, &compaction_result_binary);
+  if (compaction_status == CompactionServiceJobStatus::kUseLocal) {
+    ROCKS_LOG_INFO(db_options_.info_log,
+                   "[%s] [JOB %d] Remote compaction %" PRIu64
+                   " not run, falling back to local compaction",
+                   compaction_input.cf_name.c_str(), job_id_, compaction_id);
+    return compaction_status;
+  }
+
+  CompactionServiceResult compaction_result;
+  Status s = CompactionServiceResult::Read(compaction_result_binary,
+                                           &compaction_result);
+  if (s.ok()) {
+    s = compaction_result.status;
+  }
+  if (s.ok() && compaction_status == CompactionServiceJobStatus::kFailure) {
+    s = Status::Incomplete("CompactionService failed to run compaction job");
+  }
+  if (s.ok() && compaction_result.output_level != compaction->output_level()) {
+    s = Status::Corruption("CompactionService returned wrong output level",
+                           ToString(compaction_result.output_level));
+  }
+  if (!s.ok()) {
+    sub_compact->status = s;
+    return CompactionServiceJobStatus::kFailure;
+  }
+
+  // Move the output files into the DB. They get new file numbers, which are
+  // protected by pending_outputs_ like those of a local compaction.
+  ColumnFamilyData* cfd = compaction->column_family_data();
+  const uint32_t output_path_id = compaction->output_path_id();
+  for (const auto& file : compaction_result.output_files) {
+    const uint64_t file_number = versions_->NewFileNumber();
+    const std::string src_file =
+        compaction_result.output_path + "/" + file.file_name;
+    const std::string tgt_file = TableFileName(
+        compaction->immutable_cf_options()->cf_paths, file_number,
+        output_path_id);
+    s = fs_->RenameFile(src_file, tgt_file, IOOptions(), nullptr);
+    uint64_t file_size = 0;
+    if (s.ok()) {
+      s = fs_->GetFileSize(tgt_file, IOOptions(), &file_size, nullptr);
+    }
+    if (!s.ok()) {
+      sub_compact->status = s;
+      return CompactionServiceJobStatus::kFailure;
+    }
+
+    FileMetaData meta;
+    meta.fd = FileDescriptor(file_number, output_path_id, file_size,
+                             file.smallest_seqno, file.largest_seqno);
+    meta.smallest.DecodeFrom(file.smallest_internal_key);
+    meta.largest.DecodeFrom(file.largest_internal_key);
+    meta.oldest_ancester_time = file.oldest_ancester_time;
+    meta.file_creation_time = file.file_creation_time;
+    meta.marked_for_compaction = file.marked_for_compaction;
+    meta.file_checksum = file.file_checksum;
+    meta.file_checksum_func_name = file.file_checksum_func_name;
+
+    std::shared_ptr<const TableProperties> table_properties;
+    s = cfd->table_cache()->GetTableProperties(
+        file_options_, cfd->internal_comparator(), meta.fd, &table_properties,
+        compaction->mutable_cf_options()->prefix_extractor.get());
+    if (!s.ok()) {
+      sub_compact->status = s;
+      return CompactionServiceJobStatus::kFailure;
+    }
+
+    sub_compact->outputs.emplace_back(std::move(meta),
+                                      cfd->internal_comparator(),
+                                      /*enable_order_check=*/true,
+                                      paranoid_file_checks_);
+    auto* output = sub_compact->current_output();
+    output->validator.SetHash(file.paranoid_hash);
+    output->finished = true;
+    output->table_properties = std::move(table_properties);
+    sub_compact->total_bytes += file_size;
+  }
+  sub_compact->num_output_records = compaction_result.num_output_records;
+  sub_compact->compaction_job_stats.num_input_deletion_records =
+      compaction_result.num_input_deletion_records;
+  sub_compact->compaction_job_stats.num_corrupt_keys =
+      compaction_result.num_corrupt_keys;
+
+  ROCKS_LOG_INFO(db_options_.info_log,
+                 "[%s] [JOB %d] Finished remote compaction %" PRIu64
+                 " with %" ROCKSDB_PRIszt " output files",
+                 compaction_input.cf_name.c_str(), job_id_, compaction_id,
+                 compaction_result.output_files.size());
+  sub_compact->status = Status::OK();
+  return CompactionServiceJobStatus::kSuccess;
+}
+
+CompactionServiceCompactionJob::CompactionServiceCompactionJob(
+    int job_id, Compaction* compaction, const ImmutableDBOptions& db_options,
+    const FileOptions& file_options, VersionSet* versions,
+    const std::atomic<bool>* shutting_down, LogBuffer* log_buffer,
+    FSDirectory* output_directory, Statistics* stats,
+    InstrumentedMutex* db_mutex, ErrorHandler* db_error_handler,
+    std::shared_ptr<Cache> table_cache, EventLogger* event_logger,
+    const std::string& dbname, CompactionJobStats* compaction_job_stats,
+    const std::shared_ptr<IOTracer>& io_tracer, const std::string& db_id,
+    const std::string& db_session_id, const std::string& output_path,
+    const CompactionServiceInput& compaction_service_input,
+    CompactionServiceResult* compaction_service_result)
+    : CompactionJob(
+          job_id, compaction, db_options, file_options, versions,
+          shutting_down, compaction_service_input.preserve_deletes_seqnum,
+          log_buffer, /*db_directory=*/nullptr, output_directory,
+          /*blob_output_directory=*/nullptr, stats, db_mutex,
+          db_error_handler, compaction_service_input.snapshots,
+          compaction_service_input.earliest_write_conflict_snapshot,
+          /*snapshot_checker=*/nullptr, std::move(table_cache), event_logger,
+          compaction->mutable_cf_options()->paranoid_file_checks,
+          compaction->mutable_cf_options()->report_bg_io_stats, dbname,
+          compaction_job_stats, Env::Priority::USER, io_tracer,
+          /*manual_compaction_paused=*/nullptr, db_id, db_session_id),
+      output_path_(output_path),
+      compaction_input_(compaction_service_input),
+      begin_(compaction_service_input.begin),
+      end_(compaction_service_input.end),
+      compaction_result_(compaction_service_result) {}
+
+void CompactionServiceCompactionJob::Prepare() {
+  AutoThreadOperationStageUpdater stage_updater(
+      ThreadStatus::STAGE_COMPACTION_PREPARE);
+
+  auto* c = compact_->compaction;
+  assert(c->column_family_data() != nullptr);
+  write_hint_ =
+      c->column_family_data()->CalculateSSTWriteHint(c->output_level());
+  bottommost_level_ = c->bottommost_level();
+
+  // The primary already split the compaction; run exactly the requested
+  // subcompaction.
+  Slice* start = compaction_input_.has_begin ? &begin_ : nullptr;
+  Slice* end = compaction_input_.has_end ? &end_ : nullptr;
+  constexpr uint32_t sub_job_id = 0;
+  compact_->sub_compact_states.emplace_back(
+      c, start, end, compaction_input_.approx_size, sub_job_id);
+}
+
+Status CompactionServiceCompactionJob::Run() {
+  AutoThreadOperationStageUpdater stage_updater(
+      ThreadStatus::STAGE_COMPACTION_RUN);
+
+  auto* c = compact_->compaction;
+  assert(c->column_family_data() != nullptr);
+  assert(compact_->sub_compact_states.size() == 1);
+  SubcompactionState* sub_compact = compact_->sub_compact_states.data();
+
+  log_buffer_->FlushBufferToLog();
+  LogCompaction();
+  const uint64_t start_micros = env_->NowMicros();
+
+  ProcessKeyValueCompaction(sub_compact);
+
+  compaction_stats_.micros = env_->NowMicros() - start_micros;
+  compaction_stats_.cpu_micros = sub_compact->compaction_job_stats.cpu_micros;
+  RecordTimeToHistogram(stats_, COMPACTION_TIME, compaction_stats_.micros);
+  RecordTimeToHistogram(stats_, COMPACTION_CPU_TIME,
+                        compaction_stats_.cpu_micros);
+
+  Status status = sub_compact->status;
+  IOStatus io_s = sub_compact->io_status;
+  if (io_status_.ok()) {
+    io_status_ = io_s;
+  }
+  if (status.ok()) {
+    constexpr IODebugContext* dbg = nullptr;
+    if (output_directory_) {
+      io_s = output_directory_->Fsync(IOOptions(), dbg);
+    }
+    if (io_status_.ok()) {
+      io_status_ = io_s;
+    }
+    status = io_s;
+  }
+
+  // Build the result; the primary verifies the files once they are moved
+  // into the DB.
+  compaction_result_->status = status;
+  compaction_result_->output_level = c->output_level();
+  compaction_result_->output_path = output_path_;
+  if (status.ok()) {
+    for (const auto& output : sub_compact->outputs) {
+      const FileMetaData& meta = output.meta;
+      CompactionServiceOutputFile file;
+      file.file_name = MakeTableFileName(meta.fd.GetNumber());
+      file.smallest_seqno = meta.fd.smallest_seqno;
+      file.largest_seqno = meta.fd.largest_seqno;
+      file.smallest_internal_key = meta.smallest.Encode().ToString();
+      file.largest_internal_key = meta.largest.Encode().ToString();
+      file.oldest_ancester_time = meta.oldest_ancester_time;
+      file.file_creation_time = meta.file_creation_time;
+      file.paranoid_hash = output.validator.GetHash();
+      file.marked_for_compaction = meta.marked_for_compaction;
+      file.file_checksum = meta.file_checksum;
+      file.file_checksum_func_name = meta.file_checksum_func_name;
+      compaction_result_->output_files.push_back(std::move(file));
+    }
+  }
+  compaction_result_->num_output_records = sub_compact->num_output_records;
+  compaction_result_->total_bytes = sub_compact->total_bytes;
+  compaction_result_->num_input_deletion_records =
+      sub_compact->compaction_job_stats.num_input_deletion_records;
+  compaction_result_->num_corrupt_keys =
+      sub_compact->compaction_job_stats.num_corrupt_keys;
+
+  RecordCompactionIOStats();
+  LogFlush(db_options_.info_log);
+  compact_->status = status;
+  return status;
+}
+
+void CompactionServiceCompactionJob::CleanupCompaction() {
+  CompactionJob::CleanupCompaction();
+}
+
+std::string CompactionServiceCompactionJob::GetTableFileName(
+    uint64_t file_number) {
+  return MakeTableFileName(output_path_, file_number);
+}
+
+namespace {
+// Version of the CompactionServiceInput and CompactionServiceResult
+// encodings. A DB and its workers must agree on it.
+constexpr uint32_t kCompactionServiceFormatVersion = 1;
+
+void PutStatus(std::string* dst, const Status& s) {
+  dst->push_back(static_cast<char>(s.code()));
+  const char* state = s.getState();
+  PutLengthPrefixedSlice(dst, state == nullptr ? Slice() : Slice(state));
+}
+
+bool GetStatus(Slice* input, Status* s) {
+  Slice msg;
+  if (input->empty()) {
+    return false;
+  }
+  const auto code = static_cast<Status::Code>((*input)[0]);
+  input->remove_prefix(1);
+  if (!GetLengthPrefixedSlice(input, &msg)) {
+    return false;
+  }
+  switch (code) {
+    case Status::kOk:
+      *s = Status::OK();
+      break;
+    case Status::kNotFound:
+      *s = Status::NotFound(msg);
+      break;
+    case Status::kCorruption:
+      *s = Status::Corruption(msg);
+      break;
+    case Status::kNotSupported:
+      *s = Status::NotSupported(msg);
+      break;
+    case Status::kInvalidArgument:
+      *s = Status::InvalidArgument(msg);
+      break;
+    case Status::kIOError:
+      *s = Status::IOError(msg);
+      break;
+    case Status::kMergeInProgress:
+      *s = Status::MergeInProgress(msg);
+      break;
+    case Status::kIncomplete:
+      *s = Status::Incomplete(msg);
+      break;
+    case Status::kShutdownInProgress:
+      *s = Status::ShutdownInProgress(msg);
+      break;
+    case Status::kTimedOut:
+      *s = Status::TimedOut(msg);
+      break;
+    case Status::kAborted:
+      *s = Status::Aborted(msg);
+      break;
+    case Status::kBusy:
+      *s = Status::Busy(msg);
+      break;
+    case Status::kExpired:
+      *s = Status::Expired(msg);
+      break;
+    case Status::kTryAgain:
+      *s = Status::TryAgain(msg);
+      break;
+    case Status::kCompactionTooLarge:
+      *s = Status::CompactionTooLarge(msg);
+      break;
+    case Status::kColumnFamilyDropped:
+      *s = Status::ColumnFamilyDropped(msg);
+      break;
+    default:
+      *s = Status::Corruption("Unknown status code from CompactionService",
+                              msg);
+      break;
+  }
+  return true;
+}
+
+void PutBool(std::string* dst, bool b) { dst->push_back(b ? 1 : 0); }
+
+bool GetBool(Slice* input, bool* b) {
+  if (input->empty()) {
+    return false;
+  }
+  *b = (*input)[0] != 0;
+  input->remove_prefix(1);
+  return true;
+}
+
+bool GetString(Slice* input, std::string* str) {
+  Slice slice;
+  if (!GetLengthPrefixedSlice(input, &slice)) {
+    return false;
+  }
+  str->assign(slice.data(), slice.size());
+  return true;
+}
+
+Status CheckFormatVersion(Slice* input, const char* what) {
+  uint32_t format_version = 0;
+  if (!GetVarint32(input, &format_version)) {
+    return Status::Corruption("Unable to decode format version", what);
+  }
+  if (format_version != kCompactionServiceFormatVersion) {
+    return Status::NotSupported("Unsupported format version", what);
+  }
+  return Status::OK();
+}
+}  // namespace
+
+void CompactionServiceInput::Write(std::string* output) const {
+  PutVarint32(output, kCompactionServiceFormatVersion);
+  PutLengthPrefixedSlice(output, cf_name);
+  PutVarint64(output, snapshots.size());
+  for (SequenceNumber snapshot : snapshots) {
+    PutVarint64(output, snapshot);
+  }
+  PutVarint64(output, earliest_write_conflict_snapshot);
+  PutVarint64(output, preserve_deletes_seqnum);
+  PutVarint64(output, input_files.size());
+  for (const auto& file_name : input_files) {
+    PutLengthPrefixedSlice(output, file_name);
+  }
+  PutVarint32(output, static_cast<uint32_t>(output_level));
+  PutBool(output, has_begin);
+  PutLengthPrefixedSlice(output, begin);
+  PutBool(output, has_end);
+  PutLengthPrefixedSlice(output, end);
+  PutVarint64(output, approx_size);
+}
+
+Status CompactionServiceInput::Read(const std::string& data_str,
+                                    CompactionServiceInput* obj) {
+  assert(obj);
+  Slice input(data_str);
+  Status s = CheckFormatVersion(&input, "CompactionServiceInput");
+  if (!s.ok()) {
+    return s;
+  }
+
+  uint64_t num_snapshots = 0;
+  uint64_t num_input_files = 0;
+  uint32_t output_level = 0;
+  bool ok = GetString(&input, &obj->cf_name) &&
+            GetVarint64(&input, &num_snapshots);
+  obj->snapshots.clear();
+  for (uint64_t i = 0; ok && i < num_snapshots; i++) {
+    SequenceNumber snapshot = 0;
+    ok = GetVarint64(&input, &snapshot);
+    obj->snapshots.push_back(snapshot);
+  }
+  ok = ok && GetVarint64(&input, &obj->earliest_write_conflict_snapshot) &&
+       GetVarint64(&input, &obj->preserve_deletes_seqnum) &&
+       GetVarint64(&input, &num_input_files);
+  obj->input_files.clear();
+  for (uint64_t i = 0; ok && i < num_input_files; i++) {
+    std::string file_name;
+    ok = GetString(&input, &file_name);
+    obj->input_files.push_back(std::move(file_name));
+  }
+  ok = ok && GetVarint32(&input, &output_level) &&
+       GetBool(&input, &obj->has_begin) && GetString(&input, &obj->begin) &&
+       GetBool(&input, &obj->has_end) && GetString(&input, &obj->end) &&
+       GetVarint64(&input, &obj->approx_size) && input.empty();
+  if (!ok) {
+    return Status::Corruption("Unable to decode CompactionServiceInput");
+  }
+  obj->output_level = static_cast<int>(output_level);
+  return Status::OK();
+}
+
+void CompactionServiceResult::Write(std::string* output) const {
+  PutVarint32(output, kCompactionServiceFormatVersion);
+  PutStatus(output, status);
+  PutVarint64(output, output_files.size());
+  for (const auto& file : output_files) {
+    PutLengthPrefixedSlice(output, file.file_name);
+    PutVarint64(output, file.smallest_seqno);
+    PutVarint64(output, file.largest_seqno);
+    PutLengthPrefixedSlice(output, file.smallest_internal_key);
+    PutLengthPrefixedSlice(output, file.largest_internal_key);
+    PutVarint64(output, file.oldest_ancester_time);
+    PutVarint64(output, file.file_creation_time);
+    PutFixed64(output, file.paranoid_hash);
+    PutBool(output, file.marked_for_compaction);
+    PutLengthPrefixedSlice(output, file.file_checksum);
+    PutLengthPrefixedSlice(output, file.file_checksum_func_name);
+  }
+  PutVarint32(output, static_cast<uint32_t>(output_level));
+  PutLengthPrefixedSlice(output, output_path);
+  PutVarint64(output, num_output_records);
+  PutVarint64(output, total_bytes);
+  PutVarint64(output, num_input_deletion_records);
+  PutVarint64(output, num_corrupt_keys);
+}
+
+Status CompactionServiceResult::Read(const std::string& data_str,
+                                     CompactionServiceResult* obj) {
+  assert(obj);
+  Slice input(data_str);
+  Status s = CheckFormatVersion(&input, "CompactionServiceResult");
+  if (!s.ok()) {
+    return s;
+  }
+
+  uint64_t num_output_files = 0;
+  uint32_t output_level = 0;
+  bool ok = GetStatus(&input, &obj->status) &&
+            GetVarint64(&input, &num_output_files);
+  obj->output_files.clear();
+  for (uint64_t i = 0; ok && i < num_output_files; i++) {
+    CompactionServiceOutputFile file;
+    ok = GetString(&input, &file.file_name) &&
+         GetVarint64(&input, &file.smallest_seqno) &&
+         GetVarint64(&input, &file.largest_seqno) &&
+         GetString(&input, &file.smallest_internal_key) &&
+         GetString(&input, &file.largest_internal_key) &&
+         GetVarint64(&input, &file.oldest_ancester_time) &&
+         GetVarint64(&input, &file.file_creation_time) &&
+         GetFixed64(&input, &file.paranoid_hash) &&
+         GetBool(&input, &file.marked_for_compaction) &&
+         GetString(&input, &file.file_checksum) &&
+         GetString(&input, &file.file_checksum_func_name);
+    obj->output_files.push_back(std::move(file));
+  }
+  ok = ok && GetVarint32(&input, &output_level) &&
+       GetString(&input, &obj->output_path) &&
+       GetVarint64(&input, &obj->num_output_records) &&
+       GetVarint64(&input, &obj->total_bytes) &&
+       GetVarint64(&input, &obj->num_input_deletion_records) &&
+       GetVarint64(&input, &obj->num_corrupt_keys) && input.empty();
+  if (!ok) {
+    return Status::Corruption("Unable to decode CompactionServiceResult");
+  }
+  obj->output_level = static_cast<int>(output_level);
+  return Status::OK();
+}
+#endif  // !ROCKSDB_LITE
+
 }  // namespace ROCKSDB_NAMESPACE
@@ -40,6 +40,7 @@
 #include "rocksdb/memtablerep.h"
 #include "rocksdb/transaction_log.h"
 #include "table/scoped_arena_iterator.h"
+#include "table/table_reader.h"
 #include "util/autovector.h"
 #include "util/stop_watch.h"
 #include "util/thread_local.h"
@@ -81,7 +82,7 @@ class CompactionJob {
       const std::string& db_id = "", const std::string& db_session_id = "",
       std::string full_history_ts_low = "");
 
-  ~CompactionJob();
+  virtual ~CompactionJob();
 
   // no copy/move
   CompactionJob(CompactionJob&& job) = delete;
@@ -104,18 +105,31 @@ class CompactionJob {
   // Return the IO status
   IOStatus io_status() const { return io_status_; }
 
- private:
+ protected:
   struct SubcompactionState;
 
   void AggregateStatistics();
 
   // Generates a histogram representing potential divisions of key ranges from
-  // the input. It adds the starting and/or ending keys of certain input files
-  // to the working set and then finds the approximate size of data in between
-  // each consecutive pair of slices. Then it divides these ranges into
-  // consecutive groups such that each group has a similar size.
+  // the input. It samples the index of each input file into key anchors that
+  // split the file into ranges of similar size, sorts the anchors of all
+  // input files and then divides them into consecutive groups such that each
+  // group has a similar size.
   void GenSubcompactionBoundaries();
 
+  // Runs sub_compact and, if work stealing is enabled, then keeps taking over
+  // the upper part of the key range of the largest subcompaction still
+  // running until none can be split anymore.
+  void ProcessKeyValueCompactionAndSteal(SubcompactionState* sub_compact);
+  // Marks `finished` as done and waits for a running subcompaction to hand
+  // over part of its range. Returns the new subcompaction to run, or nullptr.
+  SubcompactionState* StealSubcompaction(SubcompactionState* finished);
+  // Called by the subcompaction split_victim_ points to, from its own thread,
+  // with the user key it is about to process. Moves the upper part of its
+  // remaining range, if large enough, to a new subcompaction.
+  void MaybeSplitSubcompaction(SubcompactionState* sub_compact,
+                               const Slice& current_user_key);
+
   // update the thread status for starting a compaction.
   void ReportStartedCompaction(Compaction* compaction);
   void AllocateCompactionOutputFileNumbers();
@@ -123,6 +137,18 @@ class CompactionJob {
   // kv-pairs
   void ProcessKeyValueCompaction(SubcompactionState* sub_compact);
 
+#ifndef ROCKSDB_LITE
+  // Hand the subcompaction to db_options_.compaction_service and, if it was
+  // run remotely, move its output files into place and record them in
+  // sub_compact->outputs. Returns kUseLocal if the caller should run the
+  // subcompaction itself.
+  CompactionServiceJobStatus ProcessKeyValueCompactionWithCompactionService(
+      SubcompactionState* sub_compact);
+#endif  // !ROCKSDB_LITE
+
+  // Name of the file output file_number is written to.
+  virtual std::string GetTableFileName(uint64_t file_number);
+
   Status FinishCompactionOutputFile(
       const Status& input_status, SubcompactionState* sub_compact,
       CompactionRangeDelAggregator* range_del_agg,
@@ -195,14 +221,134 @@ class CompactionJob {
   bool bottommost_level_;
   bool paranoid_file_checks_;
   bool measure_io_stats_;
+  // Key anchors sampled from the input files, sorted by user key
+  std::vector<TableReader::Anchor> anchors_;
   // Stores the Slices that designate the boundaries for each subcompaction
   std::vector<Slice> boundaries_;
   // Stores the approx size of keys covered in the range of each subcompaction
   std::vector<uint64_t> sizes_;
+
+  // Work stealing among subcompactions. A subcompaction that finished early
+  // sets split_victim_ and waits on split_cv_; the victim notices it while
+  // processing keys and answers through split_result_. Everything but
+  // split_victim_ is protected by split_mu_.
+  bool enable_subcompaction_stealing_;
+  port::Mutex split_mu_;
+  port::CondVar split_cv_;
+  std::atomic<const SubcompactionState*> split_victim_;
+  bool split_pending_;
+  bool split_responded_;
+  SubcompactionState* split_result_;
+  // Storage for the boundaries created by splitting subcompactions.
+  std::deque<std::string> split_keys_;
+  std::deque<Slice> split_bounds_;
   Env::WriteLifeTimeHint write_hint_;
   Env::Priority thread_pri_;
   IOStatus io_status_;
   std::string full_history_ts_low_;
 };
 
+#ifndef ROCKSDB_LITE
+// Description of a (sub)compaction that DBImpl hands to a CompactionService.
+// It only refers to input files by name, so that the worker can rebuild the
+// Compaction from its own view of the LSM tree.
+struct CompactionServiceInput {
+  std::string cf_name;
+  std::vector<SequenceNumber> snapshots;
+  SequenceNumber earliest_write_conflict_snapshot = kMaxSequenceNumber;
+  SequenceNumber preserve_deletes_seqnum = 0;
+  std::vector<std::string> input_files;
+  int output_level = 0;
+
+  // Key range of the subcompaction; begin is inclusive, end is exclusive.
+  bool has_begin = false;
+  std::string begin;
+  bool has_end = false;
+  std::string end;
+  uint64_t approx_size = 0;
+
+  static Status Read(const std::string& data_str, CompactionServiceInput* obj);
+  void Write(std::string* output) const;
+};
+
+// Metadata of an output file produced by a CompactionService worker.
+struct CompactionServiceOutputFile {
+  std::string file_name;
+  SequenceNumber smallest_seqno = 0;
+  SequenceNumber largest_seqno = 0;
+  std::string smallest_internal_key;
+  std::string largest_internal_key;
+  uint64_t oldest_ancester_time = 0;
+  uint64_t file_creation_time = 0;
+  uint64_t paranoid_hash = 0;
+  bool marked_for_compaction = false;
+  std::string file_checksum;
+  std::string file_checksum_func_name;
+};
+
+// Result of a CompactionService job, as returned by DB::OpenAndCompact().
+struct CompactionServiceResult {
+  Status status;
+  std::vector<CompactionServiceOutputFile> output_files;
+  int output_level = 0;
+
+  // Location of the output files; they still have to be moved into the DB.
+  std::string output_path;
+
+  uint64_t num_output_records = 0;
+  uint64_t total_bytes = 0;
+  uint64_t num_input_deletion_records = 0;
+  uint64_t num_corrupt_keys = 0;
+
+  static Status Read(const std::string& data_str, CompactionServiceResult* obj);
+  void Write(std::string* output) const;
+};
+
+// CompactionServiceCompactionJob is the worker side of a CompactionService:
+// it runs a single subcompaction described by a CompactionServiceInput and
+// writes the output files into output_path without installing them.
+class CompactionServiceCompactionJob : private CompactionJob {
+ public:
+  CompactionServiceCompactionJob(
+      int job_id, Compaction* compaction, const ImmutableDBOptions& db_options,
+      const FileOptions& file_options, VersionSet* versions,
+      const std::atomic<bool>* shutting_down, LogBuffer* log_buffer,
+      FSDirectory* output_directory, Statistics* stats,
+      InstrumentedMutex* db_mutex, ErrorHandler* db_error_handler,
+      std::shared_ptr<Cache> table_cache, EventLogger* event_logger,
+      const std::string& dbname, CompactionJobStats* compaction_job_stats,
+      const std::shared_ptr<IOTracer>& io_tracer, const std::string& db_id,
+      const std::string& db_session_id, const std::string& output_path,
+      const CompactionServiceInput& compaction_service_input,
+      CompactionServiceResult* compaction_service_result);
+
+  // REQUIRED: mutex held
+  void Prepare();
+
+  // REQUIRED: mutex not held
+  // Run the subcompaction and fill in the CompactionServiceResult.
+  Status Run();
+
+  // REQUIRED: mutex held
+  void CleanupCompaction();
+
+  IOStatus io_status() const { return CompactionJob::io_status(); }
+
+ protected:
+  std::string GetTableFileName(uint64_t file_number) override;
+
+ private:
+  // Output directory of the worker, also where the output files are written.
+  const std::string output_path_;
+
+  // Compaction job input
+  const CompactionServiceInput& compaction_input_;
+  Slice begin_;
+  Slice end_;
+
+  // Compaction job result
+  CompactionServiceResult* compaction_result_;
+};
+#endif  // !ROCKSDB_LITE
+
 }  // namespace ROCKSDB_NAMESPACE
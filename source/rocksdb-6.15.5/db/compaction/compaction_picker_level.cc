@@ -7,6 +7,7 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file. See the AUTHORS file for names of contributors.
 
+#include <algorithm>
 #include <string>
 #include <utility>
 #include <vector>
@@ -31,6 +32,15 @@ bool LevelCompactionPicker::NeedsCompaction(
   if (!vstorage->FilesMarkedForCompaction().empty()) {
     return true;
   }
+  if (!vstorage->FilesMarkedForForcedBlobGC().empty()) {
+    return true;
+  }
+  if (!vstorage->FilesMarkedForReadTriggeredCompaction().empty()) {
+    return true;
+  }
+  if (!vstorage->FilesMarkedForTemperatureMigration().empty()) {
+    return true;
+  }
   for (int i = 0; i <= vstorage->MaxInputLevel(); i++) {
     if (vstorage->CompactionScore(i) >= 1) {
       return true;
@@ -103,6 +113,10 @@ class LevelCompactionBuilder {
       const autovector<std::pair<int, FileMetaData*>>& level_files,
       bool compact_to_next_level);
 
+  // Returns true if a read-triggered compaction is already running, in which
+  // case no other one is picked.
+  bool ReadTriggeredCompactionInProgress() const;
+
   const std::string& cf_name_;
   VersionStorageInfo* vstorage_;
   SequenceNumber earliest_mem_seqno_;
@@ -128,6 +142,10 @@ class LevelCompactionBuilder {
                             const MutableCFOptions& mutable_cf_options,
                             int level);
 
+  // Moves `path_id`, picked by level, to the path matching the temperature
+  // of the data in compaction_inputs_, see cold_data_age_seconds.
+  uint32_t GetTemperaturePathId(uint32_t path_id) const;
+
   static const int kMinFilesForIntraL0Compaction = 4;
 };
 
@@ -248,6 +266,42 @@ void LevelCompactionBuilder::SetupInitialFiles() {
     compaction_reason_ = CompactionReason::kPeriodicCompaction;
     return;
   }
+
+  // Forced blob garbage collection
+  PickFileToCompact(vstorage_->FilesMarkedForForcedBlobGC(), false);
+  if (!start_level_inputs_.empty()) {
+    compaction_reason_ = CompactionReason::kForcedBlobGC;
+    return;
+  }
+
+  // Migration of cold files to the last path
+  PickFileToCompact(vstorage_->FilesMarkedForTemperatureMigration(), false);
+  if (!start_level_inputs_.empty()) {
+    compaction_reason_ = CompactionReason::kTemperatureMigration;
+    return;
+  }
+
+  // Read-triggered compaction. It only serves to speed up reads, so do not
+  // let it compete with compactions that keep the shape of the LSM tree.
+  if (!vstorage_->FilesMarkedForReadTriggeredCompaction().empty() &&
+      vstorage_->CompactionScore(0) < 1 &&
+      !ReadTriggeredCompactionInProgress()) {
+    PickFileToCompact(vstorage_->FilesMarkedForReadTriggeredCompaction(),
+                      true);
+    if (!start_level_inputs_.empty()) {
+      compaction_reason_ = CompactionReason::kReadTriggered;
+      return;
+    }
+  }
+}
+
+bool LevelCompactionBuilder::ReadTriggeredCompactionInProgress() const {
+  for (Compaction* c : *compaction_picker_->compactions_in_progress()) {
+    if (c->compaction_reason() == CompactionReason::kReadTriggered) {
+      return true;
+    }
+  }
+  return false;
 }
 
 bool LevelCompactionBuilder::SetupOtherL0FilesIfNeeded() {
@@ -325,14 +379,18 @@ Compaction* LevelCompactionBuilder::PickCompaction() {
 }
 
 Compaction* LevelCompactionBuilder::GetCompaction() {
+  uint32_t path_id = GetPathId(ioptions_, mutable_cf_options_, output_level_);
+  if (mutable_cf_options_.cold_data_age_seconds > 0 &&
+      ioptions_.cf_paths.size() > 1) {
+    path_id = GetTemperaturePathId(path_id);
+  }
   auto c = new Compaction(
       vstorage_, ioptions_, mutable_cf_options_, mutable_db_options_,
       std::move(compaction_inputs_), output_level_,
       MaxFileSizeForLevel(mutable_cf_options_, output_level_,
                           ioptions_.compaction_style, vstorage_->base_level(),
                           ioptions_.level_compaction_dynamic_level_bytes),
-      mutable_cf_options_.max_compaction_bytes,
-      GetPathId(ioptions_, mutable_cf_options_, output_level_),
+      mutable_cf_options_.max_compaction_bytes, path_id,
       GetCompressionType(ioptions_, vstorage_, mutable_cf_options_,
                          output_level_, vstorage_->base_level()),
       GetCompressionOptions(mutable_cf_options_, vstorage_, output_level_),
@@ -405,6 +463,45 @@ uint32_t LevelCompactionBuilder::GetPathId(
   return p;
 }
 
+uint32_t LevelCompactionBuilder::GetTemperaturePathId(uint32_t path_id) const {
+  int64_t temp_current_time;
+  if (!ioptions_.env->GetCurrentTime(&temp_current_time).ok()) {
+    return path_id;
+  }
+  uint64_t num_reads_sampled = 0;
+  uint64_t data_size = 0;
+  // The output is only as old as the newest data going into it.
+  uint64_t oldest_ancester_time = 0;
+  bool ancester_time_known = true;
+  for (const auto& input : compaction_inputs_) {
+    for (FileMetaData* f : input.files) {
+      num_reads_sampled +=
+          f->stats.num_reads_sampled.load(std::memory_order_relaxed);
+      data_size += f->fd.GetFileSize();
+      uint64_t t = f->TryGetOldestAncesterTime();
+      if (t == kUnknownOldestAncesterTime) {
+        ancester_time_known = false;
+      }
+      oldest_ancester_time = std::max(oldest_ancester_time, t);
+    }
+  }
+  if (!ancester_time_known) {
+    oldest_ancester_time = kUnknownOldestAncesterTime;
+  }
+  switch (vstorage_->GetDataTemperature(
+      num_reads_sampled, data_size, oldest_ancester_time,
+      static_cast<uint64_t>(temp_current_time),
+      mutable_cf_options_.cold_data_age_seconds)) {
+    case VersionStorageInfo::DataTemperature::kHot:
+      return path_id > 0 ? path_id - 1 : 0;
+    case VersionStorageInfo::DataTemperature::kCold:
+      return static_cast<uint32_t>(ioptions_.cf_paths.size() - 1);
+    case VersionStorageInfo::DataTemperature::kWarm:
+      break;
+  }
+  return path_id;
+}
+
 bool LevelCompactionBuilder::PickFileToCompact() {
   // level 0 files are overlapping. So we cannot pick more
   // than one concurrent compactions at this level. This
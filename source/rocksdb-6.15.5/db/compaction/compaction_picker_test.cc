@@ -561,6 +561,92 @@ TEST_F(CompactionPickerTest, AllowsTrivialMoveUniversal) {
   ASSERT_TRUE(compaction->is_trivial_move());
 }
 
+TEST_F(CompactionPickerTest, UniversalLazyLevelingTierNotFull) {
+  mutable_cf_options_.write_buffer_size = 100;
+  mutable_cf_options_.max_bytes_for_level_multiplier = 4;
+  mutable_cf_options_.compaction_options_universal.lazy_leveling = true;
+  UniversalCompactionPicker universal_compaction_picker(ioptions_, &icmp_);
+
+  NewVersionStorage(5, kCompactionStyleUniversal);
+
+  // Three runs of tier 0, more than level0_file_num_compaction_trigger
+  Add(0, 1U, "150", "200", 100, 0, 500, 550);
+  Add(0, 2U, "201", "250", 100, 0, 401, 450);
+  Add(0, 3U, "260", "300", 100, 0, 301, 350);
+  Add(4, 4U, "100", "400", 10000, 0, 100, 150);
+  UpdateVersionStorageInfo();
+
+  ASSERT_FALSE(universal_compaction_picker.NeedsCompaction(vstorage_.get()));
+  std::unique_ptr<Compaction> compaction(
+      universal_compaction_picker.PickCompaction(
+          cf_name_, mutable_cf_options_, mutable_db_options_, vstorage_.get(),
+          &log_buffer_));
+  ASSERT_TRUE(compaction.get() == nullptr);
+}
+
+TEST_F(CompactionPickerTest, UniversalLazyLevelingMergesTier) {
+  mutable_cf_options_.write_buffer_size = 100;
+  mutable_cf_options_.max_bytes_for_level_multiplier = 4;
+  mutable_cf_options_.compaction_options_universal.lazy_leveling = true;
+  UniversalCompactionPicker universal_compaction_picker(ioptions_, &icmp_);
+
+  NewVersionStorage(5, kCompactionStyleUniversal);
+
+  // Four runs of tier 0, a run of tier 1 and the last run of tier 3
+  Add(0, 1U, "150", "200", 100, 0, 500, 550);
+  Add(0, 2U, "201", "250", 100, 0, 401, 450);
+  Add(0, 3U, "260", "300", 100, 0, 301, 350);
+  Add(0, 4U, "110", "140", 100, 0, 251, 300);
+  Add(3, 5U, "100", "400", 400, 0, 151, 250);
+  Add(4, 6U, "100", "400", 10000, 0, 100, 150);
+  UpdateVersionStorageInfo();
+
+  ASSERT_TRUE(universal_compaction_picker.NeedsCompaction(vstorage_.get()));
+  std::unique_ptr<Compaction> compaction(
+      universal_compaction_picker.PickCompaction(
+          cf_name_, mutable_cf_options_, mutable_db_options_, vstorage_.get(),
+          &log_buffer_));
+  ASSERT_TRUE(compaction.get() != nullptr);
+  // The tier 0 runs are merged into a tier 1 run, above the existing one
+  ASSERT_EQ(0, compaction->start_level());
+  ASSERT_EQ(2, compaction->output_level());
+  ASSERT_EQ(4U, compaction->num_input_files(0));
+  for (size_t i = 1; i < compaction->num_input_levels(); i++) {
+    ASSERT_EQ(0U, compaction->num_input_files(i));
+  }
+}
+
+TEST_F(CompactionPickerTest, UniversalLazyLevelingMergesIntoLastRun) {
+  mutable_cf_options_.write_buffer_size = 100;
+  mutable_cf_options_.max_bytes_for_level_multiplier = 4;
+  mutable_cf_options_.compaction_options_universal.lazy_leveling = true;
+  mutable_cf_options_.compaction_options_universal.max_runs_per_tier = {4, 2};
+  UniversalCompactionPicker universal_compaction_picker(ioptions_, &icmp_);
+
+  NewVersionStorage(5, kCompactionStyleUniversal);
+
+  // A run of tier 0, two runs of tier 1 and the last run of tier 2
+  Add(0, 1U, "150", "200", 100, 0, 500, 550);
+  Add(2, 2U, "100", "400", 400, 0, 301, 450);
+  Add(3, 3U, "100", "400", 400, 0, 151, 300);
+  Add(4, 4U, "100", "400", 2000, 0, 100, 150);
+  UpdateVersionStorageInfo();
+
+  ASSERT_TRUE(universal_compaction_picker.NeedsCompaction(vstorage_.get()));
+  std::unique_ptr<Compaction> compaction(
+      universal_compaction_picker.PickCompaction(
+          cf_name_, mutable_cf_options_, mutable_db_options_, vstorage_.get(),
+          &log_buffer_));
+  ASSERT_TRUE(compaction.get() != nullptr);
+  // Tier 1 is right above the last run, so it gets leveled into it
+  ASSERT_EQ(2, compaction->start_level());
+  ASSERT_EQ(4, compaction->output_level());
+  ASSERT_EQ(1U, compaction->num_input_files(0));
+  ASSERT_EQ(1U, compaction->num_input_files(1));
+  ASSERT_EQ(1U, compaction->num_input_files(2));
+  ASSERT_FALSE(vstorage_->LevelFiles(0)[0]->being_compacted);
+}
+
 TEST_F(CompactionPickerTest, UniversalPeriodicCompaction1) {
   // The case where universal periodic compaction can be picked
   // with some newer files being compacted.
@@ -87,6 +87,18 @@ class UniversalCompactionBuilder {
   // Pick Universal compaction to limit space amplification.
   Compaction* PickCompactionToReduceSizeAmp();
 
+  // Pick a compaction following the lazy leveling policy: the sorted runs of
+  // a full tier are merged into a single run, or into the oldest sorted run
+  // if the tier is the one right above it.
+  Compaction* PickLazyLevelingCompaction();
+
+  // Form a compaction from the sorted runs in [start_index,
+  // first_index_after). The caller is responsible for making sure that those
+  // files are not in compaction.
+  Compaction* PickCompactionForSortedRuns(size_t start_index,
+                                          size_t first_index_after,
+                                          CompactionReason compaction_reason);
+
   Compaction* PickDeleteTriggeredCompaction();
 
   // Form a compaction from the sorted run indicated by start_index to the
@@ -361,11 +373,16 @@ Compaction* UniversalCompactionBuilder::PickCompaction() {
   score_ = vstorage_->CompactionScore(kLevel0);
   sorted_runs_ = CalculateSortedRuns(*vstorage_);
 
+  const bool lazy_leveling =
+      mutable_cf_options_.compaction_options_universal.lazy_leveling;
+  // With lazy leveling, the score tells whether a tier is full
   if (sorted_runs_.size() == 0 ||
       (vstorage_->FilesMarkedForPeriodicCompaction().empty() &&
        vstorage_->FilesMarkedForCompaction().empty() &&
-       sorted_runs_.size() < (unsigned int)mutable_cf_options_
-                                 .level0_file_num_compaction_trigger)) {
+       (lazy_leveling ? score_ < 1
+                      : sorted_runs_.size() <
+                            (unsigned int)mutable_cf_options_
+                                .level0_file_num_compaction_trigger))) {
     ROCKS_LOG_BUFFER(log_buffer_, "[%s] Universal: nothing to do\n",
                      cf_name_.c_str());
     TEST_SYNC_POINT_CALLBACK(
@@ -386,8 +403,19 @@ Compaction* UniversalCompactionBuilder::PickCompaction() {
     c = PickPeriodicCompaction();
   }
 
+  if (c == nullptr && lazy_leveling && sorted_runs_.size() > 1) {
+    if ((c = PickCompactionToReduceSizeAmp()) != nullptr) {
+      ROCKS_LOG_BUFFER(log_buffer_, "[%s] Universal: compacting for size amp\n",
+                       cf_name_.c_str());
+    } else if ((c = PickLazyLevelingCompaction()) != nullptr) {
+      ROCKS_LOG_BUFFER(log_buffer_,
+                       "[%s] Universal: compacting for lazy leveling\n",
+                       cf_name_.c_str());
+    }
+  }
+
   // Check for size amplification.
-  if (c == nullptr &&
+  if (c == nullptr && !lazy_leveling &&
       sorted_runs_.size() >=
           static_cast<size_t>(
               mutable_cf_options_.level0_file_num_compaction_trigger)) {
@@ -646,7 +674,19 @@ Compaction* UniversalCompactionBuilder::PickCompactionToReduceSortedRuns(
   if (!done || candidate_count <= 1) {
     return nullptr;
   }
-  size_t first_index_after = start_index + candidate_count;
+  CompactionReason compaction_reason;
+  if (max_number_of_files_to_compact == UINT_MAX) {
+    compaction_reason = CompactionReason::kUniversalSizeRatio;
+  } else {
+    compaction_reason = CompactionReason::kUniversalSortedRunNum;
+  }
+  return PickCompactionForSortedRuns(
+      start_index, start_index + candidate_count, compaction_reason);
+}
+
+Compaction* UniversalCompactionBuilder::PickCompactionForSortedRuns(
+    size_t start_index, size_t first_index_after,
+    CompactionReason compaction_reason) {
   // Compression is enabled if files compacted earlier already reached
   // size ratio of compression.
   bool enable_compression = true;
@@ -712,12 +752,6 @@ Compaction* UniversalCompactionBuilder::PickCompactionToReduceSortedRuns(
                      cf_name_.c_str(), file_num_buf);
   }
 
-  CompactionReason compaction_reason;
-  if (max_number_of_files_to_compact == UINT_MAX) {
-    compaction_reason = CompactionReason::kUniversalSizeRatio;
-  } else {
-    compaction_reason = CompactionReason::kUniversalSortedRunNum;
-  }
   return new Compaction(
       vstorage_, ioptions_, mutable_cf_options_, mutable_db_options_,
       std::move(inputs), output_level,
@@ -822,6 +856,68 @@ Compaction* UniversalCompactionBuilder::PickCompactionToReduceSizeAmp() {
                                 CompactionReason::kUniversalSizeAmplification);
 }
 
+// Lazy leveling groups the sorted runs other than the oldest one into tiers
+// by size (see LazyLevelingTier()). Consecutive runs of the same tier are
+// merged into one run of the next tier once there are
+// LazyLevelingMaxRunsInTier() of them. The runs of the tier right above the
+// oldest run are merged into the oldest run instead, so that the last level
+// is the only one with leveling behavior.
+Compaction* UniversalCompactionBuilder::PickLazyLevelingCompaction() {
+  assert(sorted_runs_.size() > 1);
+  const size_t last_index = sorted_runs_.size() - 1;
+  const int last_tier =
+      LazyLevelingTier(mutable_cf_options_, sorted_runs_[last_index].size);
+  auto tier_of = [&](size_t i) {
+    return std::min(LazyLevelingTier(mutable_cf_options_, sorted_runs_[i].size),
+                    last_tier);
+  };
+
+  for (size_t start_index = 0; start_index < last_index;) {
+    if (sorted_runs_[start_index].being_compacted) {
+      start_index++;
+      continue;
+    }
+    const int tier = tier_of(start_index);
+    size_t first_index_after = start_index + 1;
+    while (first_index_after < last_index &&
+           !sorted_runs_[first_index_after].being_compacted &&
+           tier_of(first_index_after) == tier) {
+      first_index_after++;
+    }
+    const size_t num_runs = first_index_after - start_index;
+    if (num_runs <
+        static_cast<size_t>(LazyLevelingMaxRunsInTier(mutable_cf_options_,
+                                                      tier))) {
+      start_index = first_index_after;
+      continue;
+    }
+
+    if (tier + 1 < last_tier) {
+      ROCKS_LOG_BUFFER(log_buffer_,
+                       "[%s] Universal: lazy leveling merges %" ROCKSDB_PRIszt
+                       " sorted runs of tier %d",
+                       cf_name_.c_str(), num_runs, tier);
+      return PickCompactionForSortedRuns(
+          start_index, first_index_after,
+          CompactionReason::kUniversalSortedRunNum);
+    }
+    // The runs get merged into the oldest sorted run; this requires all runs
+    // in between to be available.
+    for (size_t i = first_index_after; i <= last_index; i++) {
+      if (sorted_runs_[i].being_compacted) {
+        return nullptr;
+      }
+    }
+    ROCKS_LOG_BUFFER(log_buffer_,
+                     "[%s] Universal: lazy leveling merges %" ROCKSDB_PRIszt
+                     " sorted runs of tier %d into the oldest sorted run",
+                     cf_name_.c_str(), num_runs, tier);
+    return PickCompactionToOldest(start_index,
+                                  CompactionReason::kUniversalSortedRunNum);
+  }
+  return nullptr;
+}
+
 // Pick files marked for compaction. Typically, files are marked by
 // CompactOnDeleteCollector due to the presence of tombstones.
 Compaction* UniversalCompactionBuilder::PickDeleteTriggeredCompaction() {
@@ -994,6 +1090,9 @@ Compaction* UniversalCompactionBuilder::PickCompactionToOldest(
     } else if (compaction_reason ==
                CompactionReason::kUniversalSizeAmplification) {
       comp_reason_print_string = "size amp";
+    } else if (compaction_reason ==
+               CompactionReason::kUniversalSortedRunNum) {
+      comp_reason_print_string = "lazy leveling";
     } else {
       assert(false);
       comp_reason_print_string = "unknown: ";
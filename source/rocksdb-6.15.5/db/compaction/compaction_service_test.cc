@@ -0,0 +1,219 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "db/db_test_util.h"
+#include "port/stack_trace.h"
+#include "util/mutexlock.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+#ifndef ROCKSDB_LITE
+// A stand-in for a compaction worker running on localhost: it runs
+// DB::OpenAndCompact() itself when the DB waits for a job.
+class MyTestCompactionService : public CompactionService {
+ public:
+  MyTestCompactionService(const std::string& db_path, const Options& options)
+      : db_path_(db_path), options_(options) {}
+
+  const char* Name() const override { return "MyTestCompactionService"; }
+
+  CompactionServiceJobStatus Start(const std::string& compaction_service_input,
+                                   uint64_t job_id) override {
+    MutexLock l(&mutex_);
+    jobs_.emplace(job_id, compaction_service_input);
+    return start_status_;
+  }
+
+  CompactionServiceJobStatus WaitForComplete(
+      uint64_t job_id, std::string* compaction_service_result) override {
+    std::string compaction_input;
+    {
+      MutexLock l(&mutex_);
+      auto i = jobs_.find(job_id);
+      if (i == jobs_.end()) {
+        return CompactionServiceJobStatus::kFailure;
+      }
+      compaction_input = std::move(i->second);
+      jobs_.erase(i);
+    }
+
+    CompactionServiceOptionsOverride options_override;
+    options_override.env = options_.env;
+    options_override.file_checksum_gen_factory =
+        options_.file_checksum_gen_factory;
+    options_override.comparator = options_.comparator;
+    options_override.merge_operator = options_.merge_operator;
+    options_override.compaction_filter = options_.compaction_filter;
+    options_override.compaction_filter_factory =
+        options_.compaction_filter_factory;
+    options_override.prefix_extractor = options_.prefix_extractor;
+    options_override.table_factory = options_.table_factory;
+    options_override.sst_partitioner_factory = options_.sst_partitioner_factory;
+
+    Status s = DB::OpenAndCompact(db_path_, db_path_ + "/" + ToString(job_id),
+                                  compaction_input, compaction_service_result,
+                                  options_override);
+    if (s.ok()) {
+      compaction_num_.fetch_add(1);
+    }
+    if (wait_status_ != CompactionServiceJobStatus::kSuccess) {
+      return wait_status_;
+    }
+    return s.ok() ? CompactionServiceJobStatus::kSuccess
+                  : CompactionServiceJobStatus::kFailure;
+  }
+
+  int GetCompactionNum() { return compaction_num_.load(); }
+
+  void OverrideStartStatus(CompactionServiceJobStatus s) { start_status_ = s; }
+
+  void OverrideWaitStatus(CompactionServiceJobStatus s) { wait_status_ = s; }
+
+ private:
+  port::Mutex mutex_;
+  std::atomic_int compaction_num_{0};
+  std::map<uint64_t, std::string> jobs_;
+  const std::string db_path_;
+  Options options_;
+  CompactionServiceJobStatus start_status_ =
+      CompactionServiceJobStatus::kSuccess;
+  CompactionServiceJobStatus wait_status_ =
+      CompactionServiceJobStatus::kSuccess;
+};
+
+class CompactionServiceTest : public DBTestBase {
+ public:
+  CompactionServiceTest()
+      : DBTestBase("/compaction_service_test", /*env_do_fsync=*/true) {}
+
+ protected:
+  Options GetOptionsWithService() {
+    Options options = CurrentOptions();
+    options.env = env_;
+    options.disable_auto_compactions = true;
+    compaction_service_ =
+        std::make_shared<MyTestCompactionService>(dbname_, options);
+    options.compaction_service = compaction_service_;
+    return options;
+  }
+
+  // Writes 20 overlapping L0 files, the second half overwriting every other
+  // key of the first.
+  void GenerateTestData() {
+    for (int i = 0; i < 10; i++) {
+      for (int j = 0; j < 10; j++) {
+        int key_id = i * 10 + j;
+        ASSERT_OK(Put(Key(key_id), "value" + ToString(key_id)));
+      }
+      ASSERT_OK(Flush());
+    }
+    for (int i = 0; i < 10; i++) {
+      for (int j = 0; j < 10; j++) {
+        int key_id = i * 20 + j * 2;
+        ASSERT_OK(Put(Key(key_id), "value_new" + ToString(key_id)));
+      }
+      ASSERT_OK(Flush());
+    }
+  }
+
+  void VerifyTestData() {
+    for (int i = 0; i < 200; i++) {
+      auto result = Get(Key(i));
+      if (i % 2) {
+        if (i < 100) {
+          ASSERT_EQ(result, "value" + ToString(i));
+        } else {
+          ASSERT_EQ(result, "NOT_FOUND");
+        }
+      } else {
+        ASSERT_EQ(result, "value_new" + ToString(i));
+      }
+    }
+  }
+
+  std::shared_ptr<MyTestCompactionService> compaction_service_;
+};
+
+TEST_F(CompactionServiceTest, BasicCompactions) {
+  Options options = GetOptionsWithService();
+  DestroyAndReopen(options);
+  GenerateTestData();
+
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+  ASSERT_GE(compaction_service_->GetCompactionNum(), 1);
+  ASSERT_EQ(0, NumTableFilesAtLevel(0));
+  VerifyTestData();
+
+  // The remote outputs were installed durably.
+  Reopen(options);
+  VerifyTestData();
+}
+
+TEST_F(CompactionServiceTest, Snapshot) {
+  Options options = GetOptionsWithService();
+  DestroyAndReopen(options);
+
+  ASSERT_OK(Put(Key(1), "value1"));
+  ASSERT_OK(Put(Key(2), "value1"));
+  const Snapshot* snapshot = db_->GetSnapshot();
+  ASSERT_OK(Flush());
+
+  ASSERT_OK(Put(Key(1), "value2"));
+  ASSERT_OK(Delete(Key(2)));
+  ASSERT_OK(Flush());
+
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+  ASSERT_GE(compaction_service_->GetCompactionNum(), 1);
+  ASSERT_EQ("value1", Get(Key(1), snapshot));
+  ASSERT_EQ("value1", Get(Key(2), snapshot));
+  ASSERT_EQ("value2", Get(Key(1)));
+  ASSERT_EQ("NOT_FOUND", Get(Key(2)));
+  db_->ReleaseSnapshot(snapshot);
+}
+
+TEST_F(CompactionServiceTest, FallbackToLocal) {
+  Options options = GetOptionsWithService();
+  DestroyAndReopen(options);
+  GenerateTestData();
+
+  compaction_service_->OverrideStartStatus(
+      CompactionServiceJobStatus::kUseLocal);
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+  ASSERT_EQ(0, compaction_service_->GetCompactionNum());
+  ASSERT_EQ(0, NumTableFilesAtLevel(0));
+  VerifyTestData();
+}
+
+TEST_F(CompactionServiceTest, FailedCompaction) {
+  Options options = GetOptionsWithService();
+  DestroyAndReopen(options);
+  GenerateTestData();
+
+  compaction_service_->OverrideWaitStatus(
+      CompactionServiceJobStatus::kFailure);
+  ASSERT_NOK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+  // Nothing was installed.
+  ASSERT_EQ(20, NumTableFilesAtLevel(0));
+  VerifyTestData();
+}
+
+TEST_F(CompactionServiceTest, InvalidInput) {
+  Options options = GetOptionsWithService();
+  DestroyAndReopen(options);
+
+  std::string output;
+  Status s = DB::OpenAndCompact(dbname_, dbname_ + "/invalid", "garbage",
+                                &output, CompactionServiceOptionsOverride());
+  ASSERT_TRUE(s.IsCorruption() || s.IsNotSupported());
+}
+#endif  // ROCKSDB_LITE
+
+}  // namespace ROCKSDB_NAMESPACE
+
+int main(int argc, char** argv) {
+  ROCKSDB_NAMESPACE::port::InstallStackTraceHandler();
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,219 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "db/compaction/filter_batch_iterator.h"
+
+#include <algorithm>
+
+#include "db/dbformat.h"
+#include "util/stop_watch.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+FilterBatchIterator::FilterBatchIterator(InternalIterator* input,
+                                         const CompactionFilter* filter,
+                                         int level, const Comparator* ucmp,
+                                         size_t batch_size, int num_threads,
+                                         Env* env, bool report_detailed_time)
+    : input_(input),
+      filter_(filter),
+      level_(level),
+      ucmp_(ucmp),
+      batch_size_(std::max<size_t>(batch_size, 1)),
+      num_threads_(std::max(num_threads, 0)),
+      env_(env),
+      report_detailed_time_(report_detailed_time) {
+  assert(input_ != nullptr);
+  assert(filter_ != nullptr);
+  if (num_threads_ > 0) {
+    thread_pool_.reset(NewThreadPool(num_threads_));
+  }
+  ReadWindows();
+}
+
+FilterBatchIterator::~FilterBatchIterator() {
+  Reset();
+  if (thread_pool_ != nullptr) {
+    thread_pool_->WaitForJobsAndJoinAllThreads();
+  }
+}
+
+void FilterBatchIterator::SeekToFirst() {
+  Reset();
+  input_->SeekToFirst();
+  ReadWindows();
+}
+
+void FilterBatchIterator::SeekToLast() {
+  assert(false);
+  Reset();
+}
+
+void FilterBatchIterator::Seek(const Slice& target) {
+  Reset();
+  input_->Seek(target);
+  ReadWindows();
+}
+
+void FilterBatchIterator::SeekForPrev(const Slice& /*target*/) {
+  assert(false);
+  Reset();
+}
+
+void FilterBatchIterator::Next() {
+  assert(Valid());
+  pos_++;
+  if (pos_ < cur_->entries.size() || next_ == nullptr) {
+    return;
+  }
+  cur_ = std::move(next_);
+  pos_ = 0;
+  WaitForWindow(cur_.get());
+  next_ = ReadWindow();
+}
+
+void FilterBatchIterator::Prev() { assert(false); }
+
+Status FilterBatchIterator::status() const { return input_->status(); }
+
+bool FilterBatchIterator::GetFilterDecision(
+    CompactionFilter::Decision* decision, std::string* new_value,
+    std::string* skip_until, uint64_t* filter_nanos) const {
+  assert(Valid());
+  const Entry& entry = cur_->entries[pos_];
+  if (entry.batch < 0) {
+    return false;
+  }
+  const Batch& batch = cur_->batches[entry.batch];
+  const CompactionFilter::BatchEntry& result = batch.entries[entry.index];
+  *decision = result.decision;
+  *new_value = result.new_value;
+  *skip_until = result.skip_until;
+  // The time of a batch is charged evenly to its entries.
+  *filter_nanos = batch.filter_nanos / batch.entries.size();
+  return true;
+}
+
+std::unique_ptr<FilterBatchIterator::Window>
+FilterBatchIterator::ReadWindow() {
+  if (!input_->Valid()) {
+    return nullptr;
+  }
+  std::unique_ptr<Window> window(new Window());
+  const size_t max_filtered =
+      batch_size_ * static_cast<size_t>(std::max(num_threads_, 1));
+  size_t num_filtered = 0;
+  size_t bytes = 0;
+  while (input_->Valid() && num_filtered < max_filtered &&
+         bytes < kMaxWindowBytes) {
+    window->entries.emplace_back();
+    Entry& entry = window->entries.back();
+    Slice key = input_->key();
+    Slice value = input_->value();
+    entry.key.assign(key.data(), key.size());
+    entry.value.assign(value.data(), value.size());
+    bytes += key.size() + value.size();
+
+    ParsedInternalKey ikey;
+    if (ParseInternalKey(entry.key, &ikey, false /* log_err_key */).ok()) {
+      bool first = !has_last_user_key_ ||
+                   ucmp_->Compare(ikey.user_key, last_user_key_) != 0;
+      if (first) {
+        last_user_key_.assign(ikey.user_key.data(), ikey.user_key.size());
+        has_last_user_key_ = true;
+        if (ikey.type == kTypeValue || ikey.type == kTypeBlobIndex) {
+          entry.batch = 0;
+          num_filtered++;
+        }
+      }
+    }
+    input_->Next();
+  }
+
+  // The entries are in place now, so the batches can point into them.
+  window->batches.resize((num_filtered + batch_size_ - 1) / batch_size_);
+  size_t n = 0;
+  for (Entry& entry : window->entries) {
+    if (entry.batch < 0) {
+      continue;
+    }
+    entry.batch = static_cast<int>(n / batch_size_);
+    Batch& batch = window->batches[entry.batch];
+    entry.index = batch.entries.size();
+    batch.entries.emplace_back();
+    CompactionFilter::BatchEntry& batch_entry = batch.entries.back();
+    ParsedInternalKey ikey;
+    Status s = ParseInternalKey(entry.key, &ikey, false /* log_err_key */);
+    assert(s.ok());
+    s.PermitUncheckedError();
+    if (ikey.type == kTypeValue) {
+      batch_entry.key = ikey.user_key;
+      batch_entry.value_type = CompactionFilter::ValueType::kValue;
+    } else {
+      // BlobIndexCompactionFilter takes the internal key, as for FilterV2().
+      batch_entry.key = entry.key;
+      batch_entry.value_type = CompactionFilter::ValueType::kBlobIndex;
+    }
+    batch_entry.existing_value = entry.value;
+    n++;
+  }
+
+  if (thread_pool_ == nullptr) {
+    for (size_t i = 0; i < window->batches.size(); i++) {
+      FilterBatch(window.get(), i);
+    }
+  } else {
+    window->pending = window->batches.size();
+    for (size_t i = 0; i < window->batches.size(); i++) {
+      Window* w = window.get();
+      thread_pool_->SubmitJob([this, w, i]() {
+        FilterBatch(w, i);
+        MutexLock l(&w->mu);
+        if (--w->pending == 0) {
+          w->cv.SignalAll();
+        }
+      });
+    }
+  }
+  return window;
+}
+
+void FilterBatchIterator::ReadWindows() {
+  cur_ = ReadWindow();
+  if (cur_ != nullptr) {
+    WaitForWindow(cur_.get());
+  }
+  next_ = ReadWindow();
+}
+
+void FilterBatchIterator::FilterBatch(Window* window, size_t batch) {
+  Batch& b = window->batches[batch];
+  StopWatchNano timer(env_, report_detailed_time_ && env_ != nullptr);
+  filter_->FilterBatch(level_, &b.entries);
+  b.filter_nanos =
+      report_detailed_time_ && env_ != nullptr ? timer.ElapsedNanos() : 0;
+}
+
+void FilterBatchIterator::WaitForWindow(Window* window) {
+  MutexLock l(&window->mu);
+  while (window->pending > 0) {
+    window->cv.Wait();
+  }
+}
+
+void FilterBatchIterator::Reset() {
+  if (cur_ != nullptr) {
+    WaitForWindow(cur_.get());
+    cur_.reset();
+  }
+  if (next_ != nullptr) {
+    WaitForWindow(next_.get());
+    next_.reset();
+  }
+  pos_ = 0;
+  has_last_user_key_ = false;
+}
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -0,0 +1,137 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "port/port.h"
+#include "rocksdb/compaction_filter.h"
+#include "rocksdb/env.h"
+#include "rocksdb/threadpool.h"
+#include "table/internal_iterator.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// Reads the input of a compaction ahead of the CompactionIterator and runs
+// the compaction filter on it in batches through
+// CompactionFilter::FilterBatch(), see compaction_filter_batch_size.
+//
+// The entries read ahead are copied into windows of up to `num_threads`
+// batches of `batch_size` filtered entries each. While the compaction
+// iterator consumes one window, the next one is filtered on a thread pool of
+// `num_threads` threads, one batch per thread; with no threads, windows are
+// filtered on the compaction thread when they are read.
+//
+// The filter is run on the first entry of each user key if it is a value or
+// a blob index, which is the entry the compaction iterator runs the filter on
+// when there is no snapshot checker and no user-defined timestamp. The
+// compaction iterator picks up the decisions through GetFilterDecision().
+//
+// Only supports forward iteration. The keys and values are not pinned and
+// are valid until the iterator moves on to the next window.
+class FilterBatchIterator : public InternalIterator {
+ public:
+  // Owns neither `input` nor `filter`, which must outlive the iterator.
+  // Starts at the current position of `input`.
+  FilterBatchIterator(InternalIterator* input, const CompactionFilter* filter,
+                      int level, const Comparator* ucmp, size_t batch_size,
+                      int num_threads, Env* env, bool report_detailed_time);
+  ~FilterBatchIterator() override;
+
+  // No copying allowed
+  FilterBatchIterator(const FilterBatchIterator&) = delete;
+  FilterBatchIterator& operator=(const FilterBatchIterator&) = delete;
+
+  bool Valid() const override {
+    return cur_ != nullptr && pos_ < cur_->entries.size();
+  }
+  void SeekToFirst() override;
+  void SeekToLast() override;
+  void Seek(const Slice& target) override;
+  void SeekForPrev(const Slice& target) override;
+  void Next() override;
+  void Prev() override;
+  Slice key() const override {
+    assert(Valid());
+    return cur_->entries[pos_].key;
+  }
+  Slice value() const override {
+    assert(Valid());
+    return cur_->entries[pos_].value;
+  }
+  Status status() const override;
+
+  // If the filter ran on the current entry, sets the outputs of its
+  // decision, as for CompactionFilter::FilterV2(), along with the time spent
+  // on it if report_detailed_time is set, and returns true. Returns false
+  // otherwise.
+  bool GetFilterDecision(CompactionFilter::Decision* decision,
+                         std::string* new_value, std::string* skip_until,
+                         uint64_t* filter_nanos) const;
+
+ private:
+  // Stop reading ahead into a window past this many bytes, however few of
+  // its entries are filtered.
+  static const size_t kMaxWindowBytes = 4 << 20;
+
+  struct Entry {
+    std::string key;
+    std::string value;
+    // The batch and the index in the batch of the entry, or -1 if the filter
+    // does not run on it.
+    int batch = -1;
+    size_t index = 0;
+  };
+
+  struct Batch {
+    std::vector<CompactionFilter::BatchEntry> entries;
+    uint64_t filter_nanos = 0;
+  };
+
+  struct Window {
+    Window() : cv(&mu) {}
+
+    std::vector<Entry> entries;
+    std::vector<Batch> batches;
+    // Number of batches still being filtered on the thread pool.
+    port::Mutex mu;
+    port::CondVar cv;
+    size_t pending = 0;
+  };
+
+  // Reads the next window from the input and starts filtering it.
+  std::unique_ptr<Window> ReadWindow();
+  // Reads the window to consume and the one to filter ahead of it from the
+  // current position of the input.
+  void ReadWindows();
+  void FilterBatch(Window* window, size_t batch);
+  static void WaitForWindow(Window* window);
+  // Drops the windows read ahead, for seeking the input.
+  void Reset();
+
+  InternalIterator* const input_;
+  const CompactionFilter* const filter_;
+  const int level_;
+  const Comparator* const ucmp_;
+  const size_t batch_size_;
+  const int num_threads_;
+  Env* const env_;
+  const bool report_detailed_time_;
+  std::unique_ptr<ThreadPool> thread_pool_;
+
+  // The window being consumed and the one being filtered ahead of it.
+  std::unique_ptr<Window> cur_;
+  std::unique_ptr<Window> next_;
+  size_t pos_ = 0;
+  // The user key of the last entry read from the input, to tell the first
+  // entry of each user key.
+  std::string last_user_key_;
+  bool has_last_user_key_ = false;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -970,7 +970,7 @@ TEST_F(DBBasicTest, ChecksumTest) {
   BlockBasedTableOptions table_options;
   Options options = CurrentOptions();
   // change when new checksum type added
-  int max_checksum = static_cast<int>(kxxHash64);
+  int max_checksum = static_cast<int>(kXXH3);
   const int kNumPerFile = 2;
 
   // generate one table with each type of checksum
@@ -3480,6 +3480,19 @@ TEST_F(DBBasicTest, VerifyFileChecksums) {
   ASSERT_OK(Flush());
 
   ASSERT_OK(db_->VerifyFileChecksums(ReadOptions()));
+
+  // The file checksum is combined from block crc32c's when the block
+  // checksum type is kCRC32c, and computed over the data otherwise. Both
+  // must match a full re-read of the file.
+  for (ChecksumType type : {kNoChecksum, kxxHash, kXXH3, kCRC32c}) {
+    BlockBasedTableOptions table_options;
+    table_options.checksum = type;
+    options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+    Reopen(options);
+    ASSERT_OK(Put("c" + ToString(type), "value"));
+    ASSERT_OK(Flush());
+    ASSERT_OK(db_->VerifyFileChecksums(ReadOptions()));
+  }
 }
 #endif  // !ROCKSDB_LITE
 
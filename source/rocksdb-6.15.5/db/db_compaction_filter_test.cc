@@ -768,6 +768,50 @@ TEST_F(DBTestCompactionFilter, SkipUntil) {
   }
 }
 
+TEST_F(DBTestCompactionFilter, SkipUntilWithFilterBatch) {
+  Options options = CurrentOptions();
+  options.compaction_filter_factory = std::make_shared<SkipEvenFilterFactory>();
+  options.disable_auto_compactions = true;
+  options.create_if_missing = true;
+  // Batches are filtered on the compaction thread, as the counters of
+  // SkipEvenFilter are not thread-safe.
+  options.compaction_filter_batch_size = 4;
+  options.compaction_filter_batch_threads = 0;
+  DestroyAndReopen(options);
+
+  for (int table = 0; table < 4; ++table) {
+    for (int i = table * 6; i < 39 + table * 11; ++i) {
+      char key[100];
+      snprintf(key, sizeof(key), "%010d", table * 100 + i);
+      ASSERT_OK(Put(key, std::to_string(table * 1000 + i)));
+    }
+    ASSERT_OK(Flush());
+  }
+
+  cfilter_skips = 0;
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+  // Keys read ahead past a skip are filtered too, so there may be more skips
+  // than in SkipUntil.
+  ASSERT_GE(cfilter_skips, 11);
+
+  for (int table = 0; table < 4; ++table) {
+    for (int i = table * 6; i < 39 + table * 11; ++i) {
+      int k = table * 100 + i;
+      char key[100];
+      snprintf(key, sizeof(key), "%010d", table * 100 + i);
+      auto expected = std::to_string(table * 1000 + i);
+      std::string val;
+      Status s = db_->Get(ReadOptions(), key, &val);
+      if (k / 10 % 2 == 0) {
+        ASSERT_TRUE(s.IsNotFound());
+      } else {
+        ASSERT_OK(s);
+        ASSERT_EQ(expected, val);
+      }
+    }
+  }
+}
+
 TEST_F(DBTestCompactionFilter, SkipUntilWithBloomFilter) {
   BlockBasedTableOptions table_options;
   table_options.whole_key_filtering = false;
@@ -4305,6 +4305,200 @@ TEST_F(DBCompactionTest, LevelPeriodicCompactionWithCompactionFilters) {
   }
 }
 
+TEST_F(DBCompactionTest, ReadTriggeredCompaction) {
+  Options options = CurrentOptions();
+  options.disable_auto_compactions = true;
+  // A single sampled seek miss marks the file.
+  options.read_triggered_compaction_threshold = 1024;
+  // Without a filter, every lookup of a missing key searches the file.
+  BlockBasedTableOptions table_options;
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  DestroyAndReopen(options);
+
+  // Even keys in L2 and odd keys in L1 over the same range, so that looking
+  // up an even key searches the L1 file in vain first.
+  for (int i = 0; i < 100; i += 2) {
+    ASSERT_OK(Put(Key(i), "l2"));
+  }
+  ASSERT_OK(Flush());
+  MoveFilesToLevel(2);
+  for (int i = 1; i < 100; i += 2) {
+    ASSERT_OK(Put(Key(i), "l1"));
+  }
+  ASSERT_OK(Flush());
+  MoveFilesToLevel(1);
+  ASSERT_EQ("0,1,1", FilesPerLevel());
+
+  int read_triggered_compactions = 0;
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->SetCallBack(
+      "LevelCompactionPicker::PickCompaction:Return", [&](void* arg) {
+        Compaction* compaction = reinterpret_cast<Compaction*>(arg);
+        if (compaction->compaction_reason() ==
+            CompactionReason::kReadTriggered) {
+          read_triggered_compactions++;
+        }
+      });
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->EnableProcessing();
+  ASSERT_OK(dbfull()->SetOptions({{"disable_auto_compactions", "false"}}));
+
+  // Lookups are sampled at random, one in 1024; do enough of them that the L1
+  // file is all but certain to be charged.
+  for (int i = 0; i < 100 * 1024; i++) {
+    ASSERT_EQ("l2", Get(Key(2 + (i % 49) * 2)));
+  }
+  ASSERT_OK(dbfull()->TEST_WaitForCompact());
+  ASSERT_EQ(1, read_triggered_compactions);
+  ASSERT_EQ("0,0,1", FilesPerLevel());
+  for (int i = 0; i < 100; i++) {
+    ASSERT_EQ(i % 2 ? "l1" : "l2", Get(Key(i)));
+  }
+
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->DisableProcessing();
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->ClearAllCallBacks();
+}
+
+TEST_F(DBCompactionTest, TemperatureMigration) {
+  Options options = CurrentOptions();
+  env_->SetMockSleep();
+  options.env = env_;
+  // The paths are large enough for all levels, so only the temperature of
+  // the data moves files off the first path.
+  options.db_paths.emplace_back(dbname_, 1024 * 1024 * 1024);
+  options.db_paths.emplace_back(dbname_ + "_2", 1024 * 1024 * 1024);
+  options.db_paths.emplace_back(dbname_ + "_3", 1024 * 1024 * 1024);
+  options.cold_data_age_seconds = 24 * 60 * 60;
+  DestroyAndReopen(options);
+
+  int migrations = 0;
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->SetCallBack(
+      "LevelCompactionPicker::PickCompaction:Return", [&](void* arg) {
+        Compaction* compaction = reinterpret_cast<Compaction*>(arg);
+        if (compaction->compaction_reason() ==
+            CompactionReason::kTemperatureMigration) {
+          ASSERT_EQ(2, compaction->output_path_id());
+          migrations++;
+        }
+      });
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->EnableProcessing();
+
+  for (int i = 0; i < 2; i++) {
+    ASSERT_OK(Put(Key(i), "old"));
+    ASSERT_OK(Flush());
+  }
+  ASSERT_OK(dbfull()->TEST_WaitForCompact());
+  ASSERT_EQ(2, GetSstFileCount(dbname_));
+  ASSERT_EQ(0, migrations);
+
+  // The two files turn cold; the new one is not.
+  env_->MockSleepForSeconds(2 * 24 * 60 * 60);
+  ASSERT_OK(Put(Key(2), "new"));
+  ASSERT_OK(Flush());
+  ASSERT_OK(dbfull()->TEST_WaitForCompact());
+  ASSERT_EQ(2, migrations);
+  ASSERT_EQ("3", FilesPerLevel());
+  ASSERT_EQ(1, GetSstFileCount(dbname_));
+  ASSERT_EQ(0, GetSstFileCount(dbname_ + "_2"));
+  ASSERT_EQ(2, GetSstFileCount(dbname_ + "_3"));
+
+  ASSERT_EQ("old", Get(Key(0)));
+  ASSERT_EQ("new", Get(Key(2)));
+  ColumnFamilyHandleImpl* cfh =
+      static_cast<ColumnFamilyHandleImpl*>(dbfull()->DefaultColumnFamily());
+  InternalStats* internal_stats = cfh->cfd()->internal_stats();
+  InternalStats::PathIOStats fast = internal_stats->GetPathIOStats(0);
+  InternalStats::PathIOStats cold = internal_stats->GetPathIOStats(2);
+  ASSERT_GT(fast.user_reads, 0);
+  ASSERT_GT(fast.bytes_written, 0);
+  ASSERT_GT(fast.compaction_bytes_read, 0);
+  ASSERT_GT(cold.user_reads, 0);
+  ASSERT_GT(cold.bytes_written, 0);
+  ASSERT_EQ(0, cold.compaction_bytes_read);
+  std::string stats;
+  ASSERT_TRUE(db_->GetProperty("rocksdb.cfstats", &stats));
+  ASSERT_NE(std::string::npos, stats.find("File I/O By Path"));
+
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->DisableProcessing();
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->ClearAllCallBacks();
+}
+
+TEST_F(DBCompactionTest, PartialTrivialMove) {
+  Options options = CurrentOptions();
+  options.disable_auto_compactions = true;
+  options.allow_partial_trivial_move = true;
+  options.num_levels = 3;
+  options.compression = kNoCompression;
+  options.max_bytes_for_level_base = 1;
+  options.statistics = ROCKSDB_NAMESPACE::CreateDBStatistics();
+  BlockBasedTableOptions table_options;
+  table_options.block_size = 1024;
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  DestroyAndReopen(options);
+
+  // The L1 file only overlaps the L2 file with its first ten keys.
+  Random rnd(301);
+  std::vector<std::string> values(300);
+  for (int i = 0; i < 100; i++) {
+    values[i] = rnd.RandomString(100);
+    ASSERT_OK(Put(Key(i), values[i]));
+  }
+  ASSERT_OK(Flush());
+  MoveFilesToLevel(2);
+  for (int i = 90; i < 300; i++) {
+    values[i] = rnd.RandomString(100);
+    ASSERT_OK(Put(Key(i), values[i]));
+  }
+  ASSERT_OK(Flush());
+  MoveFilesToLevel(1);
+  ASSERT_EQ("0,1,1", FilesPerLevel());
+  std::vector<LiveFileMetaData> files;
+  db_->GetLiveFilesMetaData(&files);
+  uint64_t l1_file_size = 0;
+  for (const auto& file : files) {
+    if (file.level == 1) {
+      l1_file_size = file.size;
+    }
+  }
+
+  int partial_trivial_moves = 0;
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->SetCallBack(
+      "DBImpl::BackgroundCompaction:PartialTrivialMove",
+      [&](void* /*arg*/) { partial_trivial_moves++; });
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->EnableProcessing();
+  ASSERT_OK(dbfull()->SetOptions({{"disable_auto_compactions", "false"}}));
+  ASSERT_OK(dbfull()->TEST_WaitForCompact());
+
+  // Keys 100 to 299 were moved to L2, and only the first ten keys of the L1
+  // file were compacted with the L2 file.
+  ASSERT_EQ(1, partial_trivial_moves);
+  ASSERT_EQ("0,0,2", FilesPerLevel());
+  ASSERT_LT(TestGetTickerCount(options, COMPACT_WRITE_BYTES), l1_file_size);
+
+  for (int reopen = 0; reopen < 2; reopen++) {
+    for (int i = 0; i < 300; i++) {
+      ASSERT_EQ(values[i], Get(Key(i)));
+    }
+    std::unique_ptr<Iterator> iter(db_->NewIterator(ReadOptions()));
+    int count = 0;
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next(), count++) {
+      ASSERT_EQ(Key(count), iter->key().ToString());
+      ASSERT_EQ(values[count], iter->value().ToString());
+    }
+    ASSERT_OK(iter->status());
+    ASSERT_EQ(300, count);
+    iter->SeekForPrev(Key(99));
+    ASSERT_TRUE(iter->Valid());
+    ASSERT_EQ(Key(99), iter->key().ToString());
+    iter->Next();
+    ASSERT_TRUE(iter->Valid());
+    ASSERT_EQ(Key(100), iter->key().ToString());
+    iter.reset();
+    Reopen(options);
+  }
+
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->DisableProcessing();
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->ClearAllCallBacks();
+}
+
 TEST_F(DBCompactionTest, CompactRangeDelayedByL0FileCount) {
   // Verify that, when `CompactRangeOptions::allow_write_stall == false`, manual
   // compaction only triggers flush after it's sure stall won't be triggered for
@@ -5925,6 +6119,245 @@ TEST_F(DBCompactionTest, CompactionWithBlob) {
   ASSERT_EQ(compaction_stats[1].num_output_files, 2);
 }
 
+TEST_F(DBCompactionTest, CompactionBlobGarbageAccounting) {
+  Options options;
+  options.env = env_;
+  options.disable_auto_compactions = true;
+  options.enable_blob_files = true;
+  options.min_blob_size = 0;
+
+  Reopen(options);
+
+  constexpr char first_key[] = "first_key";
+  constexpr char second_key[] = "second_key";
+  constexpr char third_key[] = "third_key";
+  constexpr char first_value[] = "first_value";
+  constexpr char second_value[] = "second_value";
+
+  ASSERT_OK(Put(first_key, first_value));
+  ASSERT_OK(Put(second_key, first_value));
+  ASSERT_OK(Flush());
+
+  // Also write a key past second_key so that the two L0 files overlap and
+  // the compaction is not a trivial move.
+  ASSERT_OK(Put(first_key, second_value));
+  ASSERT_OK(Put(third_key, second_value));
+  ASSERT_OK(Flush());
+
+  constexpr Slice* begin = nullptr;
+  constexpr Slice* end = nullptr;
+
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), begin, end));
+
+  ASSERT_EQ(Get(first_key), second_value);
+  ASSERT_EQ(Get(second_key), first_value);
+  ASSERT_EQ(Get(third_key), second_value);
+
+  VersionSet* const versions = dbfull()->TEST_GetVersionSet();
+  assert(versions);
+
+  ColumnFamilyData* const cfd = versions->GetColumnFamilySet()->GetDefault();
+  assert(cfd);
+
+  Version* const current = cfd->current();
+  assert(current);
+
+  const VersionStorageInfo* const storage_info = current->storage_info();
+  assert(storage_info);
+
+  // The first blob file now contains one garbage blob (the overwritten value
+  // of first_key); the second one has no garbage.
+  const auto& blob_files = storage_info->GetBlobFiles();
+  ASSERT_EQ(blob_files.size(), 2);
+
+  const auto& oldest_blob_file = blob_files.begin()->second;
+  assert(oldest_blob_file);
+
+  ASSERT_EQ(oldest_blob_file->GetTotalBlobCount(), 2);
+  ASSERT_EQ(oldest_blob_file->GetGarbageBlobCount(), 1);
+
+  const auto& newest_blob_file = blob_files.rbegin()->second;
+  assert(newest_blob_file);
+
+  ASSERT_EQ(newest_blob_file->GetTotalBlobCount(), 2);
+  ASSERT_EQ(newest_blob_file->GetGarbageBlobCount(), 0);
+}
+
+TEST_F(DBCompactionTest, CompactionBlobGarbageCollection) {
+  Options options;
+  options.env = env_;
+  options.disable_auto_compactions = true;
+  options.enable_blob_files = true;
+  options.min_blob_size = 0;
+  options.enable_blob_garbage_collection = true;
+  options.blob_garbage_collection_age_cutoff = 1.0;
+
+  Reopen(options);
+
+  constexpr char first_key[] = "first_key";
+  constexpr char second_key[] = "second_key";
+  constexpr char third_key[] = "third_key";
+  constexpr char first_value[] = "first_value";
+  constexpr char second_value[] = "second_value";
+
+  ASSERT_OK(Put(first_key, first_value));
+  ASSERT_OK(Put(second_key, first_value));
+  ASSERT_OK(Flush());
+
+  // Also write a key past second_key so that the two L0 files overlap and
+  // the compaction is not a trivial move.
+  ASSERT_OK(Put(first_key, second_value));
+  ASSERT_OK(Put(third_key, second_value));
+  ASSERT_OK(Flush());
+
+  VersionSet* const versions = dbfull()->TEST_GetVersionSet();
+  assert(versions);
+
+  ColumnFamilyData* const cfd = versions->GetColumnFamilySet()->GetDefault();
+  assert(cfd);
+
+  uint64_t newest_original_blob_file_number = kInvalidBlobFileNumber;
+
+  {
+    const auto& blob_files = cfd->current()->storage_info()->GetBlobFiles();
+    ASSERT_EQ(blob_files.size(), 2);
+
+    newest_original_blob_file_number = blob_files.rbegin()->first;
+  }
+
+  constexpr Slice* begin = nullptr;
+  constexpr Slice* end = nullptr;
+
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), begin, end));
+
+  ASSERT_EQ(Get(first_key), second_value);
+  ASSERT_EQ(Get(second_key), first_value);
+  ASSERT_EQ(Get(third_key), second_value);
+
+  // All valid blobs got relocated to a new blob file, and the original blob
+  // files, which now consist entirely of garbage, got dropped.
+  const auto& blob_files = cfd->current()->storage_info()->GetBlobFiles();
+  ASSERT_EQ(blob_files.size(), 1);
+
+  const auto& blob_file = blob_files.begin()->second;
+  assert(blob_file);
+
+  ASSERT_GT(blob_file->GetBlobFileNumber(), newest_original_blob_file_number);
+  ASSERT_EQ(blob_file->GetTotalBlobCount(), 3);
+  ASSERT_EQ(blob_file->GetGarbageBlobCount(), 0);
+}
+
+TEST_F(DBCompactionTest, SubcompactionBoundariesFromKeyAnchors) {
+  Options options = CurrentOptions();
+  options.disable_auto_compactions = true;
+  options.compression = kNoCompression;
+  options.target_file_size_base = 64 << 10;
+  options.max_subcompactions = 4;
+  options.statistics = CreateDBStatistics();
+  DestroyAndReopen(options);
+
+  const int kNumKeys = 1000;
+  Random rnd(301);
+  for (int i = 0; i < kNumKeys; i++) {
+    ASSERT_OK(Put(Key(i), rnd.RandomString(1000)));
+  }
+  ASSERT_OK(Flush());
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+  ASSERT_EQ(0, NumTableFilesAtLevel(0));
+
+  // Two L0 files spanning the whole key space; neither has a file boundary
+  // that could be used to split the compaction.
+  std::vector<std::string> values(kNumKeys);
+  for (int parity = 0; parity < 2; parity++) {
+    for (int i = parity; i < kNumKeys; i += 2) {
+      values[i] = rnd.RandomString(1000);
+      ASSERT_OK(Put(Key(i), values[i]));
+    }
+    ASSERT_OK(Flush());
+  }
+  ASSERT_EQ(2, NumTableFilesAtLevel(0));
+
+  ASSERT_OK(options.statistics->Reset());
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+  HistogramData num_subcompactions;
+  options.statistics->histogramData(NUM_SUBCOMPACTIONS_SCHEDULED,
+                                    &num_subcompactions);
+  ASSERT_EQ(4, num_subcompactions.max);
+
+  for (int i = 0; i < kNumKeys; i++) {
+    ASSERT_EQ(values[i], Get(Key(i)));
+  }
+}
+
+TEST_F(DBCompactionTest, SubcompactionWorkStealing) {
+  // Makes the first quarter of the key space slow to compact
+  class SlowCompactionFilter : public CompactionFilter {
+   public:
+    bool Filter(int /*level*/, const Slice& key,
+                const Slice& /*existing_value*/, std::string* /*new_value*/,
+                bool* /*value_changed*/) const override {
+      if (key.compare(Key(250)) < 0) {
+        Env::Default()->SleepForMicroseconds(1000);
+      }
+      return false;
+    }
+    const char* Name() const override { return "SlowCompactionFilter"; }
+  };
+  SlowCompactionFilter filter;
+
+  Options options = CurrentOptions();
+  options.disable_auto_compactions = true;
+  options.compression = kNoCompression;
+  options.target_file_size_base = 64 << 10;
+  options.max_subcompactions = 4;
+  DestroyAndReopen(options);
+
+  const int kNumKeys = 1000;
+  Random rnd(301);
+  for (int i = 0; i < kNumKeys; i++) {
+    ASSERT_OK(Put(Key(i), rnd.RandomString(1000)));
+  }
+  ASSERT_OK(Flush());
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+
+  options.compaction_filter = &filter;
+  Reopen(options);
+  std::vector<std::string> values(kNumKeys);
+  for (int parity = 0; parity < 2; parity++) {
+    for (int i = parity; i < kNumKeys; i += 2) {
+      values[i] = rnd.RandomString(1000);
+      ASSERT_OK(Put(Key(i), values[i]));
+    }
+    ASSERT_OK(Flush());
+  }
+
+  std::atomic<int> num_splits(0);
+  SyncPoint::GetInstance()->SetCallBack(
+      "CompactionJob::MaybeSplitSubcompaction:Split",
+      [&](void* /*arg*/) { num_splits++; });
+  SyncPoint::GetInstance()->EnableProcessing();
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+  SyncPoint::GetInstance()->DisableProcessing();
+  SyncPoint::GetInstance()->ClearAllCallBacks();
+  ASSERT_GE(num_splits.load(), 1);
+
+  // The outputs of the split subcompactions do not overlap
+  std::vector<LiveFileMetaData> metadata;
+  db_->GetLiveFilesMetaData(&metadata);
+  std::sort(metadata.begin(), metadata.end(),
+            [](const LiveFileMetaData& a, const LiveFileMetaData& b) {
+              return a.smallestkey < b.smallestkey;
+            });
+  for (size_t i = 1; i < metadata.size(); i++) {
+    ASSERT_EQ(1, metadata[i].level);
+    ASSERT_LT(metadata[i - 1].largestkey, metadata[i].smallestkey);
+  }
+
+  for (int i = 0; i < kNumKeys; i++) {
+    ASSERT_EQ(values[i], Get(Key(i)));
+  }
+}
+
 class DBCompactionTestBlobError
     : public DBCompactionTest,
       public testing::WithParamInterface<std::string> {
@@ -181,6 +181,17 @@ DBImpl::DBImpl(const DBOptions& options, const std::string& dbname,
       write_thread_(immutable_db_options_),
       nonmem_write_thread_(immutable_db_options_),
       write_controller_(mutable_db_options_.delayed_write_rate),
+      latency_slo_controller_(
+          immutable_db_options_.get_latency_slo_micros > 0 ||
+                  immutable_db_options_.write_latency_slo_micros > 0
+              ? new LatencySloController(
+                    immutable_db_options_.get_latency_slo_micros,
+                    immutable_db_options_.write_latency_slo_micros,
+                    immutable_db_options_.rate_limiter
+                        ? immutable_db_options_.rate_limiter
+                              ->GetBytesPerSecond()
+                        : 0)
+              : nullptr),
       last_batch_group_size_(0),
       unscheduled_flushes_(0),
       unscheduled_compactions_(0),
@@ -190,6 +201,8 @@ DBImpl::DBImpl(const DBOptions& options, const std::string& dbname,
       bg_flush_scheduled_(0),
       num_running_flushes_(0),
       bg_purge_scheduled_(0),
+      next_table_warming_file_(0),
+      num_table_warming_threads_running_(0),
       disable_delete_obsolete_files_(0),
       pending_purge_obsolete_files_(0),
       delete_obsolete_files_last_run_(env_->NowMicros()),
@@ -502,6 +515,7 @@ Status DBImpl::CloseHelper() {
   // marker. After this we do a variant of the waiting and unschedule work
   // (to consider: moving all the waiting into CancelAllBackgroundWork(true))
   CancelAllBackgroundWork(false);
+  WaitForTableCacheWarming();
   int bottom_compactions_unscheduled =
       env_->UnSchedule(this, Env::Priority::BOTTOM);
   int compactions_unscheduled = env_->UnSchedule(this, Env::Priority::LOW);
@@ -699,7 +713,8 @@ void DBImpl::StartPeriodicWorkScheduler() {
 
   periodic_work_scheduler_->Register(
       this, mutable_db_options_.stats_dump_period_sec,
-      mutable_db_options_.stats_persist_period_sec);
+      mutable_db_options_.stats_persist_period_sec,
+      latency_slo_controller_ != nullptr);
 #endif  // !ROCKSDB_LITE
 }
 
@@ -923,6 +938,83 @@ void DBImpl::FlushInfoLog() {
   LogFlush(immutable_db_options_.info_log);
 }
 
+void DBImpl::AdjustForLatencySlo() {
+  if (shutdown_initiated_ || latency_slo_controller_ == nullptr) {
+    return;
+  }
+  TEST_SYNC_POINT("DBImpl::AdjustForLatencySlo:StartRunning");
+  std::vector<uint64_t> get_counts;
+  std::vector<uint64_t> write_counts;
+  Statistics* statistics = immutable_db_options_.statistics.get();
+  if (statistics != nullptr &&
+      (!statistics->getHistogramBucketCounts(DB_GET, &get_counts) ||
+       !statistics->getHistogramBucketCounts(DB_WRITE, &write_counts))) {
+    get_counts.clear();
+    write_counts.clear();
+  }
+
+  InstrumentedMutexLock l(&mutex_);
+  // Compactions must not be held back while writes are close to being
+  // stalled on them, so look out for stalls before they set in.
+  bool stall_risk = write_controller_.IsStopped() ||
+                    write_controller_.NeedsDelay() ||
+                    write_controller_.NeedSpeedupCompaction();
+  for (auto cfd : *versions_->GetColumnFamilySet()) {
+    if (stall_risk) {
+      break;
+    }
+    if (cfd->IsDropped() || !cfd->initialized()) {
+      continue;
+    }
+    const MutableCFOptions* mutable_cf_options =
+        cfd->GetLatestMutableCFOptions();
+    const VersionStorageInfo* vstorage = cfd->current()->storage_info();
+    int l0_risk_trigger =
+        (mutable_cf_options->level0_file_num_compaction_trigger +
+         mutable_cf_options->level0_slowdown_writes_trigger) /
+        2;
+    uint64_t pending_risk_bytes =
+        mutable_cf_options->soft_pending_compaction_bytes_limit / 2;
+    if ((l0_risk_trigger > 0 &&
+         vstorage->l0_delay_trigger_count() >= l0_risk_trigger) ||
+        (pending_risk_bytes > 0 &&
+         vstorage->estimated_compaction_needed_bytes() >= pending_risk_bytes)) {
+      stall_risk = true;
+    }
+  }
+
+  BGJobLimits bg_job_limits =
+      GetBGJobLimits(mutable_db_options_.max_background_flushes,
+                     mutable_db_options_.max_background_compactions,
+                     mutable_db_options_.max_background_jobs,
+                     true /* parallelize_compactions */);
+  bool changed = latency_slo_controller_->Step(
+      get_counts, write_counts, stall_risk, bg_job_limits.max_compactions,
+      mutable_db_options_.max_subcompactions);
+  TEST_SYNC_POINT_CALLBACK("DBImpl::AdjustForLatencySlo:AfterStep",
+                           latency_slo_controller_.get());
+  if (!changed) {
+    return;
+  }
+  if (immutable_db_options_.rate_limiter != nullptr &&
+      latency_slo_controller_->bytes_per_sec() > 0) {
+    immutable_db_options_.rate_limiter->SetBytesPerSecond(
+        latency_slo_controller_->bytes_per_sec());
+  }
+  ROCKS_LOG_INFO(immutable_db_options_.info_log,
+                 "Latency SLO: get p99 %.1f us, write p99 %.1f us%s, giving "
+                 "compactions %.0f%% of their resources: %" PRId64
+                 " bytes/s, %d compactions, %" PRIu32 " subcompactions",
+                 latency_slo_controller_->get_p99(),
+                 latency_slo_controller_->write_p99(),
+                 stall_risk ? ", writes close to stalling" : "",
+                 latency_slo_controller_->share() * 100,
+                 latency_slo_controller_->bytes_per_sec(),
+                 latency_slo_controller_->max_compactions(),
+                 latency_slo_controller_->max_subcompactions());
+  MaybeScheduleFlushOrCompaction();
+}
+
 Status DBImpl::TablesRangeTombstoneSummary(ColumnFamilyHandle* column_family,
                                            int max_entries_to_print,
                                            std::string* out_str) {
@@ -1103,7 +1195,8 @@ Status DBImpl::SetDBOptions(
         periodic_work_scheduler_->Unregister(this);
         periodic_work_scheduler_->Register(
             this, new_options.stats_dump_period_sec,
-            new_options.stats_persist_period_sec);
+            new_options.stats_persist_period_sec,
+            latency_slo_controller_ != nullptr);
         mutex_.Lock();
       }
       write_controller_.set_max_delayed_write_rate(
@@ -1766,6 +1859,9 @@ Status DBImpl::GetImpl(const ReadOptions& read_options, const Slice& key,
         get_impl_options.get_value ? get_impl_options.is_blob_index : nullptr,
         get_impl_options.get_value);
     RecordTick(stats_, MEMTABLE_MISS);
+    if (sv->current->TakeReadTriggeredCompactionHint()) {
+      MaybeScheduleReadTriggeredCompaction(cfd);
+    }
   }
 
   {
@@ -29,6 +29,7 @@
 #include "db/flush_scheduler.h"
 #include "db/import_column_family_job.h"
 #include "db/internal_stats.h"
+#include "db/latency_slo_controller.h"
 #include "db/log_writer.h"
 #include "db/logs_with_prep_tracker.h"
 #include "db/memtable_list.h"
@@ -1014,6 +1015,7 @@ class DBImpl : public DB {
   size_t TEST_GetWalPreallocateBlockSize(uint64_t write_buffer_size) const;
   void TEST_WaitForStatsDumpRun(std::function<void()> callback) const;
   size_t TEST_EstimateInMemoryStatsHistorySize() const;
+  void TEST_WaitForTableCacheWarming() { WaitForTableCacheWarming(); }
 
   VersionSet* TEST_GetVersionSet() const { return versions_.get(); }
 
@@ -1036,6 +1038,10 @@ class DBImpl : public DB {
   // flush LOG out of application buffer
   void FlushInfoLog();
 
+  // adjust the resources of compactions to the latency SLOs, see
+  // DBOptions::get_latency_slo_micros
+  void AdjustForLatencySlo();
+
  protected:
   const std::string dbname_;
   std::string db_id_;
@@ -1254,6 +1260,7 @@ class DBImpl : public DB {
 #endif
   friend struct SuperVersion;
   friend class CompactedDBImpl;
+  friend class DBImplSecondary;
   friend class DBTest_ConcurrentFlushWAL_Test;
   friend class DBTest_MixedSlowdownOptionsStop_Test;
   friend class DBCompactionTest_CompactBottomLevelFilesWithDeletions_Test;
@@ -1650,6 +1657,9 @@ class DBImpl : public DB {
   void SchedulePendingFlush(const FlushRequest& req, FlushReason flush_reason);
 
   void SchedulePendingCompaction(ColumnFamilyData* cfd);
+  // Called without the DB mutex after a Get() pushed a file of `cfd` over
+  // read_triggered_compaction_threshold.
+  void MaybeScheduleReadTriggeredCompaction(ColumnFamilyData* cfd);
   void SchedulePendingPurge(std::string fname, std::string dir_to_sync,
                             FileType type, uint64_t number, int job_id);
   static void BGWorkCompaction(void* arg);
@@ -1672,6 +1682,16 @@ class DBImpl : public DB {
                          LogBuffer* log_buffer, FlushReason* reason,
                          Env::Priority thread_pri);
 
+  // Carries out `c` by hard-linking its start level input file into pieces
+  // that each only own a key range of it, moving the pieces that do not
+  // overlap the output level there and leaving the overlapping one behind.
+  // Returns false without changing the LSM tree if the file cannot or should
+  // not be split, in which case `c` has to be run as a regular compaction.
+  // REQUIRES: mutex held, c->CanSplitForTrivialMove()
+  bool PartialTrivialMove(Compaction* c, JobContext* job_context,
+                          LogBuffer* log_buffer, Status* status,
+                          IOStatus* io_s);
+
   bool EnoughRoomForCompaction(ColumnFamilyData* cfd,
                                const std::vector<CompactionInputFiles>& inputs,
                                bool* sfm_bookkeeping, LogBuffer* log_buffer);
@@ -1685,6 +1705,17 @@ class DBImpl : public DB {
   // Schedule background tasks
   void StartPeriodicWorkScheduler();
 
+  // With DBOptions::lazy_table_open, starts max_file_opening_threads threads
+  // opening the table files of the current versions into the table cache,
+  // level by level. The versions and column families are referenced until
+  // the threads are done.
+  void StartTableCacheWarming();
+  // The body of a table cache warming thread.
+  void WarmTableCache();
+  // Waits for the table cache warming threads, which stop early once
+  // shutting_down_ is set.
+  void WaitForTableCacheWarming();
+
   void PrintStatistics();
 
   size_t EstimateInMemoryStatsHistorySize() const;
@@ -1973,6 +2004,10 @@ class DBImpl : public DB {
 
   WriteController write_controller_;
 
+  // Decides how much of the background resources compactions get in order to
+  // meet the latency SLOs; nullptr if there are none. Protected by mutex_.
+  std::unique_ptr<LatencySloController> latency_slo_controller_;
+
   // Size of the last batch group. In slowdown mode, next write needs to
   // sleep if it uses up the quota.
   // Note: This is to protect memtable and compaction. If the batch only writes
@@ -2053,6 +2088,25 @@ class DBImpl : public DB {
   // number of background obsolete file purge jobs, submitted to the HIGH pool
   int bg_purge_scheduled_;
 
+  // A table file to open by table cache warming, see
+  // StartTableCacheWarming().
+  struct TableWarmingFile {
+    ColumnFamilyData* cfd;
+    FileMetaData* file_meta;
+    int level;
+    std::shared_ptr<const SliceTransform> prefix_extractor;
+    size_t max_file_size_for_l0_meta_pin;
+  };
+  // Set before the warming threads start, and left alone until they are
+  // joined.
+  std::vector<TableWarmingFile> table_warming_files_;
+  std::atomic<size_t> next_table_warming_file_;
+  std::vector<port::Thread> table_warming_threads_;
+  // The versions referenced for table_warming_files_, released by the last
+  // warming thread to finish. Protected by mutex_.
+  std::vector<Version*> table_warming_versions_;
+  int num_table_warming_threads_running_;
+
   std::deque<ManualCompactionState*> manual_compaction_dequeue_;
 
   // shall we disable deletion of obsolete files
@@ -2144,7 +2198,8 @@ class DBImpl : public DB {
   std::unique_ptr<PreReleaseCallback> recoverable_state_pre_release_callback_;
 
 #ifndef ROCKSDB_LITE
-  // Scheduler to run DumpStats(), PersistStats(), and FlushInfoLog().
+  // Scheduler to run DumpStats(), PersistStats(), FlushInfoLog(), and
+  // AdjustForLatencySlo().
   // Currently, it always use a global instance from
   // PeriodicWorkScheduler::Default(). Only in unittest, it can be overrided by
   // PeriodicWorkTestScheduler.
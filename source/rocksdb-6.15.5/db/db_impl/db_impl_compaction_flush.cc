@@ -1432,7 +1432,8 @@ Status DBImpl::ReFitLevel(ColumnFamilyData* cfd, int level, int target_level) {
                    f->fd.smallest_seqno, f->fd.largest_seqno,
                    f->marked_for_compaction, f->oldest_blob_file_number,
                    f->oldest_ancester_time, f->file_creation_time,
-                   f->file_checksum, f->file_checksum_func_name);
+                   f->file_checksum, f->file_checksum_func_name,
+                   f->virtual_range_size);
     }
     ROCKS_LOG_DEBUG(immutable_db_options_.info_log,
                     "[%s] Apply version edit:\n%s", cfd->GetName().c_str(),
@@ -2175,10 +2176,17 @@ void DBImpl::MaybeScheduleFlushOrCompaction() {
 
 DBImpl::BGJobLimits DBImpl::GetBGJobLimits() const {
   mutex_.AssertHeld();
-  return GetBGJobLimits(mutable_db_options_.max_background_flushes,
-                        mutable_db_options_.max_background_compactions,
-                        mutable_db_options_.max_background_jobs,
-                        write_controller_.NeedSpeedupCompaction());
+  BGJobLimits res =
+      GetBGJobLimits(mutable_db_options_.max_background_flushes,
+                     mutable_db_options_.max_background_compactions,
+                     mutable_db_options_.max_background_jobs,
+                     write_controller_.NeedSpeedupCompaction());
+  if (latency_slo_controller_ != nullptr &&
+      latency_slo_controller_->max_compactions() > 0) {
+    res.max_compactions = std::min(res.max_compactions,
+                                   latency_slo_controller_->max_compactions());
+  }
+  return res;
 }
 
 DBImpl::BGJobLimits DBImpl::GetBGJobLimits(int max_background_flushes,
@@ -2275,6 +2283,20 @@ void DBImpl::SchedulePendingCompaction(ColumnFamilyData* cfd) {
   }
 }
 
+void DBImpl::MaybeScheduleReadTriggeredCompaction(ColumnFamilyData* cfd) {
+  InstrumentedMutexLock l(&mutex_);
+  if (cfd->IsDropped()) {
+    return;
+  }
+  // The seek miss counters live in FileMetaData, which is shared between
+  // versions, so the marked files are recomputed on the current version
+  // rather than on the one the lookup used.
+  cfd->current()->storage_info()->ComputeFilesMarkedForReadTriggeredCompaction(
+      cfd->GetLatestMutableCFOptions()->read_triggered_compaction_threshold);
+  SchedulePendingCompaction(cfd);
+  MaybeScheduleFlushOrCompaction();
+}
+
 void DBImpl::SchedulePendingPurge(std::string fname, std::string dir_to_sync,
                                   FileType type, uint64_t number, int job_id) {
   mutex_.AssertHeld();
@@ -2762,7 +2784,18 @@ Status DBImpl::BackgroundCompaction(bool* made_progress,
       // compaction is not necessary. Need to make sure mutex is held
       // until we make a copy in the following code
       TEST_SYNC_POINT("DBImpl::BackgroundCompaction():BeforePickCompaction");
-      c.reset(cfd->PickCompaction(*mutable_cf_options, mutable_db_options_,
+      const MutableDBOptions* mutable_db_options = &mutable_db_options_;
+      MutableDBOptions slo_mutable_db_options;
+      if (latency_slo_controller_ != nullptr &&
+          latency_slo_controller_->max_subcompactions() > 0 &&
+          latency_slo_controller_->max_subcompactions() <
+              mutable_db_options_.max_subcompactions) {
+        slo_mutable_db_options = mutable_db_options_;
+        slo_mutable_db_options.max_subcompactions =
+            latency_slo_controller_->max_subcompactions();
+        mutable_db_options = &slo_mutable_db_options;
+      }
+      c.reset(cfd->PickCompaction(*mutable_cf_options, *mutable_db_options,
                                   log_buffer));
       TEST_SYNC_POINT("DBImpl::BackgroundCompaction():AfterPickCompaction");
 
@@ -2879,7 +2912,7 @@ Status DBImpl::BackgroundCompaction(bool* made_progress,
                            f->fd.largest_seqno, f->marked_for_compaction,
                            f->oldest_blob_file_number, f->oldest_ancester_time,
                            f->file_creation_time, f->file_checksum,
-                           f->file_checksum_func_name);
+                           f->file_checksum_func_name, f->virtual_range_size);
 
         ROCKS_LOG_BUFFER(
             log_buffer,
@@ -2922,6 +2955,11 @@ Status DBImpl::BackgroundCompaction(bool* made_progress,
     ThreadStatusUtil::ResetThreadStatus();
     TEST_SYNC_POINT_CALLBACK("DBImpl::BackgroundCompaction:AfterCompaction",
                              c->column_family_data());
+  } else if (c->CanSplitForTrivialMove() &&
+             PartialTrivialMove(c.get(), job_context, log_buffer, &status,
+                                &io_s)) {
+    TEST_SYNC_POINT("DBImpl::BackgroundCompaction:PartialTrivialMove");
+    *made_progress = true;
   } else if (!is_prepicked && c->output_level() > 0 &&
              c->output_level() ==
                  c->column_family_data()
@@ -3100,6 +3138,231 @@ Status DBImpl::BackgroundCompaction(bool* made_progress,
   return status;
 }
 
+bool DBImpl::PartialTrivialMove(Compaction* c, JobContext* job_context,
+                                LogBuffer* log_buffer, Status* status,
+                                IOStatus* io_s) {
+  mutex_.AssertHeld();
+  assert(c->CanSplitForTrivialMove());
+  ColumnFamilyData* cfd = c->column_family_data();
+  const InternalKeyComparator& icmp = cfd->internal_comparator();
+  const Comparator* ucmp = icmp.user_comparator();
+  const SliceTransform* prefix_extractor =
+      c->mutable_cf_options()->prefix_extractor.get();
+  const FileMetaData* f = c->input(0, 0);
+  // The output level inputs are all the files of the output level that
+  // overlap f, so the parts of f before `lo` and after `hi` do not overlap
+  // the output level.
+  const Slice lo = c->input(1, 0)->smallest.user_key();
+  const Slice hi = c->input(1, c->num_input_files(1) - 1)->largest.user_key();
+  bool has_left = ucmp->Compare(f->smallest.user_key(), lo) < 0;
+  bool has_right = ucmp->Compare(f->largest.user_key(), hi) > 0;
+  if (!has_left && !has_right) {
+    return false;
+  }
+  // Numbers allocated after the pending outputs were captured are protected
+  // from being purged until the compaction finishes.
+  uint64_t left_number = versions_->NewFileNumber();
+  uint64_t middle_number = versions_->NewFileNumber();
+  uint64_t right_number = versions_->NewFileNumber();
+  mutex_.Unlock();
+
+  // Range tombstones could cover keys outside of the piece that holds them,
+  // so files that have any are always rewritten.
+  std::shared_ptr<const TableProperties> tp;
+  Status s = cfd->table_cache()->GetTableProperties(
+      file_options_for_compaction_, icmp, f->fd, &tp, prefix_extractor);
+  if (!s.ok() || tp == nullptr || tp->num_range_deletions > 0) {
+    mutex_.Lock();
+    return false;
+  }
+
+  // Find the pieces of f, split between user keys so that all the entries of
+  // a user key end up in the same piece.
+  InternalKey left_largest;
+  InternalKey middle_smallest;
+  InternalKey middle_largest;
+  InternalKey right_smallest;
+  bool has_middle = false;
+  {
+    ReadOptions read_options;
+    read_options.fill_cache = false;
+    read_options.total_order_seek = true;
+    std::unique_ptr<InternalIterator> iter(cfd->table_cache()->NewIterator(
+        read_options, file_options_for_compaction_, icmp, *f,
+        nullptr /* range_del_agg */, prefix_extractor,
+        nullptr /* table_reader_ptr */, nullptr /* file_read_hist */,
+        TableReaderCaller::kCompaction, nullptr /* arena */,
+        false /* skip_filters */, c->start_level(),
+        0 /* max_file_size_for_l0_meta_pin */,
+        nullptr /* smallest_compaction_key */,
+        nullptr /* largest_compaction_key */,
+        false /* allow_unprepared_value */));
+
+    InternalKey lo_seek_key(lo, kMaxSequenceNumber, kValueTypeForSeek);
+    iter->Seek(lo_seek_key.Encode());
+    if (iter->Valid() && ucmp->Compare(iter->user_key(), hi) <= 0) {
+      has_middle = true;
+      middle_smallest.DecodeFrom(iter->key());
+    }
+    if (has_left) {
+      if (iter->Valid()) {
+        iter->Prev();
+      } else {
+        iter->SeekToLast();
+      }
+      if (iter->Valid()) {
+        left_largest.DecodeFrom(iter->key());
+      } else {
+        has_left = false;
+      }
+    }
+
+    if (has_right) {
+      // Position at the first entry past the last user key of the output
+      // level inputs.
+      InternalKey hi_seek_key(hi, 0, static_cast<ValueType>(0));
+      iter->Seek(hi_seek_key.Encode());
+      while (iter->Valid() && ucmp->Compare(iter->user_key(), hi) == 0) {
+        iter->Next();
+      }
+      if (iter->Valid()) {
+        right_smallest.DecodeFrom(iter->key());
+        if (has_middle) {
+          iter->Prev();
+          assert(iter->Valid());
+          middle_largest.DecodeFrom(iter->key());
+        }
+      } else {
+        has_right = false;
+      }
+    }
+    if (has_middle && !has_right) {
+      middle_largest = f->largest;
+    }
+    s = iter->status();
+  }
+  if (!s.ok() || (!has_left && !has_right)) {
+    mutex_.Lock();
+    return false;
+  }
+
+  // Only split when the moved pieces save a sizable amount of rewriting.
+  uint64_t file_size = f->virtual_range_size > 0 ? f->virtual_range_size
+                                                 : f->fd.GetFileSize();
+  auto piece_size = [&](const InternalKey& smallest,
+                        const InternalKey& largest) {
+    return std::max<uint64_t>(
+        1, cfd->table_cache()->ApproximateSize(
+               smallest.Encode(), largest.Encode(), f->fd,
+               TableReaderCaller::kCompaction, icmp, prefix_extractor));
+  };
+  uint64_t left_size = has_left ? piece_size(f->smallest, left_largest) : 0;
+  uint64_t right_size = has_right ? piece_size(right_smallest, f->largest) : 0;
+  uint64_t middle_size =
+      has_middle ? piece_size(middle_smallest, middle_largest) : 0;
+  if ((left_size + right_size) * 4 < file_size) {
+    mutex_.Lock();
+    return false;
+  }
+
+  // Give every piece its own hard link, so that each one can be deleted
+  // independently once it is compacted.
+  const std::vector<DbPath>& cf_paths = cfd->ioptions()->cf_paths;
+  const uint32_t path_id = f->fd.GetPathId();
+  const std::string src =
+      TableFileName(cf_paths, f->fd.GetNumber(), path_id);
+  std::vector<std::string> links;
+  IOStatus link_s;
+  for (const auto& piece : {std::make_pair(has_left, left_number),
+                            std::make_pair(has_middle, middle_number),
+                            std::make_pair(has_right, right_number)}) {
+    if (!piece.first) {
+      continue;
+    }
+    std::string target = TableFileName(cf_paths, piece.second, path_id);
+    link_s = fs_->LinkFile(src, target, IOOptions(), nullptr /* dbg */);
+    if (!link_s.ok()) {
+      break;
+    }
+    links.push_back(target);
+  }
+  if (link_s.ok()) {
+    link_s = GetDataDir(cfd, path_id)->Fsync(IOOptions(), nullptr /* dbg */);
+  }
+  if (!link_s.ok()) {
+    ROCKS_LOG_BUFFER(log_buffer,
+                     "[%s] Cannot split #%" PRIu64 " for a trivial move: %s\n",
+                     cfd->GetName().c_str(), f->fd.GetNumber(),
+                     link_s.ToString().c_str());
+    for (const auto& link : links) {
+      fs_->DeleteFile(link, IOOptions(), nullptr /* dbg */)
+          .PermitUncheckedError();
+    }
+    mutex_.Lock();
+    return false;
+  }
+
+  mutex_.Lock();
+  TEST_SYNC_POINT_CALLBACK("DBImpl::BackgroundCompaction:BeforeCompaction",
+                           cfd);
+  CompactionJobStats compaction_job_stats;
+  compaction_job_stats.num_input_files = c->num_input_files(0);
+  NotifyOnCompactionBegin(cfd, c, *status, compaction_job_stats,
+                          job_context->job_id);
+
+  VersionEdit* edit = c->edit();
+  auto add_piece = [&](int level, uint64_t number, const InternalKey& smallest,
+                       const InternalKey& largest, uint64_t size) {
+    edit->AddFile(level, number, path_id, f->fd.GetFileSize(), smallest,
+                  largest, f->fd.smallest_seqno, f->fd.largest_seqno,
+                  f->marked_for_compaction, f->oldest_blob_file_number,
+                  f->oldest_ancester_time, f->file_creation_time,
+                  f->file_checksum, f->file_checksum_func_name, size);
+  };
+  edit->DeleteFile(c->start_level(), f->fd.GetNumber());
+  if (has_left) {
+    add_piece(c->output_level(), left_number, f->smallest, left_largest,
+              left_size);
+  }
+  if (has_middle) {
+    // The overlapping piece is left behind, and gets compacted on its own.
+    add_piece(c->start_level(), middle_number, middle_smallest,
+              middle_largest, middle_size);
+  }
+  if (has_right) {
+    add_piece(c->output_level(), right_number, right_smallest, f->largest,
+              right_size);
+  }
+
+  *status = versions_->LogAndApply(cfd, *c->mutable_cf_options(), edit,
+                                   &mutex_, directories_.GetDbDir());
+  *io_s = versions_->io_status();
+  InstallSuperVersionAndScheduleWork(cfd, &job_context->superversion_contexts[0],
+                                     *c->mutable_cf_options());
+
+  uint64_t moved_bytes = left_size + right_size;
+  cfd->internal_stats()->IncBytesMoved(c->output_level(), moved_bytes);
+  {
+    event_logger_.LogToBuffer(log_buffer)
+        << "job" << job_context->job_id << "event"
+        << "partial_trivial_move"
+        << "file" << f->fd.GetNumber() << "destination_level"
+        << c->output_level() << "moved_bytes" << moved_bytes
+        << "remaining_bytes" << middle_size;
+  }
+  VersionStorageInfo::LevelSummaryStorage tmp;
+  ROCKS_LOG_BUFFER(
+      log_buffer,
+      "[%s] Split #%" PRIu64 " to move %" PRIu64
+      " bytes to level-%d, %" PRIu64 " bytes left to compact %s: %s\n",
+      cfd->GetName().c_str(), f->fd.GetNumber(), moved_bytes,
+      c->output_level(), middle_size, status->ToString().c_str(),
+      cfd->current()->storage_info()->LevelSummary(&tmp));
+  TEST_SYNC_POINT_CALLBACK("DBImpl::BackgroundCompaction:AfterCompaction",
+                           cfd);
+  return true;
+}
+
 bool DBImpl::HasPendingManualCompaction() {
   return (!manual_compaction_dequeue_.empty());
 }
@@ -6,6 +6,7 @@
 // Copyright (c) 2011 The LevelDB Authors. All rights reserved.
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file. See the AUTHORS file for names of contributors.
+#include <algorithm>
 #include <cinttypes>
 
 #include "db/builder.h"
@@ -260,6 +261,14 @@ Status DBImpl::ValidateOptions(const DBOptions& db_options) {
         "atomic_flush is currently incompatible with best-efforts recovery");
   }
 
+  if ((db_options.get_latency_slo_micros > 0 ||
+       db_options.write_latency_slo_micros > 0) &&
+      db_options.statistics == nullptr) {
+    return Status::InvalidArgument(
+        "get_latency_slo_micros and write_latency_slo_micros require "
+        "statistics");
+  }
+
   return Status::OK();
 }
 
@@ -1411,6 +1420,114 @@ Status DBImpl::WriteLevel0TableForRecovery(int job_id, ColumnFamilyData* cfd,
   return s;
 }
 
+void DBImpl::StartTableCacheWarming() {
+  InstrumentedMutexLock l(&mutex_);
+  if (!immutable_db_options_.lazy_table_open ||
+      mutable_db_options_.max_open_files != -1) {
+    return;
+  }
+  assert(table_warming_threads_.empty());
+  assert(table_warming_files_.empty());
+  for (auto cfd : *versions_->GetColumnFamilySet()) {
+    if (cfd->IsDropped() || !cfd->initialized()) {
+      continue;
+    }
+    Version* current = cfd->current();
+    const VersionStorageInfo* vstorage = current->storage_info();
+    const MutableCFOptions* mutable_cf_options =
+        cfd->GetLatestMutableCFOptions();
+    const size_t num_files = table_warming_files_.size();
+    for (int level = 0; level < vstorage->num_levels(); level++) {
+      for (FileMetaData* f : vstorage->LevelFiles(level)) {
+        // Files added after the open already have their table loaded.
+        if (f->table_reader_handle == nullptr) {
+          table_warming_files_.push_back(
+              {cfd, f, level, mutable_cf_options->prefix_extractor,
+               MaxFileSizeForL0MetaPin(*mutable_cf_options)});
+        }
+      }
+    }
+    if (table_warming_files_.size() > num_files) {
+      cfd->Ref();
+      current->Ref();
+      table_warming_versions_.push_back(current);
+    }
+  }
+  if (table_warming_files_.empty()) {
+    return;
+  }
+  // Across column families, the lower levels are read most often.
+  std::stable_sort(
+      table_warming_files_.begin(), table_warming_files_.end(),
+      [](const TableWarmingFile& a, const TableWarmingFile& b) {
+        return a.level < b.level;
+      });
+  int num_threads = std::max(1, immutable_db_options_.max_file_opening_threads);
+  num_threads = static_cast<int>(
+      std::min(static_cast<size_t>(num_threads), table_warming_files_.size()));
+  ROCKS_LOG_INFO(immutable_db_options_.info_log,
+                 "Warming up the table cache with %" ROCKSDB_PRIszt
+                 " files on %d threads",
+                 table_warming_files_.size(), num_threads);
+  num_table_warming_threads_running_ = num_threads;
+  for (int i = 0; i < num_threads; i++) {
+    table_warming_threads_.emplace_back(&DBImpl::WarmTableCache, this);
+  }
+}
+
+void DBImpl::WarmTableCache() {
+  TEST_SYNC_POINT("DBImpl::WarmTableCache:Start");
+  while (!shutting_down_.load(std::memory_order_acquire)) {
+    size_t i = next_table_warming_file_.fetch_add(1, std::memory_order_relaxed);
+    if (i >= table_warming_files_.size()) {
+      break;
+    }
+    const TableWarmingFile& file = table_warming_files_[i];
+    ColumnFamilyData* cfd = file.cfd;
+    int level = file.level;
+    TEST_SYNC_POINT_CALLBACK("DBImpl::WarmTableCache:File", &level);
+    // Opening the table inserts it into the table cache, where it stays as
+    // the cache has no capacity limit with max_open_files == -1.
+    Cache::Handle* handle = nullptr;
+    Status s = cfd->table_cache()->FindTable(
+        ReadOptions(), file_options_, cfd->internal_comparator(),
+        file.file_meta->fd, &handle, file.prefix_extractor.get(),
+        false /* no_io */, true /* record_read_stats */,
+        cfd->internal_stats()->GetFileReadHist(file.level),
+        false /* skip_filters */, file.level,
+        true /* prefetch_index_and_filter_in_cache */,
+        file.max_file_size_for_l0_meta_pin);
+    if (handle != nullptr) {
+      cfd->table_cache()->ReleaseHandle(handle);
+    }
+    if (!s.ok()) {
+      ROCKS_LOG_WARN(immutable_db_options_.info_log,
+                     "[%s] Failed to open table file #%" PRIu64
+                     " while warming up the table cache: %s",
+                     cfd->GetName().c_str(), file.file_meta->fd.GetNumber(),
+                     s.ToString().c_str());
+    }
+  }
+
+  InstrumentedMutexLock l(&mutex_);
+  assert(num_table_warming_threads_running_ > 0);
+  if (--num_table_warming_threads_running_ == 0) {
+    for (Version* v : table_warming_versions_) {
+      ColumnFamilyData* cfd = v->cfd();
+      v->Unref();
+      cfd->UnrefAndTryDelete();
+    }
+    table_warming_versions_.clear();
+  }
+}
+
+void DBImpl::WaitForTableCacheWarming() {
+  for (auto& thread : table_warming_threads_) {
+    thread.join();
+  }
+  table_warming_threads_.clear();
+}
+
 Status DB::Open(const Options& options, const std::string& dbname, DB** dbptr) {
   DBOptions db_options(options);
   ColumnFamilyOptions cf_options(options);
@@ -1788,6 +1905,7 @@ Status DBImpl::Open(const DBOptions& db_options, const std::string& dbname,
   }
   if (s.ok()) {
     impl->StartPeriodicWorkScheduler();
+    impl->StartTableCacheWarming();
   } else {
     for (auto* h : *handles) {
       delete h;
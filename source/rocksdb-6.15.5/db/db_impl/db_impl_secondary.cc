@@ -9,8 +9,12 @@
 
 #include "db/arena_wrapped_db_iter.h"
 #include "db/merge_context.h"
+#include "file/filename.h"
 #include "logging/auto_roll_logger.h"
+#include "logging/logging.h"
 #include "monitoring/perf_context_imp.h"
+#include "rocksdb/convenience.h"
+#include "rocksdb/utilities/options_util.h"
 #include "util/cast_util.h"
 
 namespace ROCKSDB_NAMESPACE {
@@ -253,6 +257,7 @@ Status DBImplSecondary::RecoverLogFiles(
             MemTable* new_mem =
                 cfd->ConstructNewMemtable(mutable_cf_options, seq_of_batch);
             cfd->mem()->SetNextLogNumber(log_number);
+            cfd->mem()->ConstructFragmentedRangeTombstones();
             cfd->imm()->Add(cfd->mem(), &job_context->memtables_to_free);
             new_mem->Ref();
             cfd->SetMemtable(new_mem);
@@ -574,6 +579,93 @@ Status DBImplSecondary::TryCatchUpWithPrimary() {
   return s;
 }
 
+Status DBImplSecondary::CompactWithoutInstallation(
+    ColumnFamilyHandle* cfh, const std::string& output_path,
+    const CompactionServiceInput& input, CompactionServiceResult* result) {
+  assert(cfh != nullptr);
+  assert(result != nullptr);
+  InstrumentedMutexLock l(&mutex_);
+  auto cfd = static_cast_with_check<ColumnFamilyHandleImpl>(cfh)->cfd();
+  if (cfd == nullptr || cfd->IsDropped()) {
+    return Status::InvalidArgument("Cannot find column family",
+                                   input.cf_name);
+  }
+
+  std::unordered_set<uint64_t> input_set;
+  for (const auto& file_name : input.input_files) {
+    uint64_t number = 0;
+    FileType type;
+    if (!ParseFileName(file_name, &number, &type) || type != kTableFile) {
+      return Status::InvalidArgument("Invalid compaction input file",
+                                     file_name);
+    }
+    input_set.insert(number);
+  }
+
+  Version* version = cfd->current();
+  VersionStorageInfo* vstorage = version->storage_info();
+  const MutableCFOptions* mutable_cf_options = cfd->GetLatestMutableCFOptions();
+
+  // Let the worker pick compression and output file sizes the same way the
+  // primary would for the output level.
+  CompactionOptions comp_options;
+  comp_options.compression = kDisableCompressionOption;
+  comp_options.output_file_size_limit = MaxFileSizeForLevel(
+      *mutable_cf_options, input.output_level,
+      cfd->ioptions()->compaction_style, vstorage->base_level(),
+      cfd->ioptions()->level_compaction_dynamic_level_bytes);
+
+  std::vector<CompactionInputFiles> input_files;
+  Status s = cfd->compaction_picker()->GetCompactionInputsFromFileNumbers(
+      &input_files, &input_set, vstorage, comp_options);
+  if (!s.ok()) {
+    return s;
+  }
+
+  IOStatus io_s = fs_->CreateDirIfMissing(output_path, IOOptions(), nullptr);
+  std::unique_ptr<FSDirectory> output_dir;
+  if (io_s.ok()) {
+    io_s = fs_->NewDirectory(output_path, IOOptions(), &output_dir, nullptr);
+  }
+  if (!io_s.ok()) {
+    return io_s;
+  }
+
+  std::unique_ptr<Compaction> c(cfd->compaction_picker()->CompactFiles(
+      comp_options, input_files, input.output_level, vstorage,
+      *mutable_cf_options, mutable_db_options_, /*output_path_id=*/0));
+  assert(c != nullptr);
+  c->SetInputVersion(version);
+
+  const int job_id = next_job_id_.fetch_add(1);
+  LogBuffer log_buffer(InfoLogLevel::INFO_LEVEL,
+                       immutable_db_options_.info_log.get());
+  CompactionJobStats compaction_job_stats;
+  CompactionServiceCompactionJob compaction_job(
+      job_id, c.get(), immutable_db_options_, file_options_for_compaction_,
+      versions_.get(), &shutting_down_, &log_buffer, output_dir.get(), stats_,
+      &mutex_, &error_handler_, table_cache_, &event_logger_, dbname_,
+      &compaction_job_stats, io_tracer_, db_id_, db_session_id_, output_path,
+      input, result);
+
+  compaction_job.Prepare();
+
+  mutex_.Unlock();
+  s = compaction_job.Run();
+  mutex_.Lock();
+
+  compaction_job.io_status().PermitUncheckedError();
+  compaction_job.CleanupCompaction();
+  c->ReleaseCompactionFiles(s);
+  c.reset();
+  log_buffer.FlushBufferToLog();
+
+  TEST_SYNC_POINT_CALLBACK("DBImplSecondary::CompactWithoutInstallation::End",
+                           &s);
+  result->status = s;
+  return s;
+}
+
 Status DB::OpenAsSecondary(const Options& options, const std::string& dbname,
                            const std::string& secondary_path, DB** dbptr) {
   *dbptr = nullptr;
@@ -662,8 +754,97 @@ Status DB::OpenAsSecondary(
   }
   return s;
 }
+
+Status DB::OpenAndCompact(
+    const std::string& name, const std::string& output_directory,
+    const std::string& input, std::string* output,
+    const CompactionServiceOptionsOverride& override_options) {
+  assert(output != nullptr);
+  CompactionServiceInput compaction_input;
+  Status s = CompactionServiceInput::Read(input, &compaction_input);
+  if (!s.ok()) {
+    return s;
+  }
+
+  // 1. Load the options of the primary from its latest OPTIONS file.
+  ConfigOptions config_options;
+  config_options.env = override_options.env;
+  DBOptions db_options;
+  std::vector<ColumnFamilyDescriptor> all_column_families;
+  s = LoadLatestOptions(config_options, name, &db_options,
+                        &all_column_families);
+  if (!s.ok()) {
+    return s;
+  }
+
+  // 2. Fill in what cannot be loaded from the OPTIONS file. The worker runs
+  // the compaction itself and must not hand it to a service again.
+  db_options.env = override_options.env;
+  db_options.file_checksum_gen_factory =
+      override_options.file_checksum_gen_factory;
+  db_options.compaction_service = nullptr;
+  db_options.max_open_files = -1;
+
+  // 3. Open the default column family and the one being compacted.
+  std::vector<ColumnFamilyDescriptor> column_families;
+  size_t cf_index = all_column_families.size();
+  for (auto& cf : all_column_families) {
+    if (cf.name != compaction_input.cf_name &&
+        cf.name != kDefaultColumnFamilyName) {
+      continue;
+    }
+    cf.options.comparator = override_options.comparator;
+    cf.options.merge_operator = override_options.merge_operator;
+    cf.options.compaction_filter = override_options.compaction_filter;
+    cf.options.compaction_filter_factory =
+        override_options.compaction_filter_factory;
+    cf.options.prefix_extractor = override_options.prefix_extractor;
+    if (override_options.table_factory) {
+      cf.options.table_factory = override_options.table_factory;
+    }
+    cf.options.sst_partitioner_factory =
+        override_options.sst_partitioner_factory;
+    if (cf.name == compaction_input.cf_name) {
+      cf_index = column_families.size();
+    }
+    column_families.push_back(cf);
+  }
+  if (cf_index == all_column_families.size()) {
+    return Status::InvalidArgument("Cannot find column family",
+                                   compaction_input.cf_name);
+  }
+
+  DB* db = nullptr;
+  std::vector<ColumnFamilyHandle*> handles;
+  s = DB::OpenAsSecondary(db_options, name, output_directory, column_families,
+                          &handles, &db);
+  if (!s.ok()) {
+    return s;
+  }
+
+  CompactionServiceResult compaction_result;
+  DBImplSecondary* db_secondary = static_cast_with_check<DBImplSecondary>(db);
+  s = db_secondary->CompactWithoutInstallation(
+      handles[cf_index], output_directory, compaction_input,
+      &compaction_result);
+  compaction_result.status = s;
+  compaction_result.Write(output);
+
+  for (auto& handle : handles) {
+    delete handle;
+  }
+  delete db;
+  return s;
+}
 #else   // !ROCKSDB_LITE
 
+Status DB::OpenAndCompact(
+    const std::string& /*name*/, const std::string& /*output_directory*/,
+    const std::string& /*input*/, std::string* /*output*/,
+    const CompactionServiceOptionsOverride& /*override_options*/) {
+  return Status::NotSupported("Not supported in ROCKSDB_LITE.");
+}
+
 Status DB::OpenAsSecondary(const Options& /*options*/,
                            const std::string& /*name*/,
                            const std::string& /*secondary_path*/,
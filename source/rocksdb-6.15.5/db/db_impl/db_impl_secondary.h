@@ -9,6 +9,7 @@
 
 #include <string>
 #include <vector>
+#include "db/compaction/compaction_job.h"
 #include "db/db_impl/db_impl.h"
 
 namespace ROCKSDB_NAMESPACE {
@@ -222,6 +223,15 @@ class DBImplSecondary : public DBImpl {
   // not flag the missing file as inconsistency.
   Status CheckConsistency() override;
 
+  // Run the compaction described by `input` without installing the result:
+  // the output files are written to `output_path` and described in
+  // `result`. This is the worker side of a CompactionService, see
+  // DB::OpenAndCompact().
+  Status CompactWithoutInstallation(ColumnFamilyHandle* cfh,
+                                    const std::string& output_path,
+                                    const CompactionServiceInput& input,
+                                    CompactionServiceResult* result);
+
  protected:
   // ColumnFamilyCollector is a write batch handler which does nothing
   // except recording unique column family IDs
@@ -1820,6 +1820,9 @@ Status DBImpl::SwitchMemtable(ColumnFamilyData* cfd, WriteContext* context) {
   }
 
   cfd->mem()->SetNextLogNumber(logfile_number_);
+  // The memtable takes no more writes, so fragment its range tombstones once
+  // for all the reads and the flush instead of on every lookup.
+  cfd->mem()->ConstructFragmentedRangeTombstones();
   cfd->imm()->Add(cfd->mem(), &context->memtables_to_free_);
   new_mem->Ref();
   cfd->SetMemtable(new_mem);
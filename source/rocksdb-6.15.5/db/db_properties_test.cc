@@ -13,6 +13,8 @@
 #include <string>
 
 #include "db/db_test_util.h"
+#include "db/table_properties_collector.h"
+#include "file/filename.h"
 #include "port/stack_trace.h"
 #include "rocksdb/listener.h"
 #include "rocksdb/options.h"
@@ -1214,6 +1216,37 @@ TEST_F(DBPropertiesTest, GetUserDefinedTableProperties) {
   ASSERT_OK(dbfull()->TEST_CompactRange(0, nullptr, nullptr));
   ASSERT_GT(collector_factory->num_created_, 0U);
 }
+
+TEST_F(DBPropertiesTest, TombstoneRuns) {
+  Options options = CurrentOptions();
+  options.disable_auto_compactions = true;
+  DestroyAndReopen(options);
+
+  ASSERT_OK(Put("a", "val"));
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_OK(Delete(Key(i)));
+  }
+  ASSERT_OK(Put("z", "val"));
+  ASSERT_OK(Flush());
+
+  TablePropertiesCollection props;
+  ASSERT_OK(db_->GetPropertiesOfAllTables(&props));
+  ASSERT_EQ(1U, props.size());
+  const auto& user_collected = props.begin()->second->user_collected_properties;
+  ASSERT_EQ(100U, GetLongRunTombstones(user_collected));
+  const uint64_t file_number = TableFileNameToNumber(props.begin()->first);
+
+  SetPerfLevel(kEnableCount);
+  get_perf_context()->Reset();
+  std::unique_ptr<Iterator> iter(db_->NewIterator(ReadOptions()));
+  iter->Seek("b");
+  ASSERT_TRUE(iter->Valid());
+  ASSERT_EQ("z", iter->key());
+  ASSERT_EQ(100U, get_perf_context()->internal_tombstone_run_max);
+  ASSERT_EQ(file_number,
+            get_perf_context()->internal_tombstone_run_max_file_number);
+  SetPerfLevel(kDisable);
+}
 #endif  // ROCKSDB_LITE
 
 TEST_F(DBPropertiesTest, UserDefinedTablePropertiesContext) {
@@ -1713,6 +1746,68 @@ TEST_F(DBPropertiesTest, BlockCacheProperties) {
   ASSERT_EQ(0, value);
 }
 
+TEST_F(DBPropertiesTest, BlockCachePriorityPoolProperties) {
+  Options options = CurrentOptions();
+  uint64_t value;
+
+  constexpr size_t kCapacity = 100;
+  LRUCacheOptions co;
+  co.capacity = kCapacity;
+  co.num_shard_bits = 0;
+  co.high_pri_pool_ratio = 0.2;
+  co.low_pri_pool_ratio = 0.3;
+  co.metadata_charge_policy = kDontChargeCacheMetadata;
+  auto block_cache = NewLRUCache(co);
+  BlockBasedTableOptions table_options;
+  table_options.block_cache = block_cache;
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  Reopen(options);
+
+  auto check_usage = [&](uint64_t high, uint64_t low, uint64_t bottom) {
+    ASSERT_TRUE(db_->GetIntProperty(DB::Properties::kBlockCacheHighPriPoolUsage,
+                                    &value));
+    ASSERT_EQ(high, value);
+    ASSERT_TRUE(db_->GetIntProperty(DB::Properties::kBlockCacheLowPriPoolUsage,
+                                    &value));
+    ASSERT_EQ(low, value);
+    ASSERT_TRUE(db_->GetIntProperty(
+        DB::Properties::kBlockCacheBottomPriPoolUsage, &value));
+    ASSERT_EQ(bottom, value);
+  };
+
+  // Empty block cache.
+  check_usage(0, 0, 0);
+
+  // Each item lands in the pool of its priority.
+  ASSERT_OK(block_cache->Insert("item1", nullptr /*value*/, 10,
+                                nullptr /*deleter*/, nullptr /*handle*/,
+                                Cache::Priority::HIGH));
+  ASSERT_OK(block_cache->Insert("item2", nullptr /*value*/, 25,
+                                nullptr /*deleter*/, nullptr /*handle*/,
+                                Cache::Priority::LOW));
+  ASSERT_OK(block_cache->Insert("item3", nullptr /*value*/, 30,
+                                nullptr /*deleter*/, nullptr /*handle*/,
+                                Cache::Priority::BOTTOM));
+  check_usage(10, 25, 30);
+
+  // Overflowing the high-pri pool demotes its oldest item to the low-pri
+  // pool, which in turn demotes its oldest item to the bottom-pri pool.
+  ASSERT_OK(block_cache->Insert("item4", nullptr /*value*/, 15,
+                                nullptr /*deleter*/, nullptr /*handle*/,
+                                Cache::Priority::HIGH));
+  check_usage(15, 10, 55);
+
+  // Pinned items are not accounted to any pool.
+  Cache::Handle* item5 = nullptr;
+  ASSERT_OK(block_cache->Insert("item5", nullptr /*value*/, 5,
+                                nullptr /*deleter*/, &item5,
+                                Cache::Priority::HIGH));
+  ASSERT_NE(nullptr, item5);
+  check_usage(15, 10, 55);
+  block_cache->Release(item5);
+  check_usage(20, 10, 55);
+}
+
 #endif  // ROCKSDB_LITE
 }  // namespace ROCKSDB_NAMESPACE
 
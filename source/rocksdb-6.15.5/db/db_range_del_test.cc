@@ -680,6 +680,50 @@ TEST_F(DBRangeDelTest, GetCoveredKeyFromImmutableMemtable) {
   } while (ChangeOptions(kRangeDelSkipConfigs));
 }
 
+TEST_F(DBRangeDelTest, ReadImmutableMemtableRangeDels) {
+  Options opts = CurrentOptions();
+  opts.max_write_buffer_number = 3;
+  opts.min_write_buffer_number_to_merge = 2;
+  opts.disable_auto_compactions = true;
+  DestroyAndReopen(opts);
+
+  for (char c = 'a'; c <= 'f'; c++) {
+    ASSERT_OK(db_->Put(WriteOptions(), std::string(1, c), "val"));
+  }
+  const Snapshot* snapshot = db_->GetSnapshot();
+  ASSERT_OK(
+      db_->DeleteRange(WriteOptions(), db_->DefaultColumnFamily(), "a", "c"));
+  ASSERT_OK(
+      db_->DeleteRange(WriteOptions(), db_->DefaultColumnFamily(), "b", "e"));
+  // The range tombstones of the memtable are fragmented once when it becomes
+  // immutable, and the reads and the flush below share the result.
+  ASSERT_OK(dbfull()->TEST_SwitchMemtable());
+  ASSERT_OK(
+      db_->DeleteRange(WriteOptions(), db_->DefaultColumnFamily(), "f", "g"));
+
+  for (int i = 0; i < 2; i++) {
+    std::string value;
+    ASSERT_TRUE(db_->Get(ReadOptions(), "a", &value).IsNotFound());
+    ASSERT_TRUE(db_->Get(ReadOptions(), "d", &value).IsNotFound());
+    ASSERT_OK(db_->Get(ReadOptions(), "e", &value));
+    ASSERT_TRUE(db_->Get(ReadOptions(), "f", &value).IsNotFound());
+    ReadOptions snapshot_read_opts;
+    snapshot_read_opts.snapshot = snapshot;
+    ASSERT_OK(db_->Get(snapshot_read_opts, "d", &value));
+
+    std::unique_ptr<Iterator> iter(db_->NewIterator(ReadOptions()));
+    iter->SeekToFirst();
+    ASSERT_TRUE(iter->Valid());
+    ASSERT_EQ("e", iter->key());
+    iter->Next();
+    ASSERT_FALSE(iter->Valid());
+    ASSERT_OK(iter->status());
+
+    ASSERT_OK(db_->Flush(FlushOptions()));
+  }
+  db_->ReleaseSnapshot(snapshot);
+}
+
 TEST_F(DBRangeDelTest, GetCoveredKeyFromSst) {
   do {
     DestroyAndReopen(CurrentOptions());
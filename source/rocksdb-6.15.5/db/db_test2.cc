@@ -1,3 +1,4 @@
+#include <execinfo.h>
 //  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
 //  This source code is licensed under both the GPLv2 (found in the
 //  COPYING file in the root directory) and Apache 2.0 License
@@ -1824,6 +1825,47 @@ TEST_F(DBTest2, CompressionOptions) {
   }
 }
 
+TEST_F(DBTest2, ParallelCompressionPipelineWithFilter) {
+  for (bool partition_filters : {false, true}) {
+    for (ChecksumType checksum : {kCRC32c, kxxHash64}) {
+      Options options = CurrentOptions();
+      options.statistics = ROCKSDB_NAMESPACE::CreateDBStatistics();
+      options.compression_opts.parallel_threads = 4;
+      BlockBasedTableOptions table_options;
+      table_options.block_size = 256;
+      table_options.checksum = checksum;
+      table_options.filter_policy.reset(NewBloomFilterPolicy(10, false));
+      if (partition_filters) {
+        table_options.partition_filters = true;
+        table_options.index_type =
+            BlockBasedTableOptions::IndexType::kTwoLevelIndexSearch;
+        table_options.metadata_block_size = 256;
+      }
+      options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+      DestroyAndReopen(options);
+
+      const int kNumKeys = 1000;
+      for (int i = 0; i < kNumKeys; i++) {
+        ASSERT_OK(Put(Key(2 * i), "value" + ToString(i)));
+      }
+      ASSERT_OK(Flush());
+      ASSERT_OK(db_->VerifyChecksum());
+
+      // All keys made it into the data blocks and the filter.
+      for (int i = 0; i < kNumKeys; i++) {
+        ASSERT_EQ("value" + ToString(i), Get(Key(2 * i)));
+      }
+
+      // Absent keys are mostly filtered out.
+      for (int i = 0; i < kNumKeys; i++) {
+        ASSERT_EQ("NOT_FOUND", Get(Key(2 * i + 1)));
+      }
+      ASSERT_GT(TestGetTickerCount(options, BLOOM_FILTER_USEFUL),
+                kNumKeys * 9 / 10);
+    }
+  }
+}
+
 class CompactionStallTestListener : public EventListener {
  public:
   CompactionStallTestListener() : compacting_files_cnt_(0), compacted_files_cnt_(0) {}
@@ -3736,6 +3778,57 @@ TEST_F(DBTest2, TestNumPread) {
   ASSERT_EQ(0, env_->random_file_open_counter_.load());
 }
 
+TEST_F(DBTest2, LazyTableOpen) {
+  Options options = CurrentOptions();
+  options.max_open_files = -1;
+  options.disable_auto_compactions = true;
+  Reopen(options);
+  for (int i = 0; i < 6; i++) {
+    ASSERT_OK(Put(Key(i), "v" + ToString(i)));
+    ASSERT_OK(Flush());
+    if (i == 2) {
+      MoveFilesToLevel(1);
+    }
+  }
+  ASSERT_EQ("3,3", FilesPerLevel());
+
+  options.lazy_table_open = true;
+  options.max_file_opening_threads = 1;
+  std::vector<int> warmed_levels;
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->LoadDependency(
+      {{"DBTest2::LazyTableOpen:Checked", "DBImpl::WarmTableCache:Start"}});
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->SetCallBack(
+      "DBImpl::WarmTableCache:File", [&](void* arg) {
+        warmed_levels.push_back(*static_cast<int*>(arg));
+      });
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->SetCallBack(
+      "TableCache::GetTableReader:0", [&](void*) {
+        void* bt[40]; int n = backtrace(bt, 40); backtrace_symbols_fd(bt, n, 2); fprintf(stderr, "-----\n");
+      });
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->EnableProcessing();
+  env_->random_file_open_counter_.store(0);
+  Reopen(options);
+  // No table file was opened by DB::Open().
+  ASSERT_EQ(0, env_->random_file_open_counter_.load());
+
+  // The file holding the key is opened on first access.
+  ASSERT_EQ("v5", Get(Key(5)));
+  ASSERT_EQ(1, env_->random_file_open_counter_.load());
+
+  TEST_SYNC_POINT("DBTest2::LazyTableOpen:Checked");
+  dbfull()->TEST_WaitForTableCacheWarming();
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->DisableProcessing();
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->ClearAllCallBacks();
+  // The other files are opened by the warming thread, L0 first, and the file
+  // already open is not opened again.
+  ASSERT_EQ(6, env_->random_file_open_counter_.load());
+  ASSERT_EQ(std::vector<int>({0, 0, 0, 1, 1, 1}), warmed_levels);
+  for (int i = 0; i < 6; i++) {
+    ASSERT_EQ("v" + ToString(i), Get(Key(i)));
+  }
+  ASSERT_EQ(6, env_->random_file_open_counter_.load());
+}
+
 TEST_F(DBTest2, TraceAndReplay) {
   Options options = CurrentOptions();
   options.merge_operator = MergeOperators::CreatePutOperator();
@@ -672,6 +672,40 @@ TEST_P(DBTestUniversalCompactionMultiLevels, UniversalCompactionMultiLevels) {
   }
 }
 
+TEST_P(DBTestUniversalCompactionMultiLevels, UniversalCompactionLazyLeveling) {
+  Options options = CurrentOptions();
+  options.compaction_style = kCompactionStyleUniversal;
+  options.compaction_options_universal.lazy_leveling = true;
+  options.num_levels = num_levels_;
+  options.write_buffer_size = 100 << 10;  // 100KB
+  options.max_bytes_for_level_multiplier = 4;
+  options.level0_slowdown_writes_trigger = 64;
+  options.level0_stop_writes_trigger = 128;
+  options.target_file_size_base = 32 * 1024;
+  DestroyAndReopen(options);
+
+  int num_keys = 100000;
+  for (int i = 0; i < num_keys * 2; i++) {
+    ASSERT_OK(Put(Key(i % num_keys), Key(i)));
+  }
+  ASSERT_OK(Flush());
+  ASSERT_OK(dbfull()->TEST_WaitForCompact());
+
+  // Every tier holds fewer runs than max_bytes_for_level_multiplier, and the
+  // data is a few MB, i.e. spans at most four tiers.
+  int num_sorted_runs = NumTableFilesAtLevel(0);
+  for (int level = 1; level < num_levels_; level++) {
+    if (NumTableFilesAtLevel(level) > 0) {
+      num_sorted_runs++;
+    }
+  }
+  ASSERT_LE(num_sorted_runs, 4 * 3 + 1);
+
+  for (int i = num_keys; i < num_keys * 2; i++) {
+    ASSERT_EQ(Get(Key(i % num_keys)), Key(i));
+  }
+}
+
 // Tests universal compaction with trivial move enabled
 TEST_P(DBTestUniversalCompactionMultiLevels, UniversalCompactionTrivialMove) {
   int32_t trivial_move = 0;
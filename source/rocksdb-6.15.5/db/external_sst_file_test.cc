@@ -2403,7 +2403,7 @@ TEST_F(ExternalSSTFileTest, IngestFileWrittenWithCompressionDictionary) {
 
 // Very slow, not worth the cost to run regularly
 TEST_F(ExternalSSTFileTest, DISABLED_HugeBlockChecksum) {
-  int max_checksum = static_cast<int>(kxxHash64);
+  int max_checksum = static_cast<int>(kXXH3);
   for (int i = 0; i <= max_checksum; ++i) {
     BlockBasedTableOptions table_options;
     table_options.checksum = static_cast<ChecksumType>(i);
@@ -483,6 +483,10 @@ Status FlushJob::WriteLevel0Table() {
   cfd_->internal_stats()->AddCompactionStats(0 /* level */, thread_pri_, stats);
   cfd_->internal_stats()->AddCFStats(InternalStats::BYTES_FLUSHED,
                                      stats.bytes_written);
+  if (has_output && cfd_->ioptions()->cf_paths.size() > 1) {
+    cfd_->internal_stats()->AddPathBytesWritten(meta_.fd.GetPathId(),
+                                                meta_.fd.GetFileSize());
+  }
   RecordFlushIOStats();
   return s;
 }
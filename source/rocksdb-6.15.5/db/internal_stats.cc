@@ -258,6 +258,12 @@ static const std::string estimate_oldest_key_time = "estimate-oldest-key-time";
 static const std::string block_cache_capacity = "block-cache-capacity";
 static const std::string block_cache_usage = "block-cache-usage";
 static const std::string block_cache_pinned_usage = "block-cache-pinned-usage";
+static const std::string block_cache_high_pri_pool_usage =
+    "block-cache-high-pri-pool-usage";
+static const std::string block_cache_low_pri_pool_usage =
+    "block-cache-low-pri-pool-usage";
+static const std::string block_cache_bottom_pri_pool_usage =
+    "block-cache-bottom-pri-pool-usage";
 static const std::string options_statistics = "options-statistics";
 
 const std::string DB::Properties::kNumFilesAtLevelPrefix =
@@ -346,6 +352,12 @@ const std::string DB::Properties::kBlockCacheUsage =
     rocksdb_prefix + block_cache_usage;
 const std::string DB::Properties::kBlockCachePinnedUsage =
     rocksdb_prefix + block_cache_pinned_usage;
+const std::string DB::Properties::kBlockCacheHighPriPoolUsage =
+    rocksdb_prefix + block_cache_high_pri_pool_usage;
+const std::string DB::Properties::kBlockCacheLowPriPoolUsage =
+    rocksdb_prefix + block_cache_low_pri_pool_usage;
+const std::string DB::Properties::kBlockCacheBottomPriPoolUsage =
+    rocksdb_prefix + block_cache_bottom_pri_pool_usage;
 const std::string DB::Properties::kOptionsStatistics =
     rocksdb_prefix + options_statistics;
 
@@ -484,6 +496,15 @@ const std::unordered_map<std::string, DBPropertyInfo>
         {DB::Properties::kBlockCachePinnedUsage,
          {false, nullptr, &InternalStats::HandleBlockCachePinnedUsage, nullptr,
           nullptr}},
+        {DB::Properties::kBlockCacheHighPriPoolUsage,
+         {false, nullptr, &InternalStats::HandleBlockCacheHighPriPoolUsage,
+          nullptr, nullptr}},
+        {DB::Properties::kBlockCacheLowPriPoolUsage,
+         {false, nullptr, &InternalStats::HandleBlockCacheLowPriPoolUsage,
+          nullptr, nullptr}},
+        {DB::Properties::kBlockCacheBottomPriPoolUsage,
+         {false, nullptr, &InternalStats::HandleBlockCacheBottomPriPoolUsage,
+          nullptr, nullptr}},
         {DB::Properties::kOptionsStatistics,
          {false, nullptr, nullptr, nullptr,
           &DBImpl::GetPropertyHandleOptionsStatistics}},
@@ -946,6 +967,35 @@ bool InternalStats::HandleBlockCachePinnedUsage(uint64_t* value, DBImpl* /*db*/,
   return true;
 }
 
+bool InternalStats::HandleBlockCachePriorityPoolUsage(uint64_t* value,
+                                                      Cache::Priority priority) {
+  Cache* block_cache;
+  bool ok = HandleBlockCacheStat(&block_cache);
+  if (!ok) {
+    return false;
+  }
+  *value = static_cast<uint64_t>(block_cache->GetPriorityPoolUsage(priority));
+  return true;
+}
+
+bool InternalStats::HandleBlockCacheHighPriPoolUsage(uint64_t* value,
+                                                     DBImpl* /*db*/,
+                                                     Version* /*version*/) {
+  return HandleBlockCachePriorityPoolUsage(value, Cache::Priority::HIGH);
+}
+
+bool InternalStats::HandleBlockCacheLowPriPoolUsage(uint64_t* value,
+                                                    DBImpl* /*db*/,
+                                                    Version* /*version*/) {
+  return HandleBlockCachePriorityPoolUsage(value, Cache::Priority::LOW);
+}
+
+bool InternalStats::HandleBlockCacheBottomPriPoolUsage(uint64_t* value,
+                                                       DBImpl* /*db*/,
+                                                       Version* /*version*/) {
+  return HandleBlockCachePriorityPoolUsage(value, Cache::Priority::BOTTOM);
+}
+
 void InternalStats::DumpDBStats(std::string* value) {
   char buf[1000];
   // DB-level stats, only available from default column family
@@ -1406,6 +1456,19 @@ void InternalStats::DumpCFFileHistogram(std::string* value) {
         << blob_file_read_latency_.ToString() << '\n';
   }
 
+  const auto& cf_paths = cfd_->ioptions()->cf_paths;
+  if (cf_paths.size() > 1) {
+    oss << "\n** File I/O By Path [" << cfd_->GetName() << "] **\n";
+    for (uint32_t p = 0; p < cf_paths.size() && p < kMaxNumPaths; p++) {
+      PathIOStats stats = GetPathIOStats(p);
+      oss << "Path " << p << " (" << cf_paths[p].path
+          << "): user reads: " << stats.user_reads << ", user read MB: "
+          << stats.user_bytes_read / kMB
+          << ", compaction read MB: " << stats.compaction_bytes_read / kMB
+          << ", written MB: " << stats.bytes_written / kMB << '\n';
+    }
+  }
+
   value->append(oss.str());
 }
 
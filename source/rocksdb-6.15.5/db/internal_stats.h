@@ -321,10 +321,31 @@ class InternalStats {
     }
   };
 
+  // I/O to the table files on one of the cf_paths.
+  struct PathIOStats {
+    // Number of table file lookups of point reads
+    uint64_t user_reads = 0;
+    // Bytes read from the files by point reads, zero for cache hits
+    uint64_t user_bytes_read = 0;
+    // Bytes of the input files of compactions
+    uint64_t compaction_bytes_read = 0;
+    // Bytes of the files written by flushes and compactions
+    uint64_t bytes_written = 0;
+  };
+
+  // The path id of a table file takes two bits, see FileDescriptor.
+  static const uint32_t kMaxNumPaths = 4;
+
   void Clear() {
     for (int i = 0; i < kIntStatsNumMax; i++) {
       db_stats_[i].store(0);
     }
+    for (auto& s : path_io_stats_) {
+      s.user_reads.store(0);
+      s.user_bytes_read.store(0);
+      s.compaction_bytes_read.store(0);
+      s.bytes_written.store(0);
+    }
     for (int i = 0; i < INTERNAL_CF_STATS_ENUM_MAX; i++) {
       cf_stats_count_[i] = 0;
       cf_stats_value_[i] = 0;
@@ -378,6 +399,42 @@ class InternalStats {
 
   HistogramImpl* GetBlobFileReadHist() { return &blob_file_read_latency_; }
 
+  void AddPathUserRead(uint32_t path_id, uint64_t bytes) {
+    if (path_id < kMaxNumPaths) {
+      path_io_stats_[path_id].user_reads.fetch_add(1,
+                                                   std::memory_order_relaxed);
+      path_io_stats_[path_id].user_bytes_read.fetch_add(
+          bytes, std::memory_order_relaxed);
+    }
+  }
+
+  void AddPathCompactionBytesRead(uint32_t path_id, uint64_t bytes) {
+    if (path_id < kMaxNumPaths) {
+      path_io_stats_[path_id].compaction_bytes_read.fetch_add(
+          bytes, std::memory_order_relaxed);
+    }
+  }
+
+  void AddPathBytesWritten(uint32_t path_id, uint64_t bytes) {
+    if (path_id < kMaxNumPaths) {
+      path_io_stats_[path_id].bytes_written.fetch_add(
+          bytes, std::memory_order_relaxed);
+    }
+  }
+
+  PathIOStats GetPathIOStats(uint32_t path_id) const {
+    PathIOStats stats;
+    if (path_id < kMaxNumPaths) {
+      const auto& s = path_io_stats_[path_id];
+      stats.user_reads = s.user_reads.load(std::memory_order_relaxed);
+      stats.user_bytes_read = s.user_bytes_read.load(std::memory_order_relaxed);
+      stats.compaction_bytes_read =
+          s.compaction_bytes_read.load(std::memory_order_relaxed);
+      stats.bytes_written = s.bytes_written.load(std::memory_order_relaxed);
+    }
+    return stats;
+  }
+
   uint64_t GetBackgroundErrorCount() const { return bg_error_count_; }
 
   uint64_t BumpAndGetBackgroundErrorCount() { return ++bg_error_count_; }
@@ -430,6 +487,14 @@ class InternalStats {
   std::vector<CompactionStats> comp_stats_by_pri_;
   std::vector<HistogramImpl> file_read_latency_;
   HistogramImpl blob_file_read_latency_;
+  // Per-path I/O stats. Point reads update them without holding the DB mutex.
+  struct AtomicPathIOStats {
+    std::atomic<uint64_t> user_reads{0};
+    std::atomic<uint64_t> user_bytes_read{0};
+    std::atomic<uint64_t> compaction_bytes_read{0};
+    std::atomic<uint64_t> bytes_written{0};
+  };
+  AtomicPathIOStats path_io_stats_[kMaxNumPaths];
 
   // Used to compute per-interval statistics
   struct CFStatsSnapshot {
@@ -587,6 +652,14 @@ class InternalStats {
   bool HandleBlockCacheUsage(uint64_t* value, DBImpl* db, Version* version);
   bool HandleBlockCachePinnedUsage(uint64_t* value, DBImpl* db,
                                    Version* version);
+  bool HandleBlockCacheHighPriPoolUsage(uint64_t* value, DBImpl* db,
+                                        Version* version);
+  bool HandleBlockCacheLowPriPoolUsage(uint64_t* value, DBImpl* db,
+                                       Version* version);
+  bool HandleBlockCacheBottomPriPoolUsage(uint64_t* value, DBImpl* db,
+                                          Version* version);
+  bool HandleBlockCachePriorityPoolUsage(uint64_t* value,
+                                         Cache::Priority priority);
   // Total number of background errors encountered. Every time a flush task
   // or compaction task fails, this counter is incremented. The failure can
   // be caused by any possible reason, including file system errors, out of
@@ -675,6 +748,23 @@ class InternalStats {
 
   HistogramImpl* GetBlobFileReadHist() { return nullptr; }
 
+  struct PathIOStats {
+    uint64_t user_reads = 0;
+    uint64_t user_bytes_read = 0;
+    uint64_t compaction_bytes_read = 0;
+    uint64_t bytes_written = 0;
+  };
+
+  void AddPathUserRead(uint32_t /*path_id*/, uint64_t /*bytes*/) {}
+
+  void AddPathCompactionBytesRead(uint32_t /*path_id*/, uint64_t /*bytes*/) {}
+
+  void AddPathBytesWritten(uint32_t /*path_id*/, uint64_t /*bytes*/) {}
+
+  PathIOStats GetPathIOStats(uint32_t /*path_id*/) const {
+    return PathIOStats();
+  }
+
   uint64_t GetBackgroundErrorCount() const { return 0; }
 
   uint64_t BumpAndGetBackgroundErrorCount() { return 0; }
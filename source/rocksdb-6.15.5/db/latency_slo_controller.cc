@@ -0,0 +1,115 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "db/latency_slo_controller.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace ROCKSDB_NAMESPACE {
+
+constexpr double LatencySloController::kMinShare;
+constexpr double LatencySloController::kShareIncrement;
+constexpr double LatencySloController::kShareDecreaseFactor;
+constexpr double LatencySloController::kHeadroom;
+
+LatencySloController::LatencySloController(uint64_t get_slo_micros,
+                                           uint64_t write_slo_micros,
+                                           int64_t max_bytes_per_sec)
+    : get_slo_micros_(get_slo_micros),
+      write_slo_micros_(write_slo_micros),
+      max_bytes_per_sec_(max_bytes_per_sec),
+      bytes_per_sec_(max_bytes_per_sec) {}
+
+double LatencySloController::WindowPercentile(
+    const HistogramBucketMapper& mapper, const std::vector<uint64_t>& prev,
+    const std::vector<uint64_t>& cur, double p) {
+  assert(prev.empty() || prev.size() == cur.size());
+  assert(cur.size() <= mapper.BucketCount());
+  auto window_count = [&](size_t b) {
+    uint64_t before = prev.empty() ? 0 : prev[b];
+    return cur[b] >= before ? cur[b] - before : 0;
+  };
+  uint64_t num = 0;
+  for (size_t b = 0; b < cur.size(); b++) {
+    num += window_count(b);
+  }
+  if (num == 0) {
+    return 0;
+  }
+  // Same interpolation as HistogramStat::Percentile().
+  double threshold = num * (p / 100.0);
+  uint64_t cumulative_sum = 0;
+  for (size_t b = 0; b < cur.size(); b++) {
+    uint64_t bucket_value = window_count(b);
+    cumulative_sum += bucket_value;
+    if (cumulative_sum >= threshold) {
+      uint64_t left_point = (b == 0) ? 0 : mapper.BucketLimit(b - 1);
+      uint64_t right_point = mapper.BucketLimit(b);
+      uint64_t left_sum = cumulative_sum - bucket_value;
+      double pos = 0;
+      if (bucket_value != 0) {
+        pos = (threshold - left_sum) / bucket_value;
+      }
+      return left_point + (right_point - left_point) * pos;
+    }
+  }
+  return static_cast<double>(mapper.BucketLimit(cur.size() - 1));
+}
+
+bool LatencySloController::Step(const std::vector<uint64_t>& get_counts,
+                                const std::vector<uint64_t>& write_counts,
+                                bool stall_risk, int max_compactions,
+                                uint32_t max_subcompactions) {
+  get_p99_ = 0;
+  if (!get_counts.empty()) {
+    if (prev_get_counts_.size() == get_counts.size()) {
+      get_p99_ = WindowPercentile(mapper_, prev_get_counts_, get_counts, 99);
+    }
+    prev_get_counts_ = get_counts;
+  }
+  write_p99_ = 0;
+  if (!write_counts.empty()) {
+    if (prev_write_counts_.size() == write_counts.size()) {
+      write_p99_ =
+          WindowPercentile(mapper_, prev_write_counts_, write_counts, 99);
+    }
+    prev_write_counts_ = write_counts;
+  }
+
+  bool missed = (get_slo_micros_ > 0 && get_p99_ > get_slo_micros_) ||
+                (write_slo_micros_ > 0 && write_p99_ > write_slo_micros_);
+  bool headroom =
+      (get_slo_micros_ == 0 || get_p99_ <= kHeadroom * get_slo_micros_) &&
+      (write_slo_micros_ == 0 || write_p99_ <= kHeadroom * write_slo_micros_);
+  if (stall_risk) {
+    share_ = 1.0;
+  } else if (missed) {
+    share_ = std::max(kMinShare, share_ * kShareDecreaseFactor);
+  } else if (headroom) {
+    share_ = std::min(1.0, share_ + kShareIncrement);
+  }
+
+  int64_t bytes_per_sec = std::max<int64_t>(
+      1, static_cast<int64_t>(std::llround(max_bytes_per_sec_ * share_)));
+  if (max_bytes_per_sec_ == 0) {
+    bytes_per_sec = 0;
+  }
+  int compactions = std::max(
+      1, static_cast<int>(std::lround(std::max(max_compactions, 1) * share_)));
+  uint32_t subcompactions = std::max(
+      1u, static_cast<uint32_t>(
+              std::lround(std::max(max_subcompactions, 1u) * share_)));
+  bool changed = bytes_per_sec != bytes_per_sec_ ||
+                 compactions != max_compactions_ ||
+                 subcompactions != max_subcompactions_;
+  bytes_per_sec_ = bytes_per_sec;
+  max_compactions_ = compactions;
+  max_subcompactions_ = subcompactions;
+  return changed;
+}
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -0,0 +1,85 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "monitoring/histogram.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// LatencySloController decides how much of the background resources
+// compactions get so that the p99 latencies of foreground reads and writes
+// stay within DBOptions::get_latency_slo_micros and write_latency_slo_micros.
+//
+// It is stepped periodically with the cumulative bucket counts of the DB_GET
+// and DB_WRITE histograms, and works on the latencies recorded since the
+// previous step. While a target is missed, the share of resources given to
+// compactions is cut multiplicatively; while all latencies are well within
+// their targets, it is given back additively. The share goes back to full at
+// once when writes are at risk of stalling, as a stall hurts tail latency
+// far more than compaction I/O does.
+//
+// Not thread-safe; DBImpl steps it and reads its limits under the DB mutex.
+class LatencySloController {
+ public:
+  // The smallest share of the resources compactions are cut down to.
+  static constexpr double kMinShare = 1.0 / 16;
+  // The share given back on each step with enough headroom.
+  static constexpr double kShareIncrement = 1.0 / 16;
+  // The factor the share is multiplied with on each step missing a target.
+  static constexpr double kShareDecreaseFactor = 0.75;
+  // Latencies at or below this fraction of their target leave headroom to
+  // give resources back to compactions.
+  static constexpr double kHeadroom = 0.8;
+
+  // A target of 0 means no target. `max_bytes_per_sec` is the rate of the
+  // rate limiter when the share is full, or 0 if there is no rate limiter.
+  LatencySloController(uint64_t get_slo_micros, uint64_t write_slo_micros,
+                       int64_t max_bytes_per_sec);
+
+  // Takes one step from the cumulative bucket counts of the DB_GET and
+  // DB_WRITE histograms, which may be empty if they are not available.
+  // `max_compactions` and `max_subcompactions` are the limits configured by
+  // the options, which the limits of the controller are scaled from.
+  // Returns true if any limit changed.
+  bool Step(const std::vector<uint64_t>& get_counts,
+            const std::vector<uint64_t>& write_counts, bool stall_risk,
+            int max_compactions, uint32_t max_subcompactions);
+
+  double share() const { return share_; }
+  int64_t bytes_per_sec() const { return bytes_per_sec_; }
+  int max_compactions() const { return max_compactions_; }
+  uint32_t max_subcompactions() const { return max_subcompactions_; }
+  // The p99 latencies seen by the last step, 0 if nothing was recorded.
+  double get_p99() const { return get_p99_; }
+  double write_p99() const { return write_p99_; }
+
+  // Returns the p-th percentile of the values recorded between the
+  // cumulative bucket counts `prev` and `cur`, or 0 if there are none.
+  static double WindowPercentile(const HistogramBucketMapper& mapper,
+                                 const std::vector<uint64_t>& prev,
+                                 const std::vector<uint64_t>& cur, double p);
+
+ private:
+  const uint64_t get_slo_micros_;
+  const uint64_t write_slo_micros_;
+  const int64_t max_bytes_per_sec_;
+  const HistogramBucketMapper mapper_;
+
+  std::vector<uint64_t> prev_get_counts_;
+  std::vector<uint64_t> prev_write_counts_;
+  double share_ = 1.0;
+  int64_t bytes_per_sec_;
+  int max_compactions_ = 0;
+  uint32_t max_subcompactions_ = 0;
+  double get_p99_ = 0;
+  double write_p99_ = 0;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -0,0 +1,128 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "db/latency_slo_controller.h"
+
+#include "port/stack_trace.h"
+#include "test_util/testharness.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+class LatencySloControllerTest : public testing::Test {
+ protected:
+  // Records `n` values of `micros` into `hist` and returns its cumulative
+  // bucket counts.
+  static std::vector<uint64_t> Record(HistogramImpl* hist, uint64_t micros,
+                                      int n) {
+    for (int i = 0; i < n; i++) {
+      hist->Add(micros);
+    }
+    std::vector<uint64_t> counts;
+    hist->BucketCounts(&counts);
+    return counts;
+  }
+};
+
+TEST_F(LatencySloControllerTest, WindowPercentile) {
+  HistogramBucketMapper mapper;
+  HistogramImpl hist;
+  std::vector<uint64_t> empty = Record(&hist, 0, 0);
+  ASSERT_EQ(0, LatencySloController::WindowPercentile(mapper, {}, empty, 99));
+
+  std::vector<uint64_t> slow = Record(&hist, 10000, 1000);
+  ASSERT_EQ(0, LatencySloController::WindowPercentile(mapper, slow, slow, 99));
+
+  // Only the fast values recorded after `slow` are in the window, even though
+  // most values recorded so far are slow.
+  std::vector<uint64_t> fast = Record(&hist, 10, 100);
+  ASSERT_LE(LatencySloController::WindowPercentile(mapper, slow, fast, 99),
+            10);
+  ASSERT_GE(LatencySloController::WindowPercentile(mapper, {}, fast, 99),
+            5000);
+}
+
+TEST_F(LatencySloControllerTest, MissedTargetCutsShare) {
+  HistogramImpl get_hist;
+  LatencySloController controller(1000 /* get_slo_micros */,
+                                  0 /* write_slo_micros */,
+                                  1000000 /* max_bytes_per_sec */);
+  ASSERT_TRUE(controller.Step(Record(&get_hist, 100, 100), {}, false, 4, 4));
+  ASSERT_EQ(1.0, controller.share());
+  ASSERT_EQ(1000000, controller.bytes_per_sec());
+  ASSERT_EQ(4, controller.max_compactions());
+  ASSERT_EQ(4u, controller.max_subcompactions());
+
+  ASSERT_TRUE(controller.Step(Record(&get_hist, 5000, 100), {}, false, 4, 4));
+  ASSERT_GT(controller.get_p99(), 1000);
+  ASSERT_EQ(0.75, controller.share());
+  ASSERT_EQ(750000, controller.bytes_per_sec());
+  ASSERT_EQ(3, controller.max_compactions());
+  ASSERT_EQ(3u, controller.max_subcompactions());
+
+  ASSERT_TRUE(controller.Step(Record(&get_hist, 5000, 100), {}, false, 4, 4));
+  ASSERT_EQ(0.5625, controller.share());
+  ASSERT_EQ(562500, controller.bytes_per_sec());
+  ASSERT_EQ(2, controller.max_compactions());
+  ASSERT_EQ(2u, controller.max_subcompactions());
+
+  // Fast reads give the resources back step by step.
+  ASSERT_TRUE(controller.Step(Record(&get_hist, 100, 100), {}, false, 4, 4));
+  ASSERT_LE(controller.get_p99(), 800);
+  ASSERT_EQ(0.625, controller.share());
+  ASSERT_EQ(625000, controller.bytes_per_sec());
+  ASSERT_EQ(3, controller.max_compactions());
+
+  // Nothing recorded also leaves headroom.
+  ASSERT_TRUE(controller.Step(Record(&get_hist, 0, 0), {}, false, 4, 4));
+  ASSERT_EQ(0, controller.get_p99());
+  ASSERT_EQ(0.6875, controller.share());
+}
+
+TEST_F(LatencySloControllerTest, StallRiskRestoresShare) {
+  HistogramImpl write_hist;
+  LatencySloController controller(0 /* get_slo_micros */,
+                                  1000 /* write_slo_micros */,
+                                  1000000 /* max_bytes_per_sec */);
+  controller.Step({}, Record(&write_hist, 100, 100), false, 2, 1);
+  for (int i = 0; i < 3; i++) {
+    ASSERT_TRUE(
+        controller.Step({}, Record(&write_hist, 5000, 100), false, 2, 1));
+  }
+  ASSERT_LT(controller.share(), 0.5);
+
+  // Writes at risk of stalling need compactions to catch up, no matter the
+  // latencies.
+  ASSERT_TRUE(controller.Step({}, Record(&write_hist, 5000, 100), true, 2, 1));
+  ASSERT_GT(controller.write_p99(), 1000);
+  ASSERT_EQ(1.0, controller.share());
+  ASSERT_EQ(1000000, controller.bytes_per_sec());
+  ASSERT_EQ(2, controller.max_compactions());
+  ASSERT_EQ(1u, controller.max_subcompactions());
+  ASSERT_FALSE(controller.Step({}, Record(&write_hist, 100, 100), true, 2, 1));
+}
+
+TEST_F(LatencySloControllerTest, MinShare) {
+  HistogramImpl get_hist;
+  LatencySloController controller(1000 /* get_slo_micros */,
+                                  0 /* write_slo_micros */,
+                                  0 /* max_bytes_per_sec */);
+  controller.Step(Record(&get_hist, 100, 100), {}, false, 8, 4);
+  for (int i = 0; i < 20; i++) {
+    controller.Step(Record(&get_hist, 5000, 100), {}, false, 8, 4);
+  }
+  ASSERT_EQ(LatencySloController::kMinShare, controller.share());
+  // Without a rate limiter there is no rate to adjust.
+  ASSERT_EQ(0, controller.bytes_per_sec());
+  ASSERT_EQ(1, controller.max_compactions());
+  ASSERT_EQ(1u, controller.max_subcompactions());
+}
+
+}  // namespace ROCKSDB_NAMESPACE
+
+int main(int argc, char** argv) {
+  ROCKSDB_NAMESPACE::port::InstallStackTraceHandler();
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
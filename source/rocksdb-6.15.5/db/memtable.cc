@@ -85,6 +85,7 @@ MemTable::MemTable(const InternalKeyComparator& cmp,
           comparator_, &arena_, nullptr /* transform */, ioptions.info_log,
           column_family_id)),
       is_range_del_table_empty_(true),
+      fragmented_range_tombstones_constructed_(false),
       data_size_(0),
       num_entries_(0),
       num_deletes_(0),
@@ -440,6 +441,11 @@ FragmentedRangeTombstoneIterator* MemTable::NewRangeTombstoneIterator(
       is_range_del_table_empty_.load(std::memory_order_relaxed)) {
     return nullptr;
   }
+  if (fragmented_range_tombstones_constructed_.load(
+          std::memory_order_acquire)) {
+    return new FragmentedRangeTombstoneIterator(
+        fragmented_range_tombstone_list_, comparator_.comparator, read_seq);
+  }
   auto* unfragmented_iter = new MemTableIterator(
       *this, read_options, nullptr /* arena */, true /* use_range_del_table */);
   if (unfragmented_iter == nullptr) {
@@ -455,6 +461,23 @@ FragmentedRangeTombstoneIterator* MemTable::NewRangeTombstoneIterator(
   return fragmented_iter;
 }
 
+void MemTable::ConstructFragmentedRangeTombstones() {
+  if (is_range_del_table_empty_.load(std::memory_order_relaxed) ||
+      fragmented_range_tombstones_constructed_.load(
+          std::memory_order_relaxed)) {
+    return;
+  }
+  auto* unfragmented_iter =
+      new MemTableIterator(*this, ReadOptions(), nullptr /* arena */,
+                           true /* use_range_del_table */);
+  fragmented_range_tombstone_list_ =
+      std::make_shared<FragmentedRangeTombstoneList>(
+          std::unique_ptr<InternalIterator>(unfragmented_iter),
+          comparator_.comparator);
+  fragmented_range_tombstones_constructed_.store(true,
+                                                 std::memory_order_release);
+}
+
 port::RWMutex* MemTable::GetLock(const Slice& key) {
   return &locks_[GetSliceRangedNPHash(key, locks_.size())];
 }
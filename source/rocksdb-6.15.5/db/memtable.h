@@ -172,9 +172,19 @@ class MemTable {
   //        those allocated in arena.
   InternalIterator* NewIterator(const ReadOptions& read_options, Arena* arena);
 
+  // Returns an iterator over the range tombstones of the memtable, fragmented
+  // on every call unless ConstructFragmentedRangeTombstones() has been called.
   FragmentedRangeTombstoneIterator* NewRangeTombstoneIterator(
       const ReadOptions& read_options, SequenceNumber read_seq);
 
+  // Fragments the range tombstones of the memtable once, to be shared by all
+  // the iterators NewRangeTombstoneIterator() returns from then on, including
+  // those of the reads and of the flush of the memtable.
+  //
+  // REQUIRES: no range deletion is added to the memtable anymore, i.e. it is
+  // about to become immutable, and no concurrent call to this function.
+  void ConstructFragmentedRangeTombstones();
+
   // Add an entry into memtable that maps key to value at the
   // specified sequence number and with the specified type.
   // Typically value will be empty if type==kTypeDeletion.
@@ -462,6 +472,11 @@ class MemTable {
   std::unique_ptr<MemTableRep> table_;
   std::unique_ptr<MemTableRep> range_del_table_;
   std::atomic_bool is_range_del_table_empty_;
+  // Set by ConstructFragmentedRangeTombstones(). Only read once
+  // fragmented_range_tombstones_constructed_ is true.
+  std::shared_ptr<FragmentedRangeTombstoneList>
+      fragmented_range_tombstone_list_;
+  std::atomic<bool> fragmented_range_tombstones_constructed_;
 
   // Total data size of all data inserted
   std::atomic<uint64_t> data_size_;
@@ -33,11 +33,17 @@ class OutputValidator {
     return GetHash() == other_validator.GetHash();
   }
 
- private:
   // Not (yet) intended to be persisted, so subject to change
-  // without notice between releases.
+  // without notice between releases. Only exchanged between a DB and its
+  // CompactionService workers, which must run the same release.
   uint64_t GetHash() const { return paranoid_hash_; }
 
+  // Adopt the hash of a file that was validated by a CompactionService
+  // worker.
+  void SetHash(uint64_t hash) { paranoid_hash_ = hash; }
+
+ private:
+
   const InternalKeyComparator& icmp_;
   std::string prev_key_;
   uint64_t paranoid_hash_ = 0;
@@ -16,7 +16,8 @@ PeriodicWorkScheduler::PeriodicWorkScheduler(Env* env) : timer_mu_(env) {
 
 void PeriodicWorkScheduler::Register(DBImpl* dbi,
                                      unsigned int stats_dump_period_sec,
-                                     unsigned int stats_persist_period_sec) {
+                                     unsigned int stats_persist_period_sec,
+                                     bool adjust_for_latency_slo) {
   MutexLock l(&timer_mu_);
   static std::atomic<uint64_t> initial_delay(0);
   timer->Start();
@@ -39,6 +40,12 @@ void PeriodicWorkScheduler::Register(DBImpl* dbi,
              initial_delay.fetch_add(1) % kDefaultFlushInfoLogPeriodSec *
                  kMicrosInSecond,
              kDefaultFlushInfoLogPeriodSec * kMicrosInSecond);
+  if (adjust_for_latency_slo) {
+    timer->Add([dbi]() { dbi->AdjustForLatencySlo(); },
+               GetTaskName(dbi, "latency_slo"),
+               kDefaultLatencySloPeriodSec * kMicrosInSecond,
+               kDefaultLatencySloPeriodSec * kMicrosInSecond);
+  }
 }
 
 void PeriodicWorkScheduler::Unregister(DBImpl* dbi) {
@@ -46,6 +53,7 @@ void PeriodicWorkScheduler::Unregister(DBImpl* dbi) {
   timer->Cancel(GetTaskName(dbi, "dump_st"));
   timer->Cancel(GetTaskName(dbi, "pst_st"));
   timer->Cancel(GetTaskName(dbi, "flush_info_log"));
+  timer->Cancel(GetTaskName(dbi, "latency_slo"));
   if (!timer->HasPendingTask()) {
     timer->Shutdown();
   }
@@ -13,8 +13,8 @@
 namespace ROCKSDB_NAMESPACE {
 
 // PeriodicWorkScheduler is a singleton object, which is scheduling/running
-// DumpStats(), PersistStats(), and FlushInfoLog() for all DB instances. All DB
-// instances use the same object from `Default()`.
+// DumpStats(), PersistStats(), FlushInfoLog(), and AdjustForLatencySlo() for
+// all DB instances. All DB instances use the same object from `Default()`.
 //
 // Internally, it uses a single threaded timer object to run the periodic work
 // functions. Timer thread will always be started since the info log flushing
@@ -30,7 +30,8 @@ class PeriodicWorkScheduler {
   PeriodicWorkScheduler& operator=(PeriodicWorkScheduler&&) = delete;
 
   void Register(DBImpl* dbi, unsigned int stats_dump_period_sec,
-                unsigned int stats_persist_period_sec);
+                unsigned int stats_persist_period_sec,
+                bool adjust_for_latency_slo = false);
 
   void Unregister(DBImpl* dbi);
 
@@ -40,6 +41,11 @@ class PeriodicWorkScheduler {
   // log.
   static const uint64_t kDefaultFlushInfoLogPeriodSec = 10;
 
+  // How often the resources of compactions are adjusted to the latency SLOs.
+  // Latencies are followed over this period, so it should leave time for
+  // enough operations to get meaningful percentiles.
+  static const uint64_t kDefaultLatencySloPeriodSec = 1;
+
  protected:
   std::unique_ptr<Timer> timer;
   // `timer_mu_` serves two purposes currently:
@@ -221,6 +221,57 @@ TEST_F(PeriodicWorkSchedulerTest, MultiEnv) {
   delete db;
   Close();
 }
+
+TEST_F(PeriodicWorkSchedulerTest, LatencySlo) {
+  constexpr int kPeriodSec =
+      PeriodicWorkScheduler::kDefaultLatencySloPeriodSec;
+  constexpr int64_t kBytesPerSec = 1 << 20;
+  Close();
+  Options options;
+  options.create_if_missing = true;
+  options.env = mock_env_.get();
+  options.statistics = CreateDBStatistics();
+  options.rate_limiter.reset(NewGenericRateLimiter(kBytesPerSec));
+  options.write_latency_slo_micros = 1000;
+
+  int latency_slo_counter = 0;
+  SyncPoint::GetInstance()->SetCallBack(
+      "DBImpl::AdjustForLatencySlo:StartRunning",
+      [&](void*) { latency_slo_counter++; });
+  SyncPoint::GetInstance()->EnableProcessing();
+
+  Reopen(options);
+
+  auto scheduler = dbfull()->TEST_GetPeriodicWorkScheduler();
+  ASSERT_NE(nullptr, scheduler);
+  ASSERT_EQ(4, scheduler->TEST_GetValidTaskNum());
+
+  dbfull()->TEST_WaitForStatsDumpRun(
+      [&] { mock_env_->MockSleepForSeconds(kPeriodSec); });
+  ASSERT_EQ(1, latency_slo_counter);
+  ASSERT_EQ(kBytesPerSec, options.rate_limiter->GetBytesPerSecond());
+
+  // Writes missing the target slow compactions down.
+  for (int i = 0; i < 100; i++) {
+    options.statistics->recordInHistogram(DB_WRITE, 5000);
+  }
+  dbfull()->TEST_WaitForStatsDumpRun(
+      [&] { mock_env_->MockSleepForSeconds(kPeriodSec); });
+  ASSERT_EQ(2, latency_slo_counter);
+  ASSERT_EQ(kBytesPerSec * 3 / 4, options.rate_limiter->GetBytesPerSecond());
+
+  // And fast writes speed them up again.
+  for (int i = 0; i < 100; i++) {
+    options.statistics->recordInHistogram(DB_WRITE, 10);
+  }
+  dbfull()->TEST_WaitForStatsDumpRun(
+      [&] { mock_env_->MockSleepForSeconds(kPeriodSec); });
+  ASSERT_EQ(3, latency_slo_counter);
+  ASSERT_EQ(kBytesPerSec * 13 / 16, options.rate_limiter->GetBytesPerSecond());
+
+  Close();
+  ASSERT_EQ(0, scheduler->TEST_GetValidTaskNum());
+}
 #endif  // !ROCKSDB_LITE
 }  // namespace ROCKSDB_NAMESPACE
 
@@ -164,9 +164,19 @@ ForwardRangeDelIterator::ForwardRangeDelIterator(
       unused_idx_(0),
       active_seqnums_(SeqMaxComparator()),
       active_iters_(EndKeyMinComparator(icmp)),
-      inactive_iters_(StartKeyMinComparator(icmp)) {}
+      inactive_iters_(StartKeyMinComparator(icmp)),
+      next_change_valid_(false),
+      next_change_unbounded_(false),
+      max_active_seq_(0) {}
 
 bool ForwardRangeDelIterator::ShouldDelete(const ParsedInternalKey& parsed) {
+  // Fast path for keys before the next tombstone boundary, which is where
+  // most keys of a compaction or forward scan fall.
+  if (next_change_valid_ &&
+      (next_change_unbounded_ || icmp_->Compare(parsed, next_change_) < 0)) {
+    return max_active_seq_ > parsed.sequence;
+  }
+
   // Move active iterators that end before parsed.
   while (!active_iters_.empty() &&
          icmp_->Compare((*active_iters_.top())->end_key(), parsed) <= 0) {
@@ -189,9 +199,27 @@ bool ForwardRangeDelIterator::ShouldDelete(const ParsedInternalKey& parsed) {
     assert(active_iters_.size() == active_seqnums_.size());
   }
 
-  return active_seqnums_.empty()
-             ? false
-             : (*active_seqnums_.begin())->seq() > parsed.sequence;
+  UpdateNextChange();
+  return max_active_seq_ > parsed.sequence;
+}
+
+void ForwardRangeDelIterator::UpdateNextChange() {
+  max_active_seq_ =
+      active_seqnums_.empty() ? 0 : (*active_seqnums_.begin())->seq();
+  next_change_unbounded_ = true;
+  if (!active_iters_.empty()) {
+    next_change_ = (*active_iters_.top())->end_key();
+    next_change_unbounded_ = false;
+  }
+  if (!inactive_iters_.empty()) {
+    ParsedInternalKey next_start = inactive_iters_.top()->start_key();
+    if (next_change_unbounded_ ||
+        icmp_->Compare(next_start, next_change_) < 0) {
+      next_change_ = next_start;
+      next_change_unbounded_ = false;
+    }
+  }
+  next_change_valid_ = true;
 }
 
 void ForwardRangeDelIterator::Invalidate() {
@@ -199,6 +227,7 @@ void ForwardRangeDelIterator::Invalidate() {
   active_iters_.clear();
   active_seqnums_.clear();
   inactive_iters_.clear();
+  next_change_valid_ = false;
 }
 
 ReverseRangeDelIterator::ReverseRangeDelIterator(
@@ -120,6 +120,7 @@ class ForwardRangeDelIterator {
     iter->Seek(parsed.user_key);
     PushIter(iter, parsed);
     assert(active_iters_.size() == active_seqnums_.size());
+    next_change_valid_ = false;
   }
 
   size_t UnusedIdx() const { return unused_idx_; }
@@ -129,6 +130,11 @@ class ForwardRangeDelIterator {
   using ActiveSeqSet =
       std::multiset<TruncatedRangeDelIterator*, SeqMaxComparator>;
 
+  // Remembers where the set of active tombstones changes next and the highest
+  // sequence number among them, so that the keys of a sorted stream before
+  // that point are answered with a single comparison.
+  void UpdateNextChange();
+
   struct EndKeyMinComparator {
     explicit EndKeyMinComparator(const InternalKeyComparator* c) : icmp(c) {}
 
@@ -183,6 +189,13 @@ class ForwardRangeDelIterator {
   ActiveSeqSet active_seqnums_;
   BinaryHeap<ActiveSeqSet::const_iterator, EndKeyMinComparator> active_iters_;
   BinaryHeap<TruncatedRangeDelIterator*, StartKeyMinComparator> inactive_iters_;
+
+  // Valid until the heaps change. If next_change_unbounded_ is true, no
+  // tombstone starts or ends after the last key checked.
+  bool next_change_valid_;
+  bool next_change_unbounded_;
+  ParsedInternalKey next_change_;
+  SequenceNumber max_active_seq_;
 };
 
 class ReverseRangeDelIterator {
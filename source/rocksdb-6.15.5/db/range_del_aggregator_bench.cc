@@ -54,9 +54,18 @@ DEFINE_int32(should_deletes_per_run, 1, "number of ShouldDelete calls per run");
 DEFINE_int32(add_tombstones_per_run, 1,
              "number of AddTombstones calls per run");
 
+DEFINE_bool(use_compaction_range_del_agg, false,
+            "use CompactionRangeDelAggregator instead of "
+            "ReadRangeDelAggregator");
+
+DEFINE_int32(num_snapshots, 0,
+             "number of snapshots splitting the tombstones of the "
+             "CompactionRangeDelAggregator into stripes");
+
 namespace {
 
 struct Stats {
+  uint64_t time_fragment_tombstones = 0;
   uint64_t time_add_tombstones = 0;
   uint64_t time_first_should_delete = 0;
   uint64_t time_rest_should_delete = 0;
@@ -67,6 +76,10 @@ std::ostream& operator<<(std::ostream& os, const Stats& s) {
   fmt_holder.copyfmt(os);
 
   os << std::left;
+  os << std::setw(25) << "FragmentTombstones: "
+     << s.time_fragment_tombstones /
+            (FLAGS_add_tombstones_per_run * FLAGS_num_runs * 1.0e3)
+     << " us\n";
   os << std::setw(25) << "AddTombstones: "
      << s.time_add_tombstones /
             (FLAGS_add_tombstones_per_run * FLAGS_num_runs * 1.0e3)
@@ -184,10 +197,22 @@ int main(int argc, char** argv) {
             FLAGS_num_range_tombstones);
   }
   auto mode = ROCKSDB_NAMESPACE::RangeDelPositioningMode::kForwardTraversal;
+  std::vector<ROCKSDB_NAMESPACE::SequenceNumber> snapshots;
+  for (int i = 1; i <= FLAGS_num_snapshots; i++) {
+    snapshots.push_back(static_cast<ROCKSDB_NAMESPACE::SequenceNumber>(
+        FLAGS_num_range_tombstones * i / (FLAGS_num_snapshots + 1)));
+  }
 
   for (int i = 0; i < FLAGS_num_runs; i++) {
-    ROCKSDB_NAMESPACE::ReadRangeDelAggregator range_del_agg(
-        &icmp, ROCKSDB_NAMESPACE::kMaxSequenceNumber /* upper_bound */);
+    std::unique_ptr<ROCKSDB_NAMESPACE::RangeDelAggregator> range_del_agg;
+    if (FLAGS_use_compaction_range_del_agg) {
+      range_del_agg.reset(
+          new ROCKSDB_NAMESPACE::CompactionRangeDelAggregator(&icmp,
+                                                              snapshots));
+    } else {
+      range_del_agg.reset(new ROCKSDB_NAMESPACE::ReadRangeDelAggregator(
+          &icmp, ROCKSDB_NAMESPACE::kMaxSequenceNumber /* upper_bound */));
+    }
 
     std::vector<
         std::unique_ptr<ROCKSDB_NAMESPACE::FragmentedRangeTombstoneList> >
@@ -208,11 +233,16 @@ int main(int argc, char** argv) {
 
       auto range_del_iter =
           ROCKSDB_NAMESPACE::MakeRangeDelIterator(persistent_range_tombstones);
+      // Tables and immutable memtables fragment their tombstones once and
+      // share the result between all the aggregators they are added to, so
+      // this is timed apart from AddTombstones.
+      ROCKSDB_NAMESPACE::StopWatchNano stop_watch_fragment_tombstones(
+          ROCKSDB_NAMESPACE::Env::Default(), true /* auto_start */);
       fragmented_range_tombstone_lists.emplace_back(
           new ROCKSDB_NAMESPACE::FragmentedRangeTombstoneList(
-              ROCKSDB_NAMESPACE::MakeRangeDelIterator(
-                  persistent_range_tombstones),
-              icmp));
+              std::move(range_del_iter), icmp));
+      stats.time_fragment_tombstones +=
+          stop_watch_fragment_tombstones.ElapsedNanos();
       std::unique_ptr<ROCKSDB_NAMESPACE::FragmentedRangeTombstoneIterator>
           fragmented_range_del_iter(
               new ROCKSDB_NAMESPACE::FragmentedRangeTombstoneIterator(
@@ -221,7 +251,7 @@ int main(int argc, char** argv) {
 
       ROCKSDB_NAMESPACE::StopWatchNano stop_watch_add_tombstones(
           ROCKSDB_NAMESPACE::Env::Default(), true /* auto_start */);
-      range_del_agg.AddTombstones(std::move(fragmented_range_del_iter));
+      range_del_agg->AddTombstones(std::move(fragmented_range_del_iter));
       stats.time_add_tombstones += stop_watch_add_tombstones.ElapsedNanos();
     }
 
@@ -238,7 +268,7 @@ int main(int argc, char** argv) {
 
       ROCKSDB_NAMESPACE::StopWatchNano stop_watch_should_delete(
           ROCKSDB_NAMESPACE::Env::Default(), true /* auto_start */);
-      range_del_agg.ShouldDelete(parsed_key, mode);
+      range_del_agg->ShouldDelete(parsed_key, mode);
       uint64_t call_time = stop_watch_should_delete.ElapsedNanos();
 
       if (j == 0) {
@@ -515,6 +515,42 @@ TEST_F(RangeDelAggregatorTest, MultipleTruncatedItersInAggregatorSameLevel) {
                                            {"zz", "zzz", false}});
 }
 
+TEST_F(RangeDelAggregatorTest, SortedKeysInAggregator) {
+  auto fragment_lists = MakeFragmentedTombstoneLists(
+      {{{"a", "e", 10}, {"c", "g", 8}}, {{"x", "y", 5}}});
+
+  ReadRangeDelAggregator range_del_agg(&bytewise_icmp, kMaxSequenceNumber);
+  std::unique_ptr<FragmentedRangeTombstoneIterator> input_iter(
+      new FragmentedRangeTombstoneIterator(fragment_lists[0].get(),
+                                           bytewise_icmp, kMaxSequenceNumber));
+  range_del_agg.AddTombstones(std::move(input_iter));
+
+  // Keys between two tombstone boundaries are answered without moving the
+  // tombstone iterators, which must still take the sequence numbers of the
+  // keys into account.
+  auto mode = RangeDelPositioningMode::kForwardTraversal;
+  EXPECT_FALSE(range_del_agg.ShouldDelete(InternalValue("a", 11), mode));
+  EXPECT_TRUE(range_del_agg.ShouldDelete(InternalValue("a", 9), mode));
+  EXPECT_FALSE(range_del_agg.ShouldDelete(InternalValue("b", 12), mode));
+  EXPECT_TRUE(range_del_agg.ShouldDelete(InternalValue("b", 5), mode));
+  EXPECT_FALSE(range_del_agg.ShouldDelete(InternalValue("c", 10), mode));
+  EXPECT_TRUE(range_del_agg.ShouldDelete(InternalValue("c", 9), mode));
+  EXPECT_FALSE(range_del_agg.ShouldDelete(InternalValue("e", 9), mode));
+  EXPECT_TRUE(range_del_agg.ShouldDelete(InternalValue("e", 7), mode));
+  EXPECT_TRUE(range_del_agg.ShouldDelete(InternalValue("f", 7), mode));
+  EXPECT_FALSE(range_del_agg.ShouldDelete(InternalValue("g", 1), mode));
+  EXPECT_FALSE(range_del_agg.ShouldDelete(InternalValue("w", 1), mode));
+
+  // Tombstones added in the middle of the stream are picked up.
+  input_iter.reset(new FragmentedRangeTombstoneIterator(
+      fragment_lists[1].get(), bytewise_icmp, kMaxSequenceNumber));
+  range_del_agg.AddTombstones(std::move(input_iter));
+  EXPECT_TRUE(range_del_agg.ShouldDelete(InternalValue("x", 4), mode));
+  EXPECT_TRUE(range_del_agg.ShouldDelete(InternalValue("xx", 4), mode));
+  EXPECT_FALSE(range_del_agg.ShouldDelete(InternalValue("y", 4), mode));
+  EXPECT_FALSE(range_del_agg.ShouldDelete(InternalValue("z", 4), mode));
+}
+
 TEST_F(RangeDelAggregatorTest, CompactionAggregatorNoSnapshots) {
   auto fragment_lists = MakeFragmentedTombstoneLists(
       {{{"a", "e", 10}, {"c", "g", 8}},
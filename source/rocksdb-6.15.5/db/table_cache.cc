@@ -16,9 +16,11 @@
 #include "file/file_util.h"
 #include "file/filename.h"
 #include "file/random_access_file_reader.h"
+#include "memory/arena.h"
 #include "monitoring/perf_context_imp.h"
 #include "rocksdb/statistics.h"
 #include "table/block_based/block_based_table_reader.h"
+#include "table/clipping_iterator.h"
 #include "table/get_context.h"
 #include "table/internal_iterator.h"
 #include "table/iterator_wrapper.h"
@@ -249,6 +251,20 @@ InternalIterator* TableCache::NewIterator(
       result->RegisterCleanup(&UnrefEntry, cache_, handle);
       handle = nullptr;  // prevent from releasing below
     }
+    if (file_meta.virtual_range_size > 0) {
+      // Hide the entries of the file that belong to other table files.
+      if (arena != nullptr) {
+        auto mem = arena->AllocateAligned(sizeof(ClippingIterator));
+        result = new (mem)
+            ClippingIterator(result, file_meta.smallest.Encode(),
+                             file_meta.largest.Encode(), &icomparator,
+                             true /* arena_mode */);
+      } else {
+        result = new ClippingIterator(result, file_meta.smallest.Encode(),
+                                      file_meta.largest.Encode(), &icomparator,
+                                      false /* arena_mode */);
+      }
+    }
 
     if (for_compaction) {
       table_reader->SetupForCompaction();
@@ -701,4 +717,27 @@ uint64_t TableCache::ApproximateSize(
 
   return result;
 }
+
+Status TableCache::ApproximateKeyAnchors(
+    const ReadOptions& ro, const InternalKeyComparator& internal_comparator,
+    const FileDescriptor& fd, std::vector<TableReader::Anchor>& anchors) {
+  Status s;
+  TableReader* t = fd.table_reader;
+  Cache::Handle* handle = nullptr;
+  if (t == nullptr) {
+    s = FindTable(ro, file_options_, internal_comparator, fd, &handle,
+                  /*prefix_extractor=*/nullptr, /*no_io=*/false,
+                  /*record_read_stats=*/false);
+    if (s.ok()) {
+      t = GetTableReaderFromHandle(handle);
+    }
+  }
+  if (s.ok() && t != nullptr) {
+    s = t->ApproximateKeyAnchors(ro, anchors);
+  }
+  if (handle != nullptr) {
+    ReleaseHandle(handle);
+  }
+  return s;
+}
 }  // namespace ROCKSDB_NAMESPACE
@@ -178,6 +178,13 @@ class TableCache {
                            const InternalKeyComparator& internal_comparator,
                            const SliceTransform* prefix_extractor = nullptr);
 
+  // Samples the table represented by fd into key anchors, see
+  // TableReader::ApproximateKeyAnchors().
+  Status ApproximateKeyAnchors(const ReadOptions& ro,
+                               const InternalKeyComparator& internal_comparator,
+                               const FileDescriptor& fd,
+                               std::vector<TableReader::Anchor>& anchors);
+
   // Release the handle from a cache
   void ReleaseHandle(Cache::Handle* handle);
 
@@ -59,6 +59,117 @@ UserKeyTablePropertiesCollector::GetReadableProperties() const {
   return collector_->GetReadableProperties();
 }
 
+size_t TombstoneRunsCollector::BucketFor(uint64_t run_length) {
+  assert(run_length > 0);
+  size_t bucket = 0;
+  while (bucket + 1 < kNumBuckets && run_length >= 4) {
+    run_length /= 4;
+    ++bucket;
+  }
+  return bucket;
+}
+
+Status TombstoneRunsCollector::InternalAdd(const Slice& key,
+                                           const Slice& /* value */,
+                                           uint64_t /* file_size */) {
+  ParsedInternalKey ikey;
+  Status s = ParseInternalKey(key, &ikey, false /* log_err_key */);
+  if (!s.ok()) {
+    return s;
+  }
+
+  switch (ikey.type) {
+    case kTypeDeletion:
+    case kTypeSingleDeletion:
+    case kTypeDeletionWithTimestamp:
+      ++cur_run_;
+      break;
+    case kTypeRangeDeletion:
+      // Range tombstones live in their own block and do not break a run.
+      break;
+    default:
+      EndRun();
+      break;
+  }
+  return Status::OK();
+}
+
+void TombstoneRunsCollector::EndRun() {
+  if (cur_run_ == 0) {
+    return;
+  }
+  Bucket& bucket = histogram_[BucketFor(cur_run_)];
+  ++bucket.num_runs;
+  bucket.num_tombstones += cur_run_;
+  cur_run_ = 0;
+}
+
+Status TombstoneRunsCollector::Finish(UserCollectedProperties* properties) {
+  EndRun();
+  bool has_tombstones = false;
+  std::string encoded;
+  for (const Bucket& bucket : histogram_) {
+    has_tombstones = has_tombstones || bucket.num_runs > 0;
+    PutVarint64Varint64(&encoded, bucket.num_runs, bucket.num_tombstones);
+  }
+  if (has_tombstones) {
+    properties->insert({TablePropertiesNames::kTombstoneRuns, encoded});
+  }
+  return Status::OK();
+}
+
+UserCollectedProperties TombstoneRunsCollector::GetReadableProperties()
+    const {
+  // Finish() has flushed the last run by the time this is called.
+  std::string readable;
+  uint64_t lower = 1;
+  for (size_t i = 0; i < kNumBuckets; ++i, lower *= 4) {
+    if (histogram_[i].num_runs == 0) {
+      continue;
+    }
+    if (!readable.empty()) {
+      readable += "; ";
+    }
+    readable += "[" + ToString(lower) + ", " +
+                (i + 1 < kNumBuckets ? ToString(lower * 4) : "inf") +
+                "): " + ToString(histogram_[i].num_runs) + " runs, " +
+                ToString(histogram_[i].num_tombstones) + " tombstones";
+  }
+  if (readable.empty()) {
+    return UserCollectedProperties();
+  }
+  return {{TablePropertiesNames::kTombstoneRuns, readable}};
+}
+
+bool GetTombstoneRunHistogram(const UserCollectedProperties& props,
+                              TombstoneRunsCollector::Histogram* histogram) {
+  auto pos = props.find(TablePropertiesNames::kTombstoneRuns);
+  if (pos == props.end()) {
+    return false;
+  }
+  Slice raw = pos->second;
+  for (auto& bucket : *histogram) {
+    if (!GetVarint64(&raw, &bucket.num_runs) ||
+        !GetVarint64(&raw, &bucket.num_tombstones)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+uint64_t GetLongRunTombstones(const UserCollectedProperties& props) {
+  TombstoneRunsCollector::Histogram histogram;
+  if (!GetTombstoneRunHistogram(props, &histogram)) {
+    return 0;
+  }
+  uint64_t num_tombstones = 0;
+  for (size_t i = TombstoneRunsCollector::BucketFor(kLongTombstoneRun);
+       i < histogram.size(); ++i) {
+    num_tombstones += histogram[i].num_tombstones;
+  }
+  return num_tombstones;
+}
+
 uint64_t GetDeletedKeys(
     const UserCollectedProperties& props) {
   bool property_present_ignored;
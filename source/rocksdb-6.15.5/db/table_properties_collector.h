@@ -8,6 +8,7 @@
 
 #include "rocksdb/table_properties.h"
 
+#include <array>
 #include <memory>
 #include <string>
 #include <vector>
@@ -104,4 +105,68 @@ class UserKeyTablePropertiesCollectorFactory
   std::shared_ptr<TablePropertiesCollectorFactory> user_collector_factory_;
 };
 
+// Collects TablePropertiesNames::kTombstoneRuns: a histogram of the lengths
+// of runs of consecutive point tombstones in the table. An iterator has to
+// step over a whole run before it reaches a live key, so long runs slow reads
+// down even when tombstones are only a small fraction of the file.
+class TombstoneRunsCollector : public IntTblPropCollector {
+ public:
+  static const size_t kNumBuckets = 6;
+
+  struct Bucket {
+    uint64_t num_runs = 0;
+    uint64_t num_tombstones = 0;
+  };
+  using Histogram = std::array<Bucket, kNumBuckets>;
+
+  // Bucket that runs of `run_length` (> 0) tombstones fall into.
+  static size_t BucketFor(uint64_t run_length);
+
+  virtual Status InternalAdd(const Slice& key, const Slice& value,
+                             uint64_t file_size) override;
+
+  virtual void BlockAdd(uint64_t /* blockRawBytes */,
+                        uint64_t /* blockCompressedBytesFast */,
+                        uint64_t /* blockCompressedBytesSlow */) override {}
+
+  virtual Status Finish(UserCollectedProperties* properties) override;
+
+  virtual const char* Name() const override {
+    return "TombstoneRunsCollector";
+  }
+
+  UserCollectedProperties GetReadableProperties() const override;
+
+ private:
+  void EndRun();
+
+  Histogram histogram_;
+  uint64_t cur_run_ = 0;
+};
+
+class TombstoneRunsCollectorFactory : public IntTblPropCollectorFactory {
+ public:
+  virtual IntTblPropCollector* CreateIntTblPropCollector(
+      uint32_t /* column_family_id */) override {
+    return new TombstoneRunsCollector();
+  }
+
+  virtual const char* Name() const override {
+    return "TombstoneRunsCollectorFactory";
+  }
+};
+
+// Decodes TablePropertiesNames::kTombstoneRuns. Returns false if the table
+// has no such property or it cannot be parsed.
+extern bool GetTombstoneRunHistogram(
+    const UserCollectedProperties& props,
+    TombstoneRunsCollector::Histogram* histogram);
+
+// Runs of at least this many tombstones are considered long.
+static const uint64_t kLongTombstoneRun = 16;
+
+// Returns the number of point tombstones the table holds in runs of at least
+// kLongTombstoneRun, or 0 if unknown.
+extern uint64_t GetLongRunTombstones(const UserCollectedProperties& props);
+
 }  // namespace ROCKSDB_NAMESPACE
@@ -503,6 +503,49 @@ TEST_P(TablePropertiesTest, InternalKeyPropertiesCollector) {
 #endif  // !ROCKSDB_LITE
 }
 
+TEST(TombstoneRunsCollectorTest, Histogram) {
+  TombstoneRunsCollector collector;
+  SequenceNumber seq = 0;
+  auto add = [&](ValueType type, int count) {
+    for (int i = 0; i < count; ++i) {
+      ++seq;
+      InternalKey ikey("key" + ToString(seq), seq, type);
+      ASSERT_OK(collector.InternalAdd(ikey.Encode(), "", 0 /* file_size */));
+    }
+  };
+  add(kTypeDeletion, 2);
+  add(kTypeValue, 1);
+  add(kTypeDeletion, 10);
+  // Range tombstones neither extend nor break a run.
+  add(kTypeRangeDeletion, 1);
+  add(kTypeSingleDeletion, 10);
+  add(kTypeMerge, 1);
+  add(kTypeDeletion, 100);
+
+  UserCollectedProperties props;
+  ASSERT_OK(collector.Finish(&props));
+  TombstoneRunsCollector::Histogram histogram;
+  ASSERT_TRUE(GetTombstoneRunHistogram(props, &histogram));
+  for (size_t i = 0; i < histogram.size(); ++i) {
+    uint64_t expected_runs = (i == 0 || i == 2 || i == 3) ? 1 : 0;
+    ASSERT_EQ(expected_runs, histogram[i].num_runs);
+  }
+  ASSERT_EQ(2U, histogram[0].num_tombstones);
+  ASSERT_EQ(20U, histogram[2].num_tombstones);
+  ASSERT_EQ(100U, histogram[3].num_tombstones);
+  ASSERT_EQ(120U, GetLongRunTombstones(props));
+  ASSERT_EQ(1U, collector.GetReadableProperties().size());
+
+  // Tables without point tombstones get no histogram.
+  TombstoneRunsCollector no_tombstones;
+  InternalKey ikey("key", 1, kTypeValue);
+  ASSERT_OK(no_tombstones.InternalAdd(ikey.Encode(), "", 0 /* file_size */));
+  props.clear();
+  ASSERT_OK(no_tombstones.Finish(&props));
+  ASSERT_TRUE(props.empty());
+  ASSERT_EQ(0U, GetLongRunTombstones(props));
+}
+
 INSTANTIATE_TEST_CASE_P(InternalKeyPropertiesCollector, TablePropertiesTest,
                         ::testing::Bool());
 
@@ -162,6 +162,7 @@ bool VersionEdit::EncodeTo(std::string* dst) const {
     //
     // Customized encoding for fields:
     //   tag kPathId: 1 byte as path_id
+    //   tag kVirtualRangeSize: varint64 as virtual_range_size
     //   tag kNeedCompaction:
     //        now only can take one char value 1 indicating need-compaction
     //
@@ -190,6 +191,12 @@ bool VersionEdit::EncodeTo(std::string* dst) const {
       char p = static_cast<char>(f.fd.GetPathId());
       PutLengthPrefixedSlice(dst, Slice(&p, 1));
     }
+    if (f.virtual_range_size != 0) {
+      PutVarint32(dst, NewFileCustomTag::kVirtualRangeSize);
+      std::string varint_virtual_range_size;
+      PutVarint64(&varint_virtual_range_size, f.virtual_range_size);
+      PutLengthPrefixedSlice(dst, Slice(varint_virtual_range_size));
+    }
     if (f.marked_for_compaction) {
       PutVarint32(dst, NewFileCustomTag::kNeedCompaction);
       char p = static_cast<char>(1);
@@ -315,6 +322,11 @@ const char* VersionEdit::DecodeNewFile4From(Slice* input) {
             return "path_id wrong vaue";
           }
           break;
+        case kVirtualRangeSize:
+          if (!GetVarint64(&field, &f.virtual_range_size)) {
+            return "invalid virtual range size";
+          }
+          break;
         case kOldestAncesterTime:
           if (!GetVarint64(&field, &f.oldest_ancester_time)) {
             return "invalid oldest ancester time";
@@ -700,6 +712,10 @@ std::string VersionEdit::DebugString(bool hex_key) const {
       r.append(" blob_file:");
       AppendNumberTo(&r, f.oldest_blob_file_number);
     }
+    if (f.virtual_range_size != 0) {
+      r.append(" virtual_range_size:");
+      AppendNumberTo(&r, f.virtual_range_size);
+    }
     r.append(" oldest_ancester_time:");
     AppendNumberTo(&r, f.oldest_ancester_time);
     r.append(" file_creation_time:");
@@ -806,6 +822,9 @@ std::string VersionEdit::DebugJSON(int edit_num, bool hex_key) const {
       if (f.oldest_blob_file_number != kInvalidBlobFileNumber) {
         jw << "OldestBlobFile" << f.oldest_blob_file_number;
       }
+      if (f.virtual_range_size != 0) {
+        jw << "VirtualRangeSize" << f.virtual_range_size;
+      }
       jw.EndArrayedObject();
     }
 
@@ -82,6 +82,7 @@ enum NewFileCustomTag : uint32_t {
 
   // Forward incompatible (aka unignorable) fields
   kPathId,
+  kVirtualRangeSize,
 };
 
 class VersionSet;
@@ -140,15 +141,19 @@ struct FileDescriptor {
 };
 
 struct FileSampledStats {
-  FileSampledStats() : num_reads_sampled(0) {}
+  FileSampledStats() : num_reads_sampled(0), num_seek_misses_sampled(0) {}
   FileSampledStats(const FileSampledStats& other) { *this = other; }
   FileSampledStats& operator=(const FileSampledStats& other) {
     num_reads_sampled = other.num_reads_sampled.load();
+    num_seek_misses_sampled = other.num_seek_misses_sampled.load();
     return *this;
   }
 
   // number of user reads to this file.
   mutable std::atomic<uint64_t> num_reads_sampled;
+  // number of point lookups that searched this file past its filter without
+  // finding the key, and went on to search another file.
+  mutable std::atomic<uint64_t> num_seek_misses_sampled;
 };
 
 struct FileMetaData {
@@ -173,6 +178,8 @@ struct FileMetaData {
   uint64_t num_deletions = 0;   // the number of deletion entries.
   uint64_t raw_key_size = 0;    // total uncompressed key size.
   uint64_t raw_value_size = 0;  // total uncompressed value size.
+  // the number of point tombstones in runs of at least kLongTombstoneRun.
+  uint64_t num_long_run_tombstones = 0;
 
   int refs = 0;  // Reference count
 
@@ -202,6 +209,12 @@ struct FileMetaData {
   // File checksum function name
   std::string file_checksum_func_name = kUnknownFileChecksumFuncName;
 
+  // If non-zero, the table file is a hard link to a file that is shared with
+  // other table files, and only the entries within [smallest, largest] belong
+  // to this one. The value is the approximate size of these entries, see
+  // DBImpl::PartialTrivialMove().
+  uint64_t virtual_range_size = 0;
+
   FileMetaData() = default;
 
   FileMetaData(uint64_t file, uint32_t file_path_id, uint64_t file_size,
@@ -380,13 +393,16 @@ class VersionEdit {
   // REQUIRES: "smallest" and "largest" are smallest and largest keys in file
   // REQUIRES: "oldest_blob_file_number" is the number of the oldest blob file
   // referred to by this file if any, kInvalidBlobFileNumber otherwise.
+  // REQUIRES: "virtual_range_size" is non-zero only if the file is a hard link
+  // of which only [smallest, largest] is used, see FileMetaData.
   void AddFile(int level, uint64_t file, uint32_t file_path_id,
                uint64_t file_size, const InternalKey& smallest,
                const InternalKey& largest, const SequenceNumber& smallest_seqno,
                const SequenceNumber& largest_seqno, bool marked_for_compaction,
                uint64_t oldest_blob_file_number, uint64_t oldest_ancester_time,
                uint64_t file_creation_time, const std::string& file_checksum,
-               const std::string& file_checksum_func_name) {
+               const std::string& file_checksum_func_name,
+               uint64_t virtual_range_size = 0) {
     assert(smallest_seqno <= largest_seqno);
     new_files_.emplace_back(
         level, FileMetaData(file, file_path_id, file_size, smallest, largest,
@@ -394,6 +410,7 @@ class VersionEdit {
                             marked_for_compaction, oldest_blob_file_number,
                             oldest_ancester_time, file_creation_time,
                             file_checksum, file_checksum_func_name));
+    new_files_.back().second.virtual_range_size = virtual_range_size;
   }
 
   void AddFile(int level, const FileMetaData& f) {
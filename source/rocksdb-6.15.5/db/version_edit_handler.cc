@@ -472,6 +472,11 @@ Status VersionEditHandler::LoadTables(ColumnFamilyData* cfd,
   if (skip_load_table_files_) {
     return Status::OK();
   }
+  if (is_initial_load && version_set_->db_options_->lazy_table_open) {
+    // The tables are opened on first access and warmed up in the background
+    // once the DB is open, see DBImpl::StartTableCacheWarming().
+    return Status::OK();
+  }
   assert(cfd != nullptr);
   assert(!cfd->IsDropped());
   auto builder_iter = builders_.find(cfd->GetID());
@@ -189,6 +189,36 @@ TEST_F(VersionEditTest, NewFile4NotSupportedField) {
   ASSERT_NOK(s);
 }
 
+TEST_F(VersionEditTest, EncodeDecodeVirtualRangeSize) {
+  static const uint64_t kBig = 1ull << 50;
+  VersionEdit edit;
+  edit.AddFile(3, 300, 0, 100, InternalKey("foo", kBig + 500, kTypeValue),
+               InternalKey("zoo", kBig + 600, kTypeDeletion), kBig + 500,
+               kBig + 600, false, kInvalidBlobFileNumber,
+               kUnknownOldestAncesterTime, kUnknownFileCreationTime,
+               kUnknownFileChecksum, kUnknownFileChecksumFuncName);
+  edit.AddFile(4, 301, 0, 100, InternalKey("foo", kBig + 501, kTypeValue),
+               InternalKey("moo", kBig + 601, kTypeValue), kBig + 501,
+               kBig + 601, false, kInvalidBlobFileNumber,
+               kUnknownOldestAncesterTime, kUnknownFileCreationTime,
+               kUnknownFileChecksum, kUnknownFileChecksumFuncName,
+               40 /* virtual_range_size */);
+  TestEncodeDecode(edit);
+
+  std::string encoded;
+  edit.EncodeTo(&encoded);
+  VersionEdit parsed;
+  Status s = parsed.DecodeFrom(encoded);
+  ASSERT_OK(s);
+  auto& new_files = parsed.GetNewFiles();
+  ASSERT_EQ(2, new_files.size());
+  ASSERT_EQ(0, new_files[0].second.virtual_range_size);
+  ASSERT_EQ(40, new_files[1].second.virtual_range_size);
+  ASSERT_EQ(100, new_files[1].second.fd.GetFileSize());
+  ASSERT_NE(std::string::npos,
+            parsed.DebugString().find("virtual_range_size:40"));
+}
+
 TEST_F(VersionEditTest, EncodeEmptyFile) {
   VersionEdit edit;
   edit.AddFile(0, 0, 0, 0, InternalKey(), InternalKey(), 0, 0, false,
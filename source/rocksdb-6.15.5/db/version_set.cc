@@ -33,6 +33,7 @@
 #include "db/merge_helper.h"
 #include "db/pinned_iterators_manager.h"
 #include "db/table_cache.h"
+#include "db/table_properties_collector.h"
 #include "db/version_builder.h"
 #include "db/version_edit_handler.h"
 #include "file/filename.h"
@@ -40,6 +41,7 @@
 #include "file/read_write_util.h"
 #include "file/writable_file_writer.h"
 #include "monitoring/file_read_sample.h"
+#include "monitoring/iostats_context_imp.h"
 #include "monitoring/perf_context_imp.h"
 #include "monitoring/persistent_stats_history.h"
 #include "rocksdb/env.h"
@@ -1787,6 +1789,7 @@ Version::Version(ColumnFamilyData* column_family_data, VersionSet* vset,
       mutable_cf_options_(mutable_cf_options),
       max_file_size_for_l0_meta_pin_(
           MaxFileSizeForL0MetaPin(mutable_cf_options_)),
+      read_triggered_compaction_hint_(false),
       version_number_(version_number),
       io_tracer_(io_tracer) {}
 
@@ -1807,6 +1810,18 @@ Status Version::GetBlob(const ReadOptions& read_options, const Slice& user_key,
     }
   }
 
+  return GetBlob(read_options, user_key, blob_index, value);
+}
+
+Status Version::GetBlob(const ReadOptions& read_options, const Slice& user_key,
+                        const BlobIndex& blob_index,
+                        PinnableSlice* value) const {
+  assert(value);
+
+  if (read_options.read_tier == kBlockCacheTier) {
+    return Status::Incomplete("Cannot read blob: no disk I/O allowed");
+  }
+
   if (blob_index.HasTTL() || blob_index.IsInlined()) {
     return Status::Corruption("Unexpected TTL/inlined blob index");
   }
@@ -1887,6 +1902,15 @@ void Version::Get(const ReadOptions& read_options, const LookupKey& k,
       user_comparator(), internal_comparator());
   FdWithKeyRange* f = fp.GetNextFile();
 
+  // The last file searched without finding the key. It is charged with a seek
+  // miss once the lookup has to go on to another file.
+  const uint64_t read_triggered_compaction_threshold =
+      mutable_cf_options_.read_triggered_compaction_threshold;
+  FileMetaData* seek_miss_file = nullptr;
+
+  // Which paths point reads go to is only of interest with several paths.
+  const bool track_path_io = cfd_->ioptions()->cf_paths.size() > 1;
+
   while (f != nullptr) {
     if (*max_covering_tombstone_seq > 0) {
       // The remaining files we look at will only contain covered keys, so we
@@ -1896,11 +1920,23 @@ void Version::Get(const ReadOptions& read_options, const LookupKey& k,
     if (get_context.sample()) {
       sample_file_read_inc(f->file_metadata);
     }
+    if (seek_miss_file != nullptr) {
+      const uint64_t seek_misses = sample_file_seek_miss_inc(seek_miss_file);
+      if (seek_misses >= read_triggered_compaction_threshold &&
+          seek_misses - kFileReadSampleRate <
+              read_triggered_compaction_threshold) {
+        read_triggered_compaction_hint_.store(true, std::memory_order_relaxed);
+      }
+      seek_miss_file = nullptr;
+    }
+    const uint64_t num_filter_useful =
+        get_context.get_context_stats_.num_filter_useful;
 
     bool timer_enabled =
         GetPerfLevel() >= PerfLevel::kEnableTimeExceptForMutex &&
         get_perf_context()->per_level_perf_context_enabled;
     StopWatchNano timer(env_, timer_enabled /* auto_start */);
+    const uint64_t bytes_read_before = track_path_io ? IOSTATS(bytes_read) : 0;
     *status = table_cache_->Get(
         read_options, *internal_comparator(), *f->file_metadata, ikey,
         &get_context, mutable_cf_options_.prefix_extractor.get(),
@@ -1908,6 +1944,10 @@ void Version::Get(const ReadOptions& read_options, const LookupKey& k,
         IsFilterSkipped(static_cast<int>(fp.GetHitFileLevel()),
                         fp.IsHitFileLastInLevel()),
         fp.GetHitFileLevel(), max_file_size_for_l0_meta_pin_);
+    if (track_path_io) {
+      cfd_->internal_stats()->AddPathUserRead(
+          f->fd.GetPathId(), IOSTATS(bytes_read) - bytes_read_before);
+    }
     // TODO: examine the behavior for corrupted key
     if (timer_enabled) {
       PERF_COUNTER_BY_LEVEL_ADD(get_from_table_nanos, timer.ElapsedNanos(),
@@ -1926,6 +1966,11 @@ void Version::Get(const ReadOptions& read_options, const LookupKey& k,
     switch (get_context.State()) {
       case GetContext::kNotFound:
         // Keep searching in other files
+        if (read_triggered_compaction_threshold > 0 && get_context.sample() &&
+            get_context.get_context_stats_.num_filter_useful ==
+                num_filter_useful) {
+          seek_miss_file = f->file_metadata;
+        }
         break;
       case GetContext::kMerge:
         // TODO: update per-level perfcontext user_key_return_count for kMerge
@@ -2262,6 +2307,12 @@ bool Version::MaybeInitializeFileMetaData(FileMetaData* file_meta) {
       file_meta->compensated_file_size > 0) {
     return false;
   }
+  if (file_meta->virtual_range_size > 0) {
+    // The table properties describe the whole shared file, and would count
+    // the entries of the other parts again.
+    file_meta->init_stats_from_file = true;
+    return false;
+  }
   std::shared_ptr<const TableProperties> tp;
   Status s = GetTableProperties(&tp, file_meta);
   file_meta->init_stats_from_file = true;
@@ -2277,6 +2328,8 @@ bool Version::MaybeInitializeFileMetaData(FileMetaData* file_meta) {
   file_meta->num_deletions = tp->num_deletions;
   file_meta->raw_value_size = tp->raw_value_size;
   file_meta->raw_key_size = tp->raw_key_size;
+  file_meta->num_long_run_tombstones =
+      GetLongRunTombstones(tp->user_collected_properties);
 
   return true;
 }
@@ -2375,7 +2428,9 @@ void VersionStorageInfo::ComputeCompensatedSizes() {
       // for files that have been created right now and no other thread has
       // access to them. That's why we can safely mutate compensated_file_size.
       if (file_meta->compensated_file_size == 0) {
-        file_meta->compensated_file_size = file_meta->fd.GetFileSize();
+        file_meta->compensated_file_size =
+            file_meta->virtual_range_size > 0 ? file_meta->virtual_range_size
+                                              : file_meta->fd.GetFileSize();
         // Here we only boost the size of deletion entries of a file only
         // when the number of deletion entries is greater than the number of
         // non-deletion entries in the file.  The motivation here is that in
@@ -2384,11 +2439,20 @@ void VersionStorageInfo::ComputeCompensatedSizes() {
         // size of deletion entries in a stable workload, the deletion
         // compensation logic might introduce unwanted effet which changes the
         // shape of LSM tree.
+        uint64_t num_boosted_deletions = 0;
         if (file_meta->num_deletions * 2 >= file_meta->num_entries) {
-          file_meta->compensated_file_size +=
-              (file_meta->num_deletions * 2 - file_meta->num_entries) *
-              average_value_size * kDeletionWeightOnCompaction;
+          num_boosted_deletions =
+              file_meta->num_deletions * 2 - file_meta->num_entries;
         }
+        // Tombstones in long runs are boosted even when deletions are a
+        // minority of the file: every iterator passing through such a range
+        // has to step over all of them, so getting them compacted away pays
+        // off regardless of the shape of the workload.
+        num_boosted_deletions = std::max(num_boosted_deletions,
+                                         file_meta->num_long_run_tombstones);
+        file_meta->compensated_file_size += num_boosted_deletions *
+                                            average_value_size *
+                                            kDeletionWeightOnCompaction;
       }
     }
   }
@@ -2516,6 +2580,66 @@ uint32_t GetExpiredTtlFilesCount(const ImmutableCFOptions& ioptions,
   }
   return ttl_expired_files_count;
 }
+
+// Universal compaction with lazy leveling: returns the largest ratio of the
+// number of sorted runs in a tier to the number of runs the tier may hold,
+// or of the size amplification to max_size_amplification_percent. A tier is
+// a sequence of consecutive sorted runs of the same tier; the oldest sorted
+// run does not belong to any.
+double GetLazyLevelingScore(const VersionStorageInfo& vstorage,
+                            const MutableCFOptions& mutable_cf_options) {
+  // Sizes of the sorted runs from the newest to the oldest, 0 for the ones
+  // being compacted
+  std::vector<uint64_t> run_sizes;
+  for (auto* f : vstorage.LevelFiles(0)) {
+    run_sizes.push_back(f->being_compacted ? 0 : f->fd.GetFileSize());
+  }
+  for (int level = 1; level < vstorage.num_levels(); level++) {
+    uint64_t total_size = 0;
+    bool being_compacted = false;
+    for (auto* f : vstorage.LevelFiles(level)) {
+      total_size += f->fd.GetFileSize();
+      being_compacted |= f->being_compacted;
+    }
+    if (total_size > 0) {
+      run_sizes.push_back(being_compacted ? 0 : total_size);
+    }
+  }
+  if (run_sizes.size() < 2) {
+    return 0;
+  }
+  const int last_tier = LazyLevelingTier(mutable_cf_options, run_sizes.back());
+  auto tier_of = [&](size_t i) {
+    return std::min(LazyLevelingTier(mutable_cf_options, run_sizes[i]),
+                    last_tier);
+  };
+  uint64_t newer_runs_size = 0;
+  for (size_t i = 0; i + 1 < run_sizes.size(); i++) {
+    newer_runs_size += run_sizes[i];
+  }
+  double score =
+      static_cast<double>(newer_runs_size) * 100 /
+      std::max<uint64_t>(run_sizes.back(), 1) /
+      std::max(mutable_cf_options.compaction_options_universal
+                   .max_size_amplification_percent,
+               1U);
+  for (size_t i = 0; i + 1 < run_sizes.size();) {
+    if (run_sizes[i] == 0) {
+      i++;
+      continue;
+    }
+    const int tier = tier_of(i);
+    size_t j = i + 1;
+    while (j + 1 < run_sizes.size() && run_sizes[j] != 0 && tier_of(j) == tier) {
+      j++;
+    }
+    score = std::max(score, static_cast<double>(j - i) /
+                                LazyLevelingMaxRunsInTier(mutable_cf_options,
+                                                          tier));
+    i = j;
+  }
+  return score;
+}
 }  // anonymous namespace
 
 void VersionStorageInfo::ComputeCompactionScore(
@@ -2575,6 +2699,10 @@ void VersionStorageInfo::ComputeCompactionScore(
               score);
         }
 
+      } else if (compaction_style_ == kCompactionStyleUniversal &&
+                 mutable_cf_options.compaction_options_universal
+                     .lazy_leveling) {
+        score = GetLazyLevelingScore(*this, mutable_cf_options);
       } else {
         score = static_cast<double>(num_sorted_runs) /
                 mutable_cf_options.level0_file_num_compaction_trigger;
@@ -2637,9 +2765,147 @@ void VersionStorageInfo::ComputeCompactionScore(
     ComputeFilesMarkedForPeriodicCompaction(
         immutable_cf_options, mutable_cf_options.periodic_compaction_seconds);
   }
+  if (mutable_cf_options.enable_blob_garbage_collection) {
+    ComputeFilesMarkedForForcedBlobGC(
+        mutable_cf_options.blob_garbage_collection_force_threshold);
+  } else {
+    files_marked_for_forced_blob_gc_.clear();
+  }
+  ComputeFilesMarkedForReadTriggeredCompaction(
+      mutable_cf_options.read_triggered_compaction_threshold);
+  ComputeFilesMarkedForTemperatureMigration(
+      immutable_cf_options, mutable_cf_options.cold_data_age_seconds);
   EstimateCompactionBytesNeeded(mutable_cf_options);
 }
 
+void VersionStorageInfo::ComputeFilesMarkedForForcedBlobGC(
+    double blob_garbage_collection_force_threshold) {
+  files_marked_for_forced_blob_gc_.clear();
+
+  if (blob_garbage_collection_force_threshold >= 1.0) {
+    return;
+  }
+
+  for (const auto& pair : blob_files_) {
+    const auto& meta = pair.second;
+    assert(meta);
+
+    const uint64_t total_bytes = meta->GetTotalBlobBytes();
+    if (total_bytes == 0 ||
+        static_cast<double>(meta->GetGarbageBlobBytes()) <
+            blob_garbage_collection_force_threshold *
+                static_cast<double>(total_bytes)) {
+      continue;
+    }
+
+    for (uint64_t sst_file_number : meta->GetLinkedSsts()) {
+      const FileLocation location = GetFileLocation(sst_file_number);
+      if (!location.IsValid()) {
+        assert(false);
+        continue;
+      }
+
+      const int level = location.GetLevel();
+      FileMetaData* const f = files_[level][location.GetPosition()];
+      assert(f);
+
+      if (!f->being_compacted) {
+        files_marked_for_forced_blob_gc_.emplace_back(level, f);
+      }
+    }
+  }
+}
+
+void VersionStorageInfo::ComputeFilesMarkedForReadTriggeredCompaction(
+    uint64_t read_triggered_compaction_threshold) {
+  files_marked_for_read_triggered_compaction_.clear();
+  if (read_triggered_compaction_threshold == 0 ||
+      compaction_style_ != kCompactionStyleLevel) {
+    return;
+  }
+
+  int last_qualify_level = -1;
+  for (int level = num_levels() - 1; level >= 1; level--) {
+    if (!files_[level].empty()) {
+      last_qualify_level = level - 1;
+      break;
+    }
+  }
+
+  for (int level = 0; level <= last_qualify_level; level++) {
+    for (auto* f : files_[level]) {
+      if (!f->being_compacted &&
+          f->stats.num_seek_misses_sampled.load(std::memory_order_relaxed) >=
+              read_triggered_compaction_threshold) {
+        files_marked_for_read_triggered_compaction_.emplace_back(level, f);
+      }
+    }
+  }
+}
+
+void VersionStorageInfo::ComputeFilesMarkedForTemperatureMigration(
+    const ImmutableCFOptions& ioptions, uint64_t cold_data_age_seconds) {
+  files_marked_for_temperature_migration_.clear();
+  reads_per_byte_ = 0;
+  if (cold_data_age_seconds == 0 || ioptions.cf_paths.size() <= 1 ||
+      compaction_style_ != kCompactionStyleLevel) {
+    return;
+  }
+
+  uint64_t total_reads = 0;
+  uint64_t total_size = 0;
+  for (int level = 0; level < num_levels(); level++) {
+    for (auto* f : files_[level]) {
+      total_reads += f->stats.num_reads_sampled.load(std::memory_order_relaxed);
+      total_size += f->fd.GetFileSize();
+    }
+  }
+  if (total_size > 0) {
+    reads_per_byte_ = static_cast<double>(total_reads) / total_size;
+  }
+
+  int64_t temp_current_time;
+  if (!ioptions.env->GetCurrentTime(&temp_current_time).ok()) {
+    return;
+  }
+  const uint64_t current_time = static_cast<uint64_t>(temp_current_time);
+  const uint32_t last_path_id =
+      static_cast<uint32_t>(ioptions.cf_paths.size() - 1);
+  for (int level = 0; level < num_levels(); level++) {
+    for (auto* f : files_[level]) {
+      if (f->being_compacted || f->fd.GetPathId() >= last_path_id) {
+        continue;
+      }
+      if (GetDataTemperature(
+              f->stats.num_reads_sampled.load(std::memory_order_relaxed),
+              f->fd.GetFileSize(), f->TryGetOldestAncesterTime(),
+              current_time,
+              cold_data_age_seconds) == DataTemperature::kCold) {
+        files_marked_for_temperature_migration_.emplace_back(level, f);
+      }
+    }
+  }
+}
+
+VersionStorageInfo::DataTemperature VersionStorageInfo::GetDataTemperature(
+    uint64_t num_reads_sampled, uint64_t data_size,
+    uint64_t oldest_ancester_time, uint64_t current_time,
+    uint64_t cold_data_age_seconds) const {
+  // Data read at least twice as often per byte as the column family is hot.
+  if (num_reads_sampled > 0 &&
+      static_cast<double>(num_reads_sampled) >=
+          2 * reads_per_byte_ * static_cast<double>(data_size)) {
+    return DataTemperature::kHot;
+  }
+  if (cold_data_age_seconds > 0 &&
+      oldest_ancester_time != kUnknownOldestAncesterTime &&
+      oldest_ancester_time <= current_time &&
+      current_time - oldest_ancester_time >= cold_data_age_seconds) {
+    return DataTemperature::kCold;
+  }
+  return DataTemperature::kWarm;
+}
+
 void VersionStorageInfo::ComputeFilesMarkedForCompaction() {
   files_marked_for_compaction_.clear();
   int last_qualify_level = 0;
@@ -5247,7 +5513,8 @@ Status VersionSet::WriteCurrentStateToManifest(
                        f->fd.smallest_seqno, f->fd.largest_seqno,
                        f->marked_for_compaction, f->oldest_blob_file_number,
                        f->oldest_ancester_time, f->file_creation_time,
-                       f->file_checksum, f->file_checksum_func_name);
+                       f->file_checksum, f->file_checksum_func_name,
+                       f->virtual_range_size);
         }
       }
 
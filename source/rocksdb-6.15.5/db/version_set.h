@@ -59,6 +59,7 @@ namespace log {
 class Writer;
 }
 
+class BlobIndex;
 class Compaction;
 class LogBuffer;
 class LookupKey;
@@ -168,6 +169,52 @@ class VersionStorageInfo {
       const ImmutableCFOptions& ioptions,
       const uint64_t periodic_compaction_seconds);
 
+  // This computes files_marked_for_forced_blob_gc_ and is called by
+  // ComputeCompactionScore()
+  //
+  // Marks the table files linked to blob files whose garbage ratio has
+  // reached blob_garbage_collection_force_threshold, so that compacting them
+  // relocates the remaining valid blobs and lets the blob files be dropped.
+  void ComputeFilesMarkedForForcedBlobGC(
+      double blob_garbage_collection_force_threshold);
+
+  // This computes files_marked_for_read_triggered_compaction_ and is called
+  // by ComputeCompactionScore(), or by the DB when a lookup pushed a file
+  // over the threshold.
+  //
+  // Marks the files whose sampled seek misses reached
+  // read_triggered_compaction_threshold. Files on the last non-empty level
+  // are skipped, as moving them down would not remove any overlap.
+  void ComputeFilesMarkedForReadTriggeredCompaction(
+      uint64_t read_triggered_compaction_threshold);
+
+  // This computes files_marked_for_temperature_migration_ and
+  // reads_per_byte_, and is called by ComputeCompactionScore().
+  //
+  // Marks the files whose data is cold but which are not on the last path
+  // yet, see cold_data_age_seconds.
+  void ComputeFilesMarkedForTemperatureMigration(
+      const ImmutableCFOptions& ioptions, uint64_t cold_data_age_seconds);
+
+  // The temperature of data, which decides the path compaction outputs are
+  // placed on when cold_data_age_seconds is set.
+  enum class DataTemperature {
+    kWarm,
+    kHot,
+    kCold,
+  };
+
+  // Returns the temperature of data of `data_size` bytes read by
+  // `num_reads_sampled` sampled lookups, whose newest file has the given
+  // oldest ancester time (kUnknownOldestAncesterTime if any is unknown).
+  // REQUIRES: ComputeFilesMarkedForTemperatureMigration() has run with the
+  // same cold_data_age_seconds.
+  DataTemperature GetDataTemperature(uint64_t num_reads_sampled,
+                                     uint64_t data_size,
+                                     uint64_t oldest_ancester_time,
+                                     uint64_t current_time,
+                                     uint64_t cold_data_age_seconds) const;
+
   // This computes bottommost_files_marked_for_compaction_ and is called by
   // ComputeCompactionScore() or UpdateOldestSnapshot().
   //
@@ -379,6 +426,30 @@ class VersionStorageInfo {
     files_marked_for_periodic_compaction_.emplace_back(level, f);
   }
 
+  // REQUIRES: This version has been saved (see VersionSet::SaveTo)
+  // REQUIRES: DB mutex held during access
+  const autovector<std::pair<int, FileMetaData*>>& FilesMarkedForForcedBlobGC()
+      const {
+    assert(finalized_);
+    return files_marked_for_forced_blob_gc_;
+  }
+
+  // REQUIRES: This version has been saved (see VersionSet::SaveTo)
+  // REQUIRES: DB mutex held during access
+  const autovector<std::pair<int, FileMetaData*>>&
+  FilesMarkedForReadTriggeredCompaction() const {
+    assert(finalized_);
+    return files_marked_for_read_triggered_compaction_;
+  }
+
+  // REQUIRES: This version has been saved (see VersionSet::SaveTo)
+  // REQUIRES: DB mutex held during access
+  const autovector<std::pair<int, FileMetaData*>>&
+  FilesMarkedForTemperatureMigration() const {
+    assert(finalized_);
+    return files_marked_for_temperature_migration_;
+  }
+
   // REQUIRES: This version has been saved (see VersionSet::SaveTo)
   // REQUIRES: DB mutex held during access
   const autovector<std::pair<int, FileMetaData*>>&
@@ -559,6 +630,27 @@ class VersionStorageInfo {
   autovector<std::pair<int, FileMetaData*>>
       files_marked_for_periodic_compaction_;
 
+  // Table files linked to blob files with enough garbage to force their
+  // collection. Protected by DB mutex and calculated in
+  // ComputeCompactionScore().
+  autovector<std::pair<int, FileMetaData*>> files_marked_for_forced_blob_gc_;
+
+  // Files whose sampled seek misses reached
+  // read_triggered_compaction_threshold. Protected by DB mutex and calculated
+  // in ComputeFilesMarkedForReadTriggeredCompaction().
+  autovector<std::pair<int, FileMetaData*>>
+      files_marked_for_read_triggered_compaction_;
+
+  // Files with cold data that are not on the last path. Protected by DB mutex
+  // and calculated in ComputeFilesMarkedForTemperatureMigration().
+  autovector<std::pair<int, FileMetaData*>>
+      files_marked_for_temperature_migration_;
+
+  // Sampled reads per byte over all files of the column family, the baseline
+  // hot data is measured against. Calculated in
+  // ComputeFilesMarkedForTemperatureMigration().
+  double reads_per_byte_ = 0;
+
   // These files are considered bottommost because none of their keys can exist
   // at lower levels. They are not necessarily all in the same level. The marked
   // ones are eligible for compaction because they contain duplicate key
@@ -682,6 +774,19 @@ class Version {
   void MultiGet(const ReadOptions&, MultiGetRange* range,
                 ReadCallback* callback = nullptr, bool* is_blob = nullptr);
 
+  // Interprets *value as a blob reference, and (assuming the corresponding
+  // blob file is part of this Version) retrieves the blob and saves it in
+  // *value, replacing the blob reference.
+  // REQUIRES: *value stores an encoded blob reference
+  Status GetBlob(const ReadOptions& read_options, const Slice& user_key,
+                 PinnableSlice* value) const;
+
+  // Retrieves the blob referenced by the already decoded blob_index (assuming
+  // the corresponding blob file is part of this Version) and saves it in
+  // *value.
+  Status GetBlob(const ReadOptions& read_options, const Slice& user_key,
+                 const BlobIndex& blob_index, PinnableSlice* value) const;
+
   // Loads some stats information from files. Call without mutex held. It needs
   // to be called before applying the version to the version set.
   void PrepareApply(const MutableCFOptions& mutable_cf_options,
@@ -750,6 +855,7 @@ class Version {
   int TEST_refs() const { return refs_; }
 
   VersionStorageInfo* storage_info() { return &storage_info_; }
+  const VersionStorageInfo* storage_info() const { return &storage_info_; }
 
   VersionSet* version_set() { return vset_; }
 
@@ -763,6 +869,16 @@ class Version {
 
   const MutableCFOptions& GetMutableCFOptions() { return mutable_cf_options_; }
 
+  // Returns true, at most once per event, if a Get() on this version pushed
+  // a file over read_triggered_compaction_threshold. The caller is expected
+  // to recompute the files marked for read-triggered compaction and schedule
+  // a compaction.
+  bool TakeReadTriggeredCompactionHint() {
+    return read_triggered_compaction_hint_.load(std::memory_order_relaxed) &&
+           read_triggered_compaction_hint_.exchange(false,
+                                                    std::memory_order_relaxed);
+  }
+
  private:
   Env* env_;
   friend class ReactiveVersionSet;
@@ -777,13 +893,6 @@ class Version {
     return storage_info_.user_comparator_;
   }
 
-  // Interprets *value as a blob reference, and (assuming the corresponding
-  // blob file is part of this Version) retrieves the blob and saves it in
-  // *value, replacing the blob reference.
-  // REQUIRES: *value stores an encoded blob reference
-  Status GetBlob(const ReadOptions& read_options, const Slice& user_key,
-                 PinnableSlice* value) const;
-
   // Returns true if the filter blocks in the specified level will not be
   // checked during read operations. In certain cases (trivial move or preload),
   // the filter block may already be cached, but we still do not access it such
@@ -820,6 +929,9 @@ class Version {
   const MutableCFOptions mutable_cf_options_;
   // Cached value to avoid recomputing it on every read.
   const size_t max_file_size_for_l0_meta_pin_;
+  // Set by Get() when a file's sampled seek misses cross
+  // read_triggered_compaction_threshold.
+  std::atomic<bool> read_triggered_compaction_hint_;
 
   // A version number that uniquely represents this version. This is
   // used for debugging and logging purposes only.
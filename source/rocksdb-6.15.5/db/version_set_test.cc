@@ -388,6 +388,38 @@ TEST_F(VersionStorageInfoTest, EstimateLiveDataSize2) {
   ASSERT_EQ(4U, vstorage_.EstimateLiveDataSize());
 }
 
+TEST_F(VersionStorageInfoTest, CompensatedSizeChargesLongTombstoneRuns) {
+  // Every file has 90 live values of 10 bytes and no key bytes, so the
+  // average value size is 10.
+  auto add_file = [&](uint32_t file_number, const char* smallest,
+                      const char* largest, uint64_t num_deletions,
+                      uint64_t num_long_run_tombstones) {
+    Add(1, file_number, smallest, largest, 900U);
+    FileMetaData* f = vstorage_.LevelFiles(1).back();
+    f->compensated_file_size = 0;
+    f->num_entries = 90 + num_deletions;
+    f->num_deletions = num_deletions;
+    f->num_long_run_tombstones = num_long_run_tombstones;
+    f->raw_value_size = 900;
+    f->init_stats_from_file = true;
+    vstorage_.UpdateAccumulatedStats(f);
+  };
+  add_file(1U, "a", "b", 10, 0);
+  add_file(2U, "c", "d", 10, 10);
+  add_file(3U, "e", "f", 210, 200);
+  vstorage_.ComputeCompensatedSizes();
+
+  ASSERT_EQ(10U, vstorage_.GetAverageValueSize());
+  const auto& files = vstorage_.LevelFiles(1);
+  // Deletions are a minority and not in long runs.
+  ASSERT_EQ(900U, files[0]->compensated_file_size);
+  // Tombstones in long runs are charged even though they are a minority.
+  ASSERT_EQ(900U + 10 * 10 * 2, files[1]->compensated_file_size);
+  // The larger of the two boosts applies: 200 tombstones in long runs
+  // outweigh the 420 - 300 = 120 excess deletions.
+  ASSERT_EQ(900U + 200 * 10 * 2, files[2]->compensated_file_size);
+}
+
 TEST_F(VersionStorageInfoTest, GetOverlappingInputs) {
   // Two files that overlap at the range deletion tombstone sentinel.
   Add(1, 1U, {"a", 0, kTypeValue}, {"b", kMaxSequenceNumber, kTypeRangeDeletion}, 1);
@@ -305,6 +305,11 @@ DEFINE_int32(
     "Type of pinning for unpartitioned metadata blocks (see `enum PinningTier` "
     "in table.h)");
 
+DEFINE_int32(max_pinned_level,
+             ROCKSDB_NAMESPACE::MetadataCacheOptions().max_pinned_level,
+             "Highest level whose tables are in "
+             "`PinningTier::kUpToMaxPinnedLevel`");
+
 DEFINE_bool(use_clock_cache, false,
             "Replace default LRU block cache with clock cache.");
 
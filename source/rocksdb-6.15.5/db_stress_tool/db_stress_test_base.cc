@@ -1975,6 +1975,8 @@ void StressTest::Open() {
         static_cast<PinningTier>(FLAGS_partition_pinning);
     block_based_options.metadata_cache_options.unpartitioned_pinning =
         static_cast<PinningTier>(FLAGS_unpartitioned_pinning);
+    block_based_options.metadata_cache_options.max_pinned_level =
+        FLAGS_max_pinned_level;
     block_based_options.block_cache_compressed = compressed_cache_;
     block_based_options.checksum = checksum_type_e;
     block_based_options.block_size = FLAGS_block_size;
@@ -1356,6 +1356,181 @@ TEST_F(EnvPosixTest, MultiReadNonAlignedLargeNum) {
   }
 }
 
+TEST_F(EnvPosixTest, AsyncAppendAndRead) {
+  std::shared_ptr<FileSystem> fs = FileSystem::Default();
+  std::string fname = test::PerThreadDBPath(env_, "testfile");
+  const size_t kChunkSize = 4096;
+  const size_t kNumChunks = 32;
+  Random rnd(301);
+  std::string expected_data = rnd.RandomString(kChunkSize * kNumChunks);
+  auto chunk = [&](size_t i) {
+    return Slice(expected_data.data() + i * kChunkSize, kChunkSize);
+  };
+
+  // The first and last chunks are appended synchronously, around the
+  // asynchronous ones.
+  {
+    std::unique_ptr<FSWritableFile> wfile;
+    ASSERT_OK(fs->NewWritableFile(fname, FileOptions(), &wfile, nullptr));
+    ASSERT_OK(wfile->Append(chunk(0), IOOptions(), nullptr));
+    std::vector<void*> io_handles;
+    std::vector<IOHandleDeleter> del_fns;
+    size_t num_callbacks = 0;
+    for (size_t i = 1; i + 1 < kNumChunks; i++) {
+      void* io_handle = nullptr;
+      IOHandleDeleter del_fn;
+      ASSERT_OK(wfile->AppendAsync(
+          chunk(i), IOOptions(),
+          [&](const IOStatus& s, void* /*arg*/) {
+            EXPECT_OK(s);
+            num_callbacks++;
+          },
+          nullptr, &io_handle, &del_fn, nullptr));
+      io_handles.push_back(io_handle);
+      del_fns.push_back(del_fn);
+    }
+    ASSERT_OK(fs->Poll(io_handles, io_handles.size()));
+    ASSERT_EQ(kNumChunks - 2, num_callbacks);
+    // The callbacks only run once.
+    ASSERT_OK(fs->Poll(io_handles, io_handles.size()));
+    ASSERT_EQ(kNumChunks - 2, num_callbacks);
+    for (size_t i = 0; i < io_handles.size(); i++) {
+      if (del_fns[i]) {
+        del_fns[i](io_handles[i]);
+      }
+    }
+    ASSERT_OK(wfile->Append(chunk(kNumChunks - 1), IOOptions(), nullptr));
+    ASSERT_EQ(expected_data.size(), wfile->GetFileSize(IOOptions(), nullptr));
+    ASSERT_OK(wfile->Close(IOOptions(), nullptr));
+  }
+
+  // Read the chunks back in reverse order, plus a read crossing the end of
+  // the file.
+  std::unique_ptr<FSRandomAccessFile> file;
+  ASSERT_OK(fs->NewRandomAccessFile(fname, FileOptions(), &file, nullptr));
+  std::string scratch((kNumChunks + 1) * kChunkSize, '\0');
+  std::vector<FSReadRequest> reqs(kNumChunks + 1);
+  std::vector<void*> io_handles;
+  std::vector<IOHandleDeleter> del_fns;
+  for (size_t i = 0; i < reqs.size(); i++) {
+    FSReadRequest req;
+    req.offset = i == 0 ? expected_data.size() - kChunkSize / 2
+                        : (kNumChunks - i) * kChunkSize;
+    req.len = kChunkSize;
+    req.scratch = &scratch[i * kChunkSize];
+    void* io_handle = nullptr;
+    IOHandleDeleter del_fn;
+    ASSERT_OK(file->ReadAsync(
+        req, IOOptions(),
+        [&reqs](const FSReadRequest& r, void* arg) {
+          reqs[reinterpret_cast<size_t>(arg)] = r;
+        },
+        reinterpret_cast<void*>(i), &io_handle, &del_fn, nullptr));
+    io_handles.push_back(io_handle);
+    del_fns.push_back(del_fn);
+  }
+  ASSERT_OK(fs->Poll(io_handles, io_handles.size()));
+  ASSERT_OK(reqs[0].status);
+  ASSERT_EQ(Slice(expected_data.data() + expected_data.size() - kChunkSize / 2,
+                  kChunkSize / 2),
+            reqs[0].result);
+  for (size_t i = 1; i < reqs.size(); i++) {
+    ASSERT_OK(reqs[i].status);
+    ASSERT_EQ(chunk(kNumChunks - i), reqs[i].result);
+  }
+  for (size_t i = 0; i < io_handles.size(); i++) {
+    if (del_fns[i]) {
+      del_fns[i](io_handles[i]);
+    }
+  }
+}
+
+// Measures the throughput of random 4KB reads of a file against the number
+// of ReadAsync() calls kept in flight.
+TEST_F(EnvPosixTest, ReadAsyncQueueDepth) {
+  std::shared_ptr<FileSystem> fs = FileSystem::Default();
+  std::string fname = test::PerThreadDBPath(env_, "testfile");
+  const size_t kBlockSize = 4096;
+  const size_t kFileSize = 16 << 20;
+  const int kNumReads = 2048;
+  {
+    std::unique_ptr<FSWritableFile> wfile;
+    ASSERT_OK(fs->NewWritableFile(fname, FileOptions(), &wfile, nullptr));
+    Random rnd(301);
+    std::string block = rnd.RandomString(1 << 20);
+    for (size_t i = 0; i < kFileSize; i += block.size()) {
+      ASSERT_OK(wfile->Append(block, IOOptions(), nullptr));
+    }
+    ASSERT_OK(wfile->Close(IOOptions(), nullptr));
+  }
+
+  struct Slot {
+    std::string scratch;
+    void* io_handle = nullptr;
+    IOHandleDeleter del_fn;
+    bool busy = false;
+  };
+  for (size_t depth : {1, 4, 16, 64}) {
+    std::unique_ptr<FSRandomAccessFile> file;
+    ASSERT_OK(fs->NewRandomAccessFile(fname, FileOptions(), &file, nullptr));
+    // Drop the file from the page cache, where it is after being written.
+    file->InvalidateCache(0, 0).PermitUncheckedError();
+    std::vector<Slot> slots(depth);
+    int num_issued = 0;
+    int num_completed = 0;
+    Random rnd(static_cast<uint32_t>(depth));
+    auto cb = [&](const FSReadRequest& r, void* arg) {
+      EXPECT_OK(r.status);
+      EXPECT_EQ(kBlockSize, r.result.size());
+      slots[reinterpret_cast<size_t>(arg)].busy = false;
+      num_completed++;
+    };
+    uint64_t start = env_->NowMicros();
+    while (num_completed < kNumReads) {
+      std::vector<void*> io_handles;
+      for (size_t i = 0; i < depth; i++) {
+        Slot& slot = slots[i];
+        if (!slot.busy) {
+          if (slot.del_fn) {
+            slot.del_fn(slot.io_handle);
+            slot.del_fn = nullptr;
+          }
+          slot.io_handle = nullptr;
+          if (num_issued == kNumReads) {
+            continue;
+          }
+          slot.scratch.resize(kBlockSize);
+          FSReadRequest req;
+          req.offset =
+              rnd.Uniform(static_cast<int>(kFileSize / kBlockSize)) *
+              kBlockSize;
+          req.len = kBlockSize;
+          req.scratch = &slot.scratch[0];
+          slot.busy = true;
+          num_issued++;
+          ASSERT_OK(file->ReadAsync(req, IOOptions(), cb,
+                                    reinterpret_cast<void*>(i),
+                                    &slot.io_handle, &slot.del_fn, nullptr));
+        }
+        if (slot.busy) {
+          io_handles.push_back(slot.io_handle);
+        }
+      }
+      ASSERT_OK(fs->Poll(io_handles, 1));
+    }
+    uint64_t elapsed = std::max<uint64_t>(env_->NowMicros() - start, 1);
+    for (Slot& slot : slots) {
+      if (slot.del_fn) {
+        slot.del_fn(slot.io_handle);
+      }
+    }
+    fprintf(stderr, "queue depth %3d: %8.1f MB/s, %8.0f reads/s\n",
+            static_cast<int>(depth),
+            1.0 * kNumReads * kBlockSize / elapsed,
+            1e6 * kNumReads / elapsed);
+  }
+}
+
 // Only works in linux platforms
 #ifdef OS_WIN
 TEST_P(EnvPosixTestWithParam, DISABLED_InvalidateCache) {
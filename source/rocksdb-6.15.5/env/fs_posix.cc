@@ -256,7 +256,7 @@ class PosixFileSystem : public FileSystem {
       }
       result->reset(new PosixRandomAccessFile(
           fname, fd, GetLogicalBlockSizeForReadIfNeeded(options, fname, fd),
-          options
+          options, &async_io_
 #if defined(ROCKSDB_IOURING_PRESENT)
           ,
           thread_local_io_urings_.get()
@@ -344,7 +344,7 @@ class PosixFileSystem : public FileSystem {
 #endif
       result->reset(new PosixWritableFile(
           fname, fd, GetLogicalBlockSizeForWriteIfNeeded(options, fname, fd),
-          options));
+          options, &async_io_));
     } else {
       // disable mmap writes
       EnvOptions no_mmap_writes_options = options;
@@ -353,7 +353,7 @@ class PosixFileSystem : public FileSystem {
           new PosixWritableFile(fname, fd,
                                 GetLogicalBlockSizeForWriteIfNeeded(
                                     no_mmap_writes_options, fname, fd),
-                                no_mmap_writes_options));
+                                no_mmap_writes_options, &async_io_));
     }
     return s;
   }
@@ -450,7 +450,7 @@ class PosixFileSystem : public FileSystem {
 #endif
       result->reset(new PosixWritableFile(
           fname, fd, GetLogicalBlockSizeForWriteIfNeeded(options, fname, fd),
-          options));
+          options, &async_io_));
     } else {
       // disable mmap writes
       FileOptions no_mmap_writes_options = options;
@@ -459,7 +459,7 @@ class PosixFileSystem : public FileSystem {
           new PosixWritableFile(fname, fd,
                                 GetLogicalBlockSizeForWriteIfNeeded(
                                     no_mmap_writes_options, fname, fd),
-                                no_mmap_writes_options));
+                                no_mmap_writes_options, &async_io_));
     }
     return s;
   }
@@ -898,6 +898,11 @@ class PosixFileSystem : public FileSystem {
     return io_s;
   }
 
+  IOStatus Poll(std::vector<void*>& io_handles,
+                size_t min_completions) override {
+    return async_io_.Poll(io_handles, min_completions);
+  }
+
   FileOptions OptimizeForLogWrite(const FileOptions& file_options,
                                  const DBOptions& db_options) const override {
     FileOptions optimized = file_options;
@@ -970,6 +975,9 @@ class PosixFileSystem : public FileSystem {
   std::unique_ptr<ThreadLocalPtr> thread_local_io_urings_;
 #endif
 
+  // Runs the asynchronous reads and appends of the files.
+  PosixAsyncIO async_io_;
+
   size_t page_size_;
 
   // If true, allow non owner read access for db files. Otherwise, non-owner
@@ -534,6 +534,225 @@ size_t PosixHelper::GetLogicalBlockSizeOfFd(int fd) {
   return kDefaultPageSize;
 }
 
+/*
+ * PosixAsyncIO
+ */
+PosixAsyncIO::PosixAsyncIO() {
+#if defined(ROCKSDB_IOURING_PRESENT)
+  struct io_uring* new_io_uring = CreateIOUring();
+  if (new_io_uring != nullptr) {
+    thread_local_io_urings_.reset(new ThreadLocalPtr(DeleteIOUring));
+    delete new_io_uring;
+  }
+#endif
+}
+
+PosixAsyncIO::~PosixAsyncIO() {
+  if (thread_pool_ != nullptr) {
+    thread_pool_->WaitForJobsAndJoinAllThreads();
+  }
+}
+
+void PosixAsyncIO::Submit(PosixIOHandle* handle) {
+  if (handle->len == 0) {
+    MutexLock l(&handle->mu);
+    handle->done = true;
+    return;
+  }
+#if defined(ROCKSDB_IOURING_PRESENT)
+  struct io_uring* iu = GetIOUring();
+  if (iu != nullptr) {
+    struct io_uring_sqe* sqe = io_uring_get_sqe(iu);
+    if (sqe != nullptr) {
+      handle->iu = iu;
+      if (handle->is_read) {
+        handle->iov.iov_base = handle->scratch;
+        handle->iov.iov_len = handle->len;
+        io_uring_prep_readv(sqe, handle->fd, &handle->iov, 1, handle->offset);
+      } else {
+        handle->iov.iov_base = const_cast<char*>(handle->data);
+        handle->iov.iov_len = handle->len;
+        io_uring_prep_writev(sqe, handle->fd, &handle->iov, 1,
+                             handle->offset);
+      }
+      io_uring_sqe_set_data(sqe, handle);
+      if (io_uring_submit(iu) >= 0) {
+        return;
+      }
+      handle->iu = nullptr;
+    }
+    // The ring is full, or failed: do the I/O on the thread pool.
+  }
+#endif
+  ThreadPool* thread_pool;
+  {
+    MutexLock l(&mu_);
+    if (thread_pool_ == nullptr) {
+      thread_pool_.reset(NewThreadPool(kNumThreads));
+    }
+    thread_pool = thread_pool_.get();
+  }
+  thread_pool->SubmitJob([handle]() {
+    Run(handle);
+    MutexLock l(&handle->mu);
+    handle->done = true;
+    handle->cv.SignalAll();
+  });
+}
+
+IOStatus PosixAsyncIO::Poll(std::vector<void*>& io_handles,
+                            size_t min_completions) {
+#if defined(ROCKSDB_IOURING_PRESENT)
+  struct io_uring* iu = GetIOUring();
+  if (iu != nullptr) {
+    Reap(iu, false /* wait */);
+  }
+#endif
+  // Run the callbacks of the I/Os that already completed first, and only
+  // wait for more if that is not enough.
+  size_t num_completed = 0;
+  for (void* io_handle : io_handles) {
+    PosixIOHandle* handle = static_cast<PosixIOHandle*>(io_handle);
+    if (handle == nullptr || IsDone(handle)) {
+      if (handle != nullptr) {
+        RunCallback(handle);
+      }
+      num_completed++;
+    }
+  }
+  for (void* io_handle : io_handles) {
+    if (num_completed >= min_completions) {
+      break;
+    }
+    PosixIOHandle* handle = static_cast<PosixIOHandle*>(io_handle);
+    if (handle != nullptr && !handle->callback_done) {
+      Wait(handle);
+      RunCallback(handle);
+      num_completed++;
+    }
+  }
+  return IOStatus::OK();
+}
+
+void PosixAsyncIO::Run(PosixIOHandle* handle) {
+  size_t left = handle->len - handle->finished_len;
+  if (left == 0) {
+    return;
+  }
+  if (handle->is_read) {
+    if (handle->use_direct_io &&
+        !IsSectorAligned(handle->finished_len, handle->alignment)) {
+      // Bytes reads don't fill sectors. Should only happen at the end
+      // of the file.
+      return;
+    }
+    Slice result;
+    handle->status = handle->file->Read(
+        handle->offset + handle->finished_len, left, IOOptions(), &result,
+        handle->scratch + handle->finished_len, nullptr /* dbg */);
+    if (handle->status.ok()) {
+      handle->finished_len += result.size();
+    }
+  } else {
+    if (PosixPositionedWrite(
+            handle->fd, handle->data + handle->finished_len, left,
+            static_cast<off_t>(handle->offset + handle->finished_len))) {
+      handle->finished_len = handle->len;
+    } else {
+      handle->status =
+          IOError("While appending asynchronously to file at offset " +
+                      ToString(handle->offset),
+                  *handle->filename, errno);
+    }
+  }
+}
+
+bool PosixAsyncIO::IsDone(PosixIOHandle* handle) {
+  MutexLock l(&handle->mu);
+  return handle->done;
+}
+
+void PosixAsyncIO::Wait(PosixIOHandle* handle) {
+#if defined(ROCKSDB_IOURING_PRESENT)
+  if (handle->iu != nullptr) {
+    // Only the submitting thread reaps its ring.
+    assert(handle->iu == GetIOUring());
+    while (!IsDone(handle)) {
+      Reap(handle->iu, true /* wait */);
+    }
+    return;
+  }
+#endif
+  MutexLock l(&handle->mu);
+  while (!handle->done) {
+    handle->cv.Wait();
+  }
+}
+
+void PosixAsyncIO::RunCallback(PosixIOHandle* handle) {
+  if (handle->callback_done) {
+    return;
+  }
+  handle->callback_done = true;
+  if (handle->is_read) {
+    FSReadRequest req;
+    req.offset = handle->offset;
+    req.len = handle->len;
+    req.scratch = handle->scratch;
+    req.result = Slice(handle->scratch, handle->finished_len);
+    req.status = handle->status;
+    handle->read_cb(req, handle->cb_arg);
+  } else {
+    handle->append_cb(handle->status, handle->cb_arg);
+  }
+}
+
+#if defined(ROCKSDB_IOURING_PRESENT)
+struct io_uring* PosixAsyncIO::GetIOUring() {
+  if (thread_local_io_urings_ == nullptr) {
+    return nullptr;
+  }
+  struct io_uring* iu =
+      static_cast<struct io_uring*>(thread_local_io_urings_->Get());
+  if (iu == nullptr) {
+    iu = CreateIOUring();
+    if (iu != nullptr) {
+      thread_local_io_urings_->Reset(iu);
+    }
+  }
+  return iu;
+}
+
+void PosixAsyncIO::Reap(struct io_uring* iu, bool wait) {
+  struct io_uring_cqe* cqe = nullptr;
+  int ret = wait ? io_uring_wait_cqe(iu, &cqe) : io_uring_peek_cqe(iu, &cqe);
+  while (ret == 0 && cqe != nullptr) {
+    PosixIOHandle* handle =
+        static_cast<PosixIOHandle*>(io_uring_cqe_get_data(cqe));
+    int res = cqe->res;
+    io_uring_cqe_seen(iu, cqe);
+    if (res < 0) {
+      handle->status = IOError(handle->is_read ? "While reading asynchronously"
+                                               : "While appending asynchronously",
+                               *handle->filename, -res);
+    } else {
+      size_t bytes = static_cast<size_t>(res);
+      TEST_SYNC_POINT_CALLBACK("PosixAsyncIO::Reap:io_uring_result", &bytes);
+      handle->finished_len = bytes;
+      // A short read may be the end of the file or a partial result, see
+      // MultiRead(); the rest is done synchronously either way.
+      Run(handle);
+    }
+    {
+      MutexLock l(&handle->mu);
+      handle->done = true;
+    }
+    cqe = nullptr;
+    ret = io_uring_peek_cqe(iu, &cqe);
+  }
+}
+#endif  // defined(ROCKSDB_IOURING_PRESENT)
+
 /*
  * PosixRandomAccessFile
  *
@@ -541,7 +760,7 @@ size_t PosixHelper::GetLogicalBlockSizeOfFd(int fd) {
  */
 PosixRandomAccessFile::PosixRandomAccessFile(
     const std::string& fname, int fd, size_t logical_block_size,
-    const EnvOptions& options
+    const EnvOptions& options, PosixAsyncIO* async_io
 #if defined(ROCKSDB_IOURING_PRESENT)
     ,
     ThreadLocalPtr* thread_local_io_urings
@@ -550,7 +769,8 @@ PosixRandomAccessFile::PosixRandomAccessFile(
     : filename_(fname),
       fd_(fd),
       use_direct_io_(options.use_direct_reads),
-      logical_sector_size_(logical_block_size)
+      logical_sector_size_(logical_block_size),
+      async_io_(async_io)
 #if defined(ROCKSDB_IOURING_PRESENT)
       ,
       thread_local_io_urings_(thread_local_io_urings)
@@ -746,6 +966,37 @@ IOStatus PosixRandomAccessFile::MultiRead(FSReadRequest* reqs,
 #endif
 }
 
+IOStatus PosixRandomAccessFile::ReadAsync(
+    FSReadRequest& req, const IOOptions& opts,
+    std::function<void(const FSReadRequest&, void*)> cb, void* cb_arg,
+    void** io_handle, IOHandleDeleter* del_fn, IODebugContext* dbg) {
+  if (async_io_ == nullptr) {
+    return FSRandomAccessFile::ReadAsync(req, opts, cb, cb_arg, io_handle,
+                                         del_fn, dbg);
+  }
+  if (use_direct_io()) {
+    assert(IsSectorAligned(req.offset, GetRequiredBufferAlignment()));
+    assert(IsSectorAligned(req.len, GetRequiredBufferAlignment()));
+    assert(IsSectorAligned(req.scratch, GetRequiredBufferAlignment()));
+  }
+  PosixIOHandle* handle = new PosixIOHandle();
+  handle->file = this;
+  handle->fd = fd_;
+  handle->filename = &filename_;
+  handle->use_direct_io = use_direct_io();
+  handle->alignment = GetRequiredBufferAlignment();
+  handle->is_read = true;
+  handle->offset = req.offset;
+  handle->len = req.len;
+  handle->scratch = req.scratch;
+  handle->read_cb = std::move(cb);
+  handle->cb_arg = cb_arg;
+  *io_handle = handle;
+  *del_fn = PosixAsyncIO::DeleteHandle;
+  async_io_->Submit(handle);
+  return IOStatus::OK();
+}
+
 IOStatus PosixRandomAccessFile::Prefetch(uint64_t offset, size_t n,
                                          const IOOptions& /*opts*/,
                                          IODebugContext* /*dbg*/) {
@@ -1133,13 +1384,17 @@ IOStatus PosixMmapFile::Allocate(uint64_t offset, uint64_t len,
  */
 PosixWritableFile::PosixWritableFile(const std::string& fname, int fd,
                                      size_t logical_block_size,
-                                     const EnvOptions& options)
+                                     const EnvOptions& options,
+                                     PosixAsyncIO* async_io)
     : FSWritableFile(options),
       filename_(fname),
       use_direct_io_(options.use_direct_writes),
       fd_(fd),
       filesize_(0),
-      logical_sector_size_(logical_block_size) {
+      logical_sector_size_(logical_block_size),
+      async_io_(async_io),
+      append_mode_((fcntl(fd, F_GETFL) & O_APPEND) != 0),
+      async_appended_(false) {
 #ifdef ROCKSDB_FALLOCATE_PRESENT
   allow_fallocate_ = options.allow_fallocate;
   fallocate_with_keep_size_ = options.fallocate_with_keep_size;
@@ -1166,7 +1421,12 @@ IOStatus PosixWritableFile::Append(const Slice& data, const IOOptions& /*opts*/,
   const char* src = data.data();
   size_t nbytes = data.size();
 
-  if (!PosixWrite(fd_, src, nbytes)) {
+  if (async_appended_) {
+    if (!PosixPositionedWrite(fd_, src, nbytes,
+                              static_cast<off_t>(filesize_))) {
+      return IOError("While appending to file", filename_, errno);
+    }
+  } else if (!PosixWrite(fd_, src, nbytes)) {
     return IOError("While appending to file", filename_, errno);
   }
 
@@ -1174,6 +1434,42 @@ IOStatus PosixWritableFile::Append(const Slice& data, const IOOptions& /*opts*/,
   return IOStatus::OK();
 }
 
+IOStatus PosixWritableFile::AppendAsync(
+    const Slice& data, const IOOptions& opts,
+    std::function<void(const IOStatus&, void*)> cb, void* cb_arg,
+    void** io_handle, IOHandleDeleter* del_fn, IODebugContext* dbg) {
+  if (async_io_ == nullptr || append_mode_) {
+    // With O_APPEND, concurrent writes would land in the order they
+    // complete rather than the order they were submitted.
+    return FSWritableFile::AppendAsync(data, opts, cb, cb_arg, io_handle,
+                                       del_fn, dbg);
+  }
+  if (use_direct_io()) {
+    assert(IsSectorAligned(filesize_, GetRequiredBufferAlignment()));
+    assert(IsSectorAligned(data.size(), GetRequiredBufferAlignment()));
+    assert(IsSectorAligned(data.data(), GetRequiredBufferAlignment()));
+  }
+  PosixIOHandle* handle = new PosixIOHandle();
+  handle->fd = fd_;
+  handle->filename = &filename_;
+  handle->use_direct_io = use_direct_io();
+  handle->alignment = GetRequiredBufferAlignment();
+  handle->is_read = false;
+  handle->offset = filesize_;
+  handle->len = data.size();
+  handle->data = data.data();
+  handle->append_cb = std::move(cb);
+  handle->cb_arg = cb_arg;
+  // The append owns its range of the file from now on, so that the next
+  // ones are written after it whatever order they complete in.
+  filesize_ += data.size();
+  async_appended_ = true;
+  *io_handle = handle;
+  *del_fn = PosixAsyncIO::DeleteHandle;
+  async_io_->Submit(handle);
+  return IOStatus::OK();
+}
+
 IOStatus PosixWritableFile::PositionedAppend(const Slice& data, uint64_t offset,
                                              const IOOptions& /*opts*/,
                                              IODebugContext* /*dbg*/) {
@@ -1193,6 +1489,38 @@ IOStatus PosixWritableFile::PositionedAppend(const Slice& data, uint64_t offset,
   return IOStatus::OK();
 }
 
+IOStatus PosixWritableFile::PositionedAppendAsync(
+    const Slice& data, uint64_t offset, const IOOptions& opts,
+    std::function<void(const IOStatus&, void*)> cb, void* cb_arg,
+    void** io_handle, IOHandleDeleter* del_fn, IODebugContext* dbg) {
+  if (async_io_ == nullptr) {
+    return FSWritableFile::PositionedAppendAsync(data, offset, opts, cb, cb_arg,
+                                                 io_handle, del_fn, dbg);
+  }
+  if (use_direct_io()) {
+    assert(IsSectorAligned(offset, GetRequiredBufferAlignment()));
+    assert(IsSectorAligned(data.size(), GetRequiredBufferAlignment()));
+    assert(IsSectorAligned(data.data(), GetRequiredBufferAlignment()));
+  }
+  assert(offset <= static_cast<uint64_t>(std::numeric_limits<off_t>::max()));
+  PosixIOHandle* handle = new PosixIOHandle();
+  handle->fd = fd_;
+  handle->filename = &filename_;
+  handle->use_direct_io = use_direct_io();
+  handle->alignment = GetRequiredBufferAlignment();
+  handle->is_read = false;
+  handle->offset = offset;
+  handle->len = data.size();
+  handle->data = data.data();
+  handle->append_cb = std::move(cb);
+  handle->cb_arg = cb_arg;
+  filesize_ = offset + data.size();
+  *io_handle = handle;
+  *del_fn = PosixAsyncIO::DeleteHandle;
+  async_io_->Submit(handle);
+  return IOStatus::OK();
+}
+
 IOStatus PosixWritableFile::Truncate(uint64_t size, const IOOptions& /*opts*/,
                                      IODebugContext* /*dbg*/) {
   IOStatus s;
@@ -21,6 +21,7 @@
 #include "rocksdb/env.h"
 #include "rocksdb/file_system.h"
 #include "rocksdb/io_status.h"
+#include "rocksdb/threadpool.h"
 #include "util/mutexlock.h"
 #include "util/thread_local.h"
 
@@ -169,12 +170,96 @@ inline struct io_uring* CreateIOUring() {
 }
 #endif  // defined(ROCKSDB_IOURING_PRESENT)
 
+class PosixRandomAccessFile;
+
+// An asynchronous read or append submitted through
+// PosixRandomAccessFile::ReadAsync() or PosixWritableFile::AppendAsync().
+// It is the io_handle handed back to the caller.
+struct PosixIOHandle {
+  PosixIOHandle() : cv(&mu) {}
+
+  // Reads go through `file`, appends are written to `fd`.
+  const PosixRandomAccessFile* file = nullptr;
+  int fd = -1;
+  const std::string* filename = nullptr;
+  bool use_direct_io = false;
+  size_t alignment = 0;
+  bool is_read = true;
+  uint64_t offset = 0;
+  size_t len = 0;
+  char* scratch = nullptr;
+  const char* data = nullptr;
+  std::function<void(const FSReadRequest&, void*)> read_cb;
+  std::function<void(const IOStatus&, void*)> append_cb;
+  void* cb_arg = nullptr;
+#if defined(ROCKSDB_IOURING_PRESENT)
+  // The io_uring of the submitting thread, or nullptr if the I/O runs on
+  // the thread pool.
+  struct io_uring* iu = nullptr;
+  struct iovec iov;
+#endif
+
+  // The outcome of the I/O, set before `done`.
+  size_t finished_len = 0;
+  IOStatus status;
+  // Protects `done` when the I/O runs on the thread pool.
+  port::Mutex mu;
+  port::CondVar cv;
+  bool done = false;
+  bool callback_done = false;
+};
+
+// Runs the asynchronous I/Os of the files of a PosixFileSystem. They are
+// submitted to an io_uring of the submitting thread, separate from the one
+// MultiRead() waits on, and reaped by Poll() on that thread. Without
+// io_uring, they run on a thread pool started on the first I/O.
+class PosixAsyncIO {
+ public:
+  // Threads of the pool the I/Os run on without io_uring.
+  static const int kNumThreads = 16;
+
+  PosixAsyncIO();
+  ~PosixAsyncIO();
+
+  // No copying allowed
+  PosixAsyncIO(const PosixAsyncIO&) = delete;
+  PosixAsyncIO& operator=(const PosixAsyncIO&) = delete;
+
+  void Submit(PosixIOHandle* handle);
+
+  // See FileSystem::Poll().
+  IOStatus Poll(std::vector<void*>& io_handles, size_t min_completions);
+
+  static void DeleteHandle(void* handle) {
+    delete static_cast<PosixIOHandle*>(handle);
+  }
+
+ private:
+  // Does the whole I/O, or the part of it left, synchronously.
+  static void Run(PosixIOHandle* handle);
+  static bool IsDone(PosixIOHandle* handle);
+  void Wait(PosixIOHandle* handle);
+  static void RunCallback(PosixIOHandle* handle);
+#if defined(ROCKSDB_IOURING_PRESENT)
+  struct io_uring* GetIOUring();
+  // Reaps the completions of `iu`, waiting for one if `wait` is set.
+  static void Reap(struct io_uring* iu, bool wait);
+#endif
+
+  port::Mutex mu_;
+  std::unique_ptr<ThreadPool> thread_pool_;
+#if defined(ROCKSDB_IOURING_PRESENT)
+  std::unique_ptr<ThreadLocalPtr> thread_local_io_urings_;
+#endif
+};
+
 class PosixRandomAccessFile : public FSRandomAccessFile {
  protected:
   std::string filename_;
   int fd_;
   bool use_direct_io_;
   size_t logical_sector_size_;
+  PosixAsyncIO* async_io_;
 #if defined(ROCKSDB_IOURING_PRESENT)
   ThreadLocalPtr* thread_local_io_urings_;
 #endif
@@ -182,7 +267,7 @@ class PosixRandomAccessFile : public FSRandomAccessFile {
  public:
   PosixRandomAccessFile(const std::string& fname, int fd,
                         size_t logical_block_size,
-                        const EnvOptions& options
+                        const EnvOptions& options, PosixAsyncIO* async_io
 #if defined(ROCKSDB_IOURING_PRESENT)
                         ,
                         ThreadLocalPtr* thread_local_io_urings
@@ -198,6 +283,11 @@ class PosixRandomAccessFile : public FSRandomAccessFile {
                              const IOOptions& options,
                              IODebugContext* dbg) override;
 
+  virtual IOStatus ReadAsync(
+      FSReadRequest& req, const IOOptions& opts,
+      std::function<void(const FSReadRequest&, void*)> cb, void* cb_arg,
+      void** io_handle, IOHandleDeleter* del_fn, IODebugContext* dbg) override;
+
   virtual IOStatus Prefetch(uint64_t offset, size_t n, const IOOptions& opts,
                             IODebugContext* dbg) override;
 
@@ -219,6 +309,13 @@ class PosixWritableFile : public FSWritableFile {
   int fd_;
   uint64_t filesize_;
   size_t logical_sector_size_;
+  PosixAsyncIO* async_io_;
+  // Whether fd_ was opened with O_APPEND, which ignores the offsets of
+  // positioned writes.
+  bool append_mode_;
+  // Set once an append was submitted asynchronously, after which the file
+  // offset of fd_ is no longer at filesize_.
+  bool async_appended_;
 #ifdef ROCKSDB_FALLOCATE_PRESENT
   bool allow_fallocate_;
   bool fallocate_with_keep_size_;
@@ -232,7 +329,8 @@ class PosixWritableFile : public FSWritableFile {
  public:
   explicit PosixWritableFile(const std::string& fname, int fd,
                              size_t logical_block_size,
-                             const EnvOptions& options);
+                             const EnvOptions& options,
+                             PosixAsyncIO* async_io);
   virtual ~PosixWritableFile();
 
   // Need to implement this so the file is truncated correctly
@@ -247,6 +345,11 @@ class PosixWritableFile : public FSWritableFile {
                           IODebugContext* dbg) override {
     return Append(data, opts, dbg);
   }
+  virtual IOStatus AppendAsync(const Slice& data, const IOOptions& opts,
+                               std::function<void(const IOStatus&, void*)> cb,
+                               void* cb_arg, void** io_handle,
+                               IOHandleDeleter* del_fn,
+                               IODebugContext* dbg) override;
   virtual IOStatus PositionedAppend(const Slice& data, uint64_t offset,
                                     const IOOptions& opts,
                                     IODebugContext* dbg) override;
@@ -256,6 +359,10 @@ class PosixWritableFile : public FSWritableFile {
       IODebugContext* dbg) override {
     return PositionedAppend(data, offset, opts, dbg);
   }
+  virtual IOStatus PositionedAppendAsync(
+      const Slice& data, uint64_t offset, const IOOptions& opts,
+      std::function<void(const IOStatus&, void*)> cb, void* cb_arg,
+      void** io_handle, IOHandleDeleter* del_fn, IODebugContext* dbg) override;
   virtual IOStatus Flush(const IOOptions& opts, IODebugContext* dbg) override;
   virtual IOStatus Sync(const IOOptions& opts, IODebugContext* dbg) override;
   virtual IOStatus Fsync(const IOOptions& opts, IODebugContext* dbg) override;
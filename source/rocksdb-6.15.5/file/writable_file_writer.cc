@@ -22,6 +22,21 @@
 
 namespace ROCKSDB_NAMESPACE {
 IOStatus WritableFileWriter::Append(const Slice& data) {
+  // Calculate the checksum of appended data
+  UpdateFileChecksum(data);
+  return AppendInternal(data);
+}
+
+IOStatus WritableFileWriter::Append(const Slice& data,
+                                    uint32_t crc32c_checksum) {
+  if (checksum_generator_ != nullptr) {
+    checksum_generator_->UpdateWithCrc32c(data.data(), data.size(),
+                                          crc32c_checksum);
+  }
+  return AppendInternal(data);
+}
+
+IOStatus WritableFileWriter::AppendInternal(const Slice& data) {
   const char* src = data.data();
   size_t left = data.size();
   IOStatus s;
@@ -30,9 +45,6 @@ IOStatus WritableFileWriter::Append(const Slice& data) {
   TEST_KILL_RANDOM("WritableFileWriter::Append:0",
                    rocksdb_kill_odds * REDUCE_ODDS2);
 
-  // Calculate the checksum of appended data
-  UpdateFileChecksum(data);
-
   {
     IOSTATS_TIMER_GUARD(prepare_write_nanos);
     TEST_SYNC_POINT("WritableFileWriter::Append:BeforePrepareWrite");
@@ -77,7 +89,11 @@ IOStatus WritableFileWriter::Append(const Slice& data) {
       src += appended;
 
       if (left > 0) {
+#ifndef ROCKSDB_LITE
+        s = use_async_writes() ? WriteDirectAsync() : Flush();
+#else
         s = Flush();
+#endif  // !ROCKSDB_LITE
         if (!s.ok()) {
           break;
         }
@@ -133,7 +149,7 @@ IOStatus WritableFileWriter::Close() {
     return s;
   }
 
-  s = Flush();  // flush cache to OS
+  s = FlushInternal(true /* write_tail */);  // flush cache to OS
 
   IOStatus interim;
   // In direct I/O mode we write whole pages so
@@ -208,18 +224,32 @@ IOStatus WritableFileWriter::Close() {
   return s;
 }
 
+IOStatus WritableFileWriter::Flush() {
+  // Rewriting the partial page at the end of the file on every flush would
+  // double the direct writes of small flushes, so it waits for Sync() or
+  // Close() when nobody reads the file before then.
+  return FlushInternal(!use_async_writes() /* write_tail */);
+}
+
 // write out the cached data to the OS cache or storage if direct I/O
 // enabled
-IOStatus WritableFileWriter::Flush() {
+IOStatus WritableFileWriter::FlushInternal(bool write_tail) {
   IOStatus s;
   TEST_KILL_RANDOM("WritableFileWriter::Flush:0",
                    rocksdb_kill_odds * REDUCE_ODDS2);
 
+#ifndef ROCKSDB_LITE
+  s = WaitForPendingWrites();
+  if (!s.ok()) {
+    return s;
+  }
+#endif  // !ROCKSDB_LITE
+
   if (buf_.CurrentSize() > 0) {
     if (use_direct_io()) {
 #ifndef ROCKSDB_LITE
       if (pending_sync_) {
-        s = WriteDirect();
+        s = WriteDirect(write_tail);
       }
 #endif  // !ROCKSDB_LITE
     } else {
@@ -298,7 +328,7 @@ const char* WritableFileWriter::GetFileChecksumFuncName() const {
 }
 
 IOStatus WritableFileWriter::Sync(bool use_fsync) {
-  IOStatus s = Flush();
+  IOStatus s = FlushInternal(true /* write_tail */);
   if (!s.ok()) {
     return s;
   }
@@ -446,7 +476,7 @@ void WritableFileWriter::UpdateFileChecksum(const Slice& data) {
 // only write on aligned
 // offsets.
 #ifndef ROCKSDB_LITE
-IOStatus WritableFileWriter::WriteDirect() {
+IOStatus WritableFileWriter::WriteDirect(bool write_tail) {
   assert(use_direct_io());
   IOStatus s;
   const size_t alignment = buf_.Alignment();
@@ -461,12 +491,15 @@ IOStatus WritableFileWriter::WriteDirect() {
   // fills out
   size_t leftover_tail = buf_.CurrentSize() - file_advance;
 
-  // Round up and pad
-  buf_.PadToAlignmentWith(0);
+  size_t left = file_advance;
+  if (write_tail) {
+    // Round up and pad
+    buf_.PadToAlignmentWith(0);
+    left = buf_.CurrentSize();
+  }
 
   const char* src = buf_.BufferStart();
   uint64_t write_offset = next_write_offset_;
-  size_t left = buf_.CurrentSize();
 
   while (left > 0) {
     // Check how much is allowed
@@ -519,5 +552,115 @@ IOStatus WritableFileWriter::WriteDirect() {
   }
   return s;
 }
+
+IOStatus WritableFileWriter::WriteDirectAsync() {
+  assert(use_async_writes());
+  const size_t alignment = buf_.Alignment();
+  if (buf_.CurrentSize() % alignment != 0) {
+    // The capacity of the buffer is always aligned, so this is only for
+    // safety.
+    return Flush();
+  }
+  // Only one buffer is written at a time.
+  IOStatus s = WaitForPendingWrites();
+  if (!s.ok()) {
+    return s;
+  }
+  std::swap(buf_, write_buf_);
+  if (buf_.Capacity() < write_buf_.Capacity()) {
+    buf_.Alignment(alignment);
+    buf_.AllocateNewBuffer(write_buf_.Capacity());
+  }
+  buf_.Size(0);
+
+  const char* src = write_buf_.BufferStart();
+  size_t left = write_buf_.CurrentSize();
+  while (left > 0) {
+    size_t size;
+    if (rate_limiter_ != nullptr) {
+      size = rate_limiter_->RequestToken(left, alignment,
+                                         writable_file_->GetIOPriority(),
+                                         stats_, RateLimiter::OpType::kWrite);
+    } else {
+      size = left;
+    }
+
+    pending_writes_.emplace_back(new PendingWrite());
+    PendingWrite* write = pending_writes_.back().get();
+    write->offset = next_write_offset_;
+    write->size = size;
+    if (ShouldNotifyListeners()) {
+      write->start_ts = FileOperationInfo::StartNow();
+    }
+    {
+      IOSTATS_TIMER_GUARD(write_nanos);
+      TEST_SYNC_POINT("WritableFileWriter::Flush:BeforeAppend");
+      s = writable_file_->PositionedAppendAsync(
+          Slice(src, size), next_write_offset_, IOOptions(),
+          [](const IOStatus& status, void* arg) {
+            PendingWrite* w = static_cast<PendingWrite*>(arg);
+            w->status = status;
+            w->done = true;
+          },
+          write, &write->io_handle, &write->del_fn, nullptr);
+    }
+    if (!s.ok()) {
+      pending_writes_.pop_back();
+      break;
+    }
+    left -= size;
+    src += size;
+    next_write_offset_ += size;
+    if (write->done && !write->status.ok()) {
+      // Completed on submission, as with file systems without asynchronous
+      // writes; fail the append right away like WriteDirect() does.
+      break;
+    }
+  }
+  IOStatus wait_status;
+  if (!s.ok() || left > 0) {
+    wait_status = WaitForPendingWrites();
+  }
+  return s.ok() ? wait_status : s;
+}
+
+IOStatus WritableFileWriter::WaitForPendingWrites() {
+  if (pending_writes_.empty()) {
+    return IOStatus::OK();
+  }
+  IOStatus s;
+  {
+    IOSTATS_TIMER_GUARD(write_nanos);
+    std::vector<void*> io_handles;
+    io_handles.reserve(pending_writes_.size());
+    for (const auto& write : pending_writes_) {
+      io_handles.push_back(write->io_handle);
+    }
+    s = fs_->Poll(io_handles, io_handles.size());
+  }
+  if (!s.ok()) {
+    // The writes may still be in flight, keep them to wait again.
+    return s;
+  }
+  for (const auto& write : pending_writes_) {
+    assert(write->done);
+    if (ShouldNotifyListeners()) {
+      // Finishes when reaped rather than when the write completed.
+      auto finish_ts = std::chrono::steady_clock::now();
+      NotifyOnFileWriteFinish(write->offset, write->size, write->start_ts,
+                              finish_ts, write->status);
+    }
+    if (write->status.ok()) {
+      IOSTATS_ADD(bytes_written, write->size);
+    } else if (s.ok()) {
+      s = write->status;
+    }
+    if (write->del_fn) {
+      write->del_fn(write->io_handle);
+    }
+  }
+  pending_writes_.clear();
+  return s;
+}
 #endif  // !ROCKSDB_LITE
 }  // namespace ROCKSDB_NAMESPACE
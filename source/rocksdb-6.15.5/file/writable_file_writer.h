@@ -9,7 +9,9 @@
 
 #pragma once
 #include <atomic>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "db/version_edit.h"
 #include "env/file_system_tracer.h"
@@ -122,6 +124,7 @@ class WritableFileWriter {
   std::string file_name_;
   FSWritableFilePtr writable_file_;
   Env* env_;
+  FileSystem* fs_;
   AlignedBuffer buf_;
   size_t max_buffer_size_;
   // Actually written data size can be used for truncate
@@ -132,6 +135,21 @@ class WritableFileWriter {
   // and writes must happen on aligned offsets
   // so we need to go back and write that page again
   uint64_t next_write_offset_;
+
+  // A direct write submitted with FSWritableFile::PositionedAppendAsync()
+  // and not reaped yet.
+  struct PendingWrite {
+    void* io_handle = nullptr;
+    IOHandleDeleter del_fn;
+    uint64_t offset = 0;
+    size_t size = 0;
+    FileOperationInfo::StartTimePoint start_ts;
+    bool done = false;
+    IOStatus status;
+  };
+  // With asynchronous writes, the buffer being written while buf_ fills.
+  AlignedBuffer write_buf_;
+  std::vector<std::unique_ptr<PendingWrite>> pending_writes_;
 #endif  // ROCKSDB_LITE
   bool pending_sync_;
   uint64_t last_sync_size_;
@@ -143,16 +161,20 @@ class WritableFileWriter {
   bool checksum_finalized_;
 
  public:
+  // `fs` is the file system `file` was opened from. If it is given and the
+  // file uses direct I/O, full buffers are written asynchronously through it.
   WritableFileWriter(
       std::unique_ptr<FSWritableFile>&& file, const std::string& _file_name,
       const FileOptions& options, Env* env = nullptr,
       const std::shared_ptr<IOTracer>& io_tracer = nullptr,
       Statistics* stats = nullptr,
       const std::vector<std::shared_ptr<EventListener>>& listeners = {},
-      FileChecksumGenFactory* file_checksum_gen_factory = nullptr)
+      FileChecksumGenFactory* file_checksum_gen_factory = nullptr,
+      FileSystem* fs = nullptr)
       : file_name_(_file_name),
         writable_file_(std::move(file), io_tracer),
         env_(env),
+        fs_(fs),
         buf_(),
         max_buffer_size_(options.writable_file_max_buffer_size),
         filesize_(0),
@@ -203,8 +225,15 @@ class WritableFileWriter {
 
   IOStatus Append(const Slice& data);
 
+  // Same as Append(data), but the caller already knows the crc32c of `data`
+  // (e.g. from computing a block trailer), which lets a crc32c based file
+  // checksum generator combine it instead of hashing `data` a second time.
+  IOStatus Append(const Slice& data, uint32_t crc32c_checksum);
+
   IOStatus Pad(const size_t pad_bytes);
 
+  // With asynchronous writes, only writes out the whole pages buffered, and
+  // leaves the partial page at the end of the file to Sync() and Close().
   IOStatus Flush();
 
   IOStatus Close();
@@ -241,8 +270,22 @@ class WritableFileWriter {
   // Used when os buffering is OFF and we are writing
   // DMA such as in Direct I/O mode
 #ifndef ROCKSDB_LITE
-  IOStatus WriteDirect();
+  // Writes the whole pages in the buffer, and the partial page at its end
+  // padded with zeros if `write_tail` is set.
+  IOStatus WriteDirect(bool write_tail);
+  // Starts writing the full buffer with PositionedAppendAsync() and swaps
+  // in the other buffer to fill in the meantime.
+  IOStatus WriteDirectAsync();
+  // Waits for the writes started by WriteDirectAsync() and returns the first
+  // error of any.
+  IOStatus WaitForPendingWrites();
 #endif  // !ROCKSDB_LITE
+  // Direct writes of full buffers are asynchronous when the file system of
+  // the file was given: one buffer is written while the other one fills.
+  bool use_async_writes() { return fs_ != nullptr && use_direct_io(); }
+  IOStatus FlushInternal(bool write_tail);
+  // Buffers or writes `data` without touching the file checksum
+  IOStatus AppendInternal(const Slice& data);
   // Normal write
   IOStatus WriteBuffered(const char* data, size_t size);
   IOStatus RangeSync(uint64_t offset, uint64_t nbytes);
@@ -722,6 +722,95 @@ struct AdvancedColumnFamilyOptions {
   // Dynamically changeable through SetOptions() API
   uint64_t periodic_compaction_seconds = 0xfffffffffffffffe;
 
+  // EXPERIMENTAL
+  // If non-zero, point lookups that have to search more than one file are
+  // sampled (one in every 1024 Gets), and a file is marked for compaction
+  // once roughly this many lookups searched it without finding the key
+  // before moving on to another file. Files whose filter ruled the key out
+  // are not charged, as such probes are cheap. Compacting a marked file into
+  // the next level removes the overlap that causes the extra probes.
+  //
+  // Such compactions have the lowest priority: they are only picked when no
+  // level needs compaction otherwise, and at most one of them runs at a time
+  // per column family.
+  //
+  // Only supported in Level compaction.
+  //
+  // Default: 0 (disabled)
+  //
+  // Dynamically changeable through SetOptions() API
+  uint64_t read_triggered_compaction_threshold = 0;
+
+  // EXPERIMENTAL
+  // If true, when leveled compaction picks a file whose key range only
+  // partially overlaps the next level, the parts of the file that do not
+  // overlap any file of the next level are moved there without being
+  // rewritten, and only the overlapping part is compacted. The file is split
+  // by hard-linking it under new file numbers that each only own a range of
+  // its keys, which saves rewriting cold data in key spaces that are mostly
+  // appended to.
+  //
+  // Only files without range tombstones are split, and only when the parts
+  // to move make up a sizable fraction of the file. Requires a file system
+  // that supports hard links; compactions fall back to rewriting the whole
+  // file otherwise. DBs that contain split files cannot be opened by older
+  // versions of RocksDB.
+  //
+  // Only supported in Level compaction.
+  //
+  // Default: false
+  //
+  // Dynamically changeable through SetOptions() API
+  bool allow_partial_trivial_move = false;
+
+  // EXPERIMENTAL
+  // If non-zero and there is more than one path in cf_paths (or db_paths),
+  // leveled compaction places its output files by the temperature of their
+  // data and not only by the target sizes of the paths. The paths are then
+  // expected to be listed from the fastest to the slowest device.
+  //
+  // Output data that is older than this many seconds, judged by the oldest
+  // ancester time of the input files, is cold and goes to the last path.
+  // Output data that point lookups read at least twice as often per byte as
+  // the rest of the column family is hot and goes one path up from where its
+  // level would place it. Everything else is placed by level as before.
+  // Files that turn cold while sitting on a faster path are migrated to the
+  // last path by compactions that rewrite them into the same level.
+  //
+  // Per-path read and write stats are reported in the "rocksdb.cfstats"
+  // property when more than one path is configured.
+  //
+  // Only supported in Level compaction.
+  //
+  // Default: 0 (disabled)
+  //
+  // Dynamically changeable through SetOptions() API
+  uint64_t cold_data_age_seconds = 0;
+
+  // EXPERIMENTAL
+  // If non-zero, compactions run the compaction filter on values in batches
+  // of this many through CompactionFilter::FilterBatch(), reading the input
+  // ahead of the compaction output. Only takes effect for compactions that
+  // have a compaction filter, and not with a snapshot checker
+  // (WritePrepared/WriteUnprepared transactions) or user-defined timestamps.
+  //
+  // Default: 0 (filter each value through FilterV2() as it is reached)
+  //
+  // Dynamically changeable through SetOptions() API
+  size_t compaction_filter_batch_size = 0;
+
+  // EXPERIMENTAL
+  // The number of threads each compaction filters batches on when
+  // compaction_filter_batch_size is set. The batches of the input read
+  // ahead are filtered on them in parallel while the compaction writes the
+  // output, which helps filters that are expensive to evaluate. With 0, the
+  // batches are filtered on the compaction thread.
+  //
+  // Default: 0
+  //
+  // Dynamically changeable through SetOptions() API
+  int compaction_filter_batch_threads = 0;
+
   // If this option is set then 1 in N blocks are compressed
   // using a fast (lz4) and slow (zstd) compression algorithm.
   // The compressibility is reported as stats and the stored
@@ -734,7 +823,8 @@ struct AdvancedColumnFamilyOptions {
   // amplification for large-value use cases at the cost of introducing a level
   // of indirection for reads. See also the options min_blob_size,
   // blob_file_size, blob_compression_type, enable_blob_garbage_collection,
-  // and blob_garbage_collection_age_cutoff below.
+  // blob_garbage_collection_age_cutoff, and
+  // blob_garbage_collection_force_threshold below.
   //
   // Default: false
   //
@@ -798,6 +888,22 @@ struct AdvancedColumnFamilyOptions {
   // Dynamically changeable through the SetOptions() API
   double blob_garbage_collection_age_cutoff = 0.25;
 
+  // UNDER CONSTRUCTION -- DO NOT USE
+  // The garbage ratio threshold for garbage collection. A blob file whose
+  // ratio of garbage (in bytes) reaches this threshold is garbage collected
+  // even if it is younger than blob_garbage_collection_age_cutoff, i.e. its
+  // valid blobs are relocated when encountered during compaction. In
+  // addition, with leveled compaction, the table files referencing such blob
+  // files are marked for compaction so that the garbage gets reclaimed even
+  // if no other compaction would touch them. A value of 1.0 disables this.
+  // Note that enable_blob_garbage_collection has to be set in order for this
+  // option to have any effect.
+  //
+  // Default: 1.0
+  //
+  // Dynamically changeable through the SetOptions() API
+  double blob_garbage_collection_force_threshold = 1.0;
+
   // Create ColumnFamilyOptions with default values for all fields
   AdvancedColumnFamilyOptions();
   // Create ColumnFamilyOptions from Options
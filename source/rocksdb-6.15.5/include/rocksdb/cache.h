@@ -69,6 +69,20 @@ struct LRUCacheOptions {
   // BlockBasedTableOptions::cache_index_and_filter_blocks_with_high_priority.
   double high_pri_pool_ratio = 0.5;
 
+  // Percentage of cache reserved for low priority entries.
+  // If greater than zero, the part of the LRU list below the high-pri list is
+  // further split into a low-pri list and a bottom-pri list. Low-pri entries
+  // (and high-pri entries overflowing from the high-pri list) are inserted to
+  // the tail of the low-pri list, while bottom-pri entries are inserted to the
+  // tail of the bottom-pri list. Bottom-pri entries are thus evicted before
+  // low-pri entries that have not been used more recently. If zero, low-pri
+  // and bottom-pri entries are treated the same way.
+  //
+  // high_pri_pool_ratio + low_pri_pool_ratio must not exceed 1.0.
+  //
+  // See also BlockBasedTableOptions::use_tiered_cache_priority.
+  double low_pri_pool_ratio = 0.0;
+
   // If non-nullptr will use this allocator instead of system allocator when
   // allocating memory for cache blocks. Call this method before you start using
   // the cache!
@@ -134,8 +148,9 @@ extern std::shared_ptr<Cache> NewClockCache(
 class Cache {
  public:
   // Depending on implementation, cache entries with high priority could be less
-  // likely to get evicted than low priority entries.
-  enum class Priority { HIGH, LOW };
+  // likely to get evicted than low priority entries, which in turn could be
+  // less likely to get evicted than bottom priority entries.
+  enum class Priority { HIGH, LOW, BOTTOM };
 
   Cache(std::shared_ptr<MemoryAllocator> allocator = nullptr)
       : memory_allocator_(std::move(allocator)) {}
@@ -261,6 +276,13 @@ class Cache {
   // returns the memory size for the entries in use by the system
   virtual size_t GetPinnedUsage() const = 0;
 
+  // returns the memory size for the entries not in use by the system that
+  // reside in the pool reserved for the given priority. Returns 0 if the
+  // cache does not divide its capacity into priority pools.
+  virtual size_t GetPriorityPoolUsage(Priority /*priority*/) const {
+    return 0;
+  }
+
   // returns the charge for the specific entry in the cache.
   virtual size_t GetCharge(Handle* handle) const = 0;
 
@@ -14,10 +14,10 @@
 #include <vector>
 
 #include "rocksdb/rocksdb_namespace.h"
+#include "rocksdb/slice.h"
 
 namespace ROCKSDB_NAMESPACE {
 
-class Slice;
 class SliceTransform;
 
 // Context information of a compaction run
@@ -62,6 +62,18 @@ class CompactionFilter {
     uint32_t column_family_id;
   };
 
+  // A key-value passed to FilterBatch(), along with the decision on it.
+  struct BatchEntry {
+    // The arguments of FilterV2()
+    Slice key;
+    ValueType value_type = ValueType::kValue;
+    Slice existing_value;
+    // The return value of FilterV2() and its outputs
+    Decision decision = Decision::kKeep;
+    std::string new_value;
+    std::string skip_until;
+  };
+
   virtual ~CompactionFilter() {}
 
   // The compaction process invokes this
@@ -179,6 +191,27 @@ class CompactionFilter {
     return Decision::kKeep;
   }
 
+  // EXPERIMENTAL
+  // Batched form of FilterV2() for values (not merge operands), which
+  // compactions call instead of FilterV2() when compaction_filter_batch_size
+  // is set. Sets the decision on each entry of `batch`, whose keys are in
+  // the order of the compaction. The default implementation calls FilterV2()
+  // on each entry.
+  //
+  // Batches are filtered ahead of the compaction output, so the filter may
+  // see keys that the compaction does not get to, such as the keys after one
+  // removed with kRemoveAndSkipUntil, or past the end of a subcompaction.
+  // With compaction_filter_batch_threads set, several batches of the same
+  // compaction are filtered concurrently on different threads, so this
+  // method must be thread-safe even if the filter was created by a factory.
+  virtual void FilterBatch(int level, std::vector<BatchEntry>* batch) const {
+    for (auto& entry : *batch) {
+      entry.decision =
+          FilterV2(level, entry.key, entry.value_type, entry.existing_value,
+                   &entry.new_value, &entry.skip_until);
+    }
+  }
+
   // Internal (BlobDB) use only. Do not override in application code.
   virtual BlobDecision PrepareBlobOutput(const Slice& /* key */,
                                          const Slice& /* existing_value */,
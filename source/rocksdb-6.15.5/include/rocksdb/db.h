@@ -221,6 +221,19 @@ class DB {
       const std::vector<ColumnFamilyDescriptor>& column_families,
       std::vector<ColumnFamilyHandle*>* handles, DB** dbptr);
 
+  // EXPERIMENTAL
+  // Worker side of a CompactionService: run the compaction described by
+  // `input` (as passed to CompactionService::Start()) against the DB at
+  // `name`, which is opened as a secondary instance. The output files are
+  // written to `output_directory`, which also holds the worker's info log,
+  // and are not installed in the DB. On return `output` holds the serialized
+  // result the primary expects from CompactionService::WaitForComplete(),
+  // including when the compaction itself failed.
+  static Status OpenAndCompact(
+      const std::string& name, const std::string& output_directory,
+      const std::string& input, std::string* output,
+      const CompactionServiceOptionsOverride& override_options);
+
   // Open DB with column families.
   // db_options specify database specific options
   // column_families is the vector of all column families in the database,
@@ -924,6 +937,15 @@ class DB {
     //      entries being pinned.
     static const std::string kBlockCachePinnedUsage;
 
+    // "rocksdb.block-cache-high-pri-pool-usage",
+    // "rocksdb.block-cache-low-pri-pool-usage",
+    // "rocksdb.block-cache-bottom-pri-pool-usage" - return the memory size for
+    //      the unpinned entries residing in the respective priority pool of the
+    //      block cache. Always 0 for caches without priority pools.
+    static const std::string kBlockCacheHighPriPoolUsage;
+    static const std::string kBlockCacheLowPriPoolUsage;
+    static const std::string kBlockCacheBottomPriPoolUsage;
+
     // "rocksdb.options-statistics" - returns multi-line string
     //      of options.statistics
     static const std::string kOptionsStatistics;
@@ -983,6 +1005,9 @@ class DB {
   //  "rocksdb.block-cache-capacity"
   //  "rocksdb.block-cache-usage"
   //  "rocksdb.block-cache-pinned-usage"
+  //  "rocksdb.block-cache-high-pri-pool-usage"
+  //  "rocksdb.block-cache-low-pri-pool-usage"
+  //  "rocksdb.block-cache-bottom-pri-pool-usage"
   virtual bool GetIntProperty(ColumnFamilyHandle* column_family,
                               const Slice& property, uint64_t* value) = 0;
   virtual bool GetIntProperty(const Slice& property, uint64_t* value) {
@@ -9,6 +9,7 @@
 #pragma once
 
 #include <cassert>
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <string>
@@ -51,6 +52,15 @@ class FileChecksumGenerator {
   // include the new data.
   virtual void Update(const char* data, size_t n) = 0;
 
+  // Same as Update(data, n), but the caller also passes the crc32c of the
+  // n bytes of data. Generators built on crc32c can override this to fold
+  // data_crc32c into their state without reading data again; the default
+  // simply calls Update().
+  virtual void UpdateWithCrc32c(const char* data, size_t n,
+                                uint32_t /*data_crc32c*/) {
+    Update(data, n);
+  }
+
   // Generate the final results if no further new data will be updated.
   virtual void Finalize() = 0;
 
@@ -140,6 +140,10 @@ struct IODebugContext {
   }
 };
 
+// Releases the handle of an asynchronous I/O, see
+// FSRandomAccessFile::ReadAsync().
+using IOHandleDeleter = std::function<void(void*)>;
+
 // The FileSystem, FSSequentialFile, FSRandomAccessFile, FSWritableFile,
 // FSRandomRWFileclass, and FSDIrectory classes define the interface between
 // RocksDB and storage systems, such as Posix filesystems,
@@ -530,6 +534,19 @@ class FileSystem {
                                const IOOptions& options, bool* is_dir,
                                IODebugContext* /*dgb*/) = 0;
 
+  // EXPERIMENTAL
+  // Waits for the asynchronous I/Os of io_handles, as returned by
+  // FSRandomAccessFile::ReadAsync() and FSWritableFile::AppendAsync() on
+  // files of this FileSystem, until at least min_completions of them have
+  // completed, and runs the callbacks of the completed ones whose callbacks
+  // have not run yet. A null handle stands for an I/O that completed when it
+  // was submitted. Must be called from the thread that submitted the I/Os.
+  // The handles are still owned by the caller.
+  virtual IOStatus Poll(std::vector<void*>& /*io_handles*/,
+                        size_t /*min_completions*/) {
+    return IOStatus::OK();
+  }
+
   // If you're adding methods here, remember to add them to EnvWrapper too.
 
  private:
@@ -659,6 +676,29 @@ class FSRandomAccessFile {
     return IOStatus::OK();
   }
 
+  // EXPERIMENTAL
+  // Starts reading req.len bytes at req.offset into req.scratch, and returns
+  // without waiting for the read, which can keep several reads in flight per
+  // thread. Once the read has completed, FileSystem::Poll() on *io_handle
+  // calls cb with a copy of req whose result and status are set, and
+  // cb_arg. req.scratch must stay live until then, and *io_handle must then
+  // be released with *del_fn. The returned status only covers submitting
+  // the read.
+  //
+  // The default implementation reads synchronously, calls cb before
+  // returning and sets *io_handle to nullptr.
+  virtual IOStatus ReadAsync(
+      FSReadRequest& req, const IOOptions& options,
+      std::function<void(const FSReadRequest&, void*)> cb, void* cb_arg,
+      void** io_handle, IOHandleDeleter* del_fn, IODebugContext* dbg) {
+    req.status =
+        Read(req.offset, req.len, options, &req.result, req.scratch, dbg);
+    *io_handle = nullptr;
+    *del_fn = nullptr;
+    cb(req, cb_arg);
+    return IOStatus::OK();
+  }
+
   // Tries to get an unique ID for this file that will be the same each time
   // the file is opened (and will stay the same while the file is open).
   // Furthermore, it tries to make this ID at most "max_size" bytes. If such an
@@ -746,6 +786,27 @@ class FSWritableFile {
     return Append(data, options, dbg);
   }
 
+  // EXPERIMENTAL
+  // Starts appending data to the file and returns without waiting for the
+  // write. The appends in flight land in the order they were submitted.
+  // Completes through FileSystem::Poll() like
+  // FSRandomAccessFile::ReadAsync(), which calls cb with the status of the
+  // write and cb_arg. data must stay live until then. All the appends must
+  // have completed before the file is flushed, synced, truncated or closed.
+  //
+  // The default implementation appends synchronously, calls cb before
+  // returning and sets *io_handle to nullptr.
+  virtual IOStatus AppendAsync(const Slice& data, const IOOptions& options,
+                               std::function<void(const IOStatus&, void*)> cb,
+                               void* cb_arg, void** io_handle,
+                               IOHandleDeleter* del_fn, IODebugContext* dbg) {
+    IOStatus s = Append(data, options, dbg);
+    *io_handle = nullptr;
+    *del_fn = nullptr;
+    cb(s, cb_arg);
+    return IOStatus::OK();
+  }
+
   // PositionedAppend data to the specified offset. The new EOF after append
   // must be larger than the previous EOF. This is to be used when writes are
   // not backed by OS buffers and hence has to always start from the start of
@@ -785,6 +846,25 @@ class FSWritableFile {
     return IOStatus::NotSupported("PositionedAppend");
   }
 
+  // EXPERIMENTAL
+  // Starts a PositionedAppend() of data at offset and returns without
+  // waiting for the write, which completes through FileSystem::Poll() like
+  // AppendAsync(). Several writes to disjoint ranges may be in flight at
+  // once.
+  //
+  // The default implementation writes synchronously, calls cb before
+  // returning and sets *io_handle to nullptr.
+  virtual IOStatus PositionedAppendAsync(
+      const Slice& data, uint64_t offset, const IOOptions& options,
+      std::function<void(const IOStatus&, void*)> cb, void* cb_arg,
+      void** io_handle, IOHandleDeleter* del_fn, IODebugContext* dbg) {
+    IOStatus s = PositionedAppend(data, offset, options, dbg);
+    *io_handle = nullptr;
+    *del_fn = nullptr;
+    cb(s, cb_arg);
+    return IOStatus::OK();
+  }
+
   // Truncate is necessary to trim the file to the correct size
   // before closing. It is not always possible to keep track of the file
   // size due to whole pages writes. The behavior is undefined if called
@@ -1237,6 +1317,10 @@ class FileSystemWrapper : public FileSystem {
                        bool* is_dir, IODebugContext* dbg) override {
     return target_->IsDirectory(path, options, is_dir, dbg);
   }
+  IOStatus Poll(std::vector<void*>& io_handles,
+                size_t min_completions) override {
+    return target_->Poll(io_handles, min_completions);
+  }
 
  private:
   std::shared_ptr<FileSystem> target_;
@@ -1285,6 +1369,13 @@ class FSRandomAccessFileWrapper : public FSRandomAccessFile {
                      const IOOptions& options, IODebugContext* dbg) override {
     return target_->MultiRead(reqs, num_reqs, options, dbg);
   }
+  IOStatus ReadAsync(FSReadRequest& req, const IOOptions& options,
+                     std::function<void(const FSReadRequest&, void*)> cb,
+                     void* cb_arg, void** io_handle, IOHandleDeleter* del_fn,
+                     IODebugContext* dbg) override {
+    return target_->ReadAsync(req, options, cb, cb_arg, io_handle, del_fn,
+                              dbg);
+  }
   IOStatus Prefetch(uint64_t offset, size_t n, const IOOptions& options,
                     IODebugContext* dbg) override {
     return target_->Prefetch(offset, n, options, dbg);
@@ -1320,6 +1411,13 @@ class FSWritableFileWrapper : public FSWritableFile {
                   IODebugContext* dbg) override {
     return target_->Append(data, options, verification_info, dbg);
   }
+  IOStatus AppendAsync(const Slice& data, const IOOptions& options,
+                       std::function<void(const IOStatus&, void*)> cb,
+                       void* cb_arg, void** io_handle, IOHandleDeleter* del_fn,
+                       IODebugContext* dbg) override {
+    return target_->AppendAsync(data, options, cb, cb_arg, io_handle, del_fn,
+                                dbg);
+  }
   IOStatus PositionedAppend(const Slice& data, uint64_t offset,
                             const IOOptions& options,
                             IODebugContext* dbg) override {
@@ -1332,6 +1430,15 @@ class FSWritableFileWrapper : public FSWritableFile {
     return target_->PositionedAppend(data, offset, options, verification_info,
                                      dbg);
   }
+  IOStatus PositionedAppendAsync(const Slice& data, uint64_t offset,
+                                 const IOOptions& options,
+                                 std::function<void(const IOStatus&, void*)> cb,
+                                 void* cb_arg, void** io_handle,
+                                 IOHandleDeleter* del_fn,
+                                 IODebugContext* dbg) override {
+    return target_->PositionedAppendAsync(data, offset, options, cb, cb_arg,
+                                          io_handle, del_fn, dbg);
+  }
   IOStatus Truncate(uint64_t size, const IOOptions& options,
                     IODebugContext* dbg) override {
     return target_->Truncate(size, options, dbg);
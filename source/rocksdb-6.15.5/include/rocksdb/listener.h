@@ -98,6 +98,15 @@ enum class CompactionReason : int {
   kExternalSstIngestion,
   // Compaction due to SST file being too old
   kPeriodicCompaction,
+  // [Level] Compaction of table files referencing blob files whose garbage
+  // ratio reached blob_garbage_collection_force_threshold
+  kForcedBlobGC,
+  // [Level] Files that point lookups kept searching without finding the key,
+  // see read_triggered_compaction_threshold
+  kReadTriggered,
+  // [Level] Files whose data turned cold and are moved to the last path, see
+  // cold_data_age_seconds
+  kTemperatureMigration,
   // total number of compaction reasons, new reasons must be added above this.
   kNumOfReasons,
 };
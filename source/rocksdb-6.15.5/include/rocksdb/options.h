@@ -351,6 +351,40 @@ struct DbPath {
 
 extern const char* kHostnameForDbHostId;
 
+enum class CompactionServiceJobStatus : char {
+  kSuccess,
+  kFailure,
+  kUseLocal,  // the service cannot run the job; compact locally instead
+};
+
+// CompactionService runs compactions outside of the DB process, e.g. in a
+// dedicated worker process pinned to its own cores or cgroup. The DB hands
+// the service an opaque, serialized description of a compaction; the worker
+// passes it to DB::OpenAndCompact(), which opens the DB as a secondary
+// instance on the same file system, writes the output files into a separate
+// directory and returns an opaque, serialized result. The DB then moves the
+// output files into place and installs them in its own MANIFEST.
+//
+// Exceptions MUST NOT propagate out of overridden functions into RocksDB,
+// because RocksDB is not exception-safe.
+class CompactionService {
+ public:
+  virtual ~CompactionService() {}
+
+  // Returns the name of this compaction service.
+  virtual const char* Name() const = 0;
+
+  // Start the compaction described by `compaction_service_input`. `job_id`
+  // is unique within the DB and is passed back to WaitForComplete().
+  virtual CompactionServiceJobStatus Start(
+      const std::string& compaction_service_input, uint64_t job_id) = 0;
+
+  // Wait for the compaction started with `job_id` to finish and return the
+  // string produced by DB::OpenAndCompact() in `compaction_service_result`.
+  virtual CompactionServiceJobStatus WaitForComplete(
+      uint64_t job_id, std::string* compaction_service_result) = 0;
+};
+
 struct DBOptions {
   // The function recovers options to the option as in version 4.6.
   DBOptions* OldDefaults(int rocksdb_major_version = 4,
@@ -1011,6 +1045,19 @@ struct DBOptions {
   // Default: false
   bool skip_checking_sst_file_sizes_on_db_open = false;
 
+  // EXPERIMENTAL
+  // If true, DB::Open() does not open the table files of the DB, which are
+  // instead opened the first time they are read. With max_open_files == -1,
+  // once the DB is open, max_file_opening_threads background threads open
+  // the files that have not been read yet into the table cache, level by
+  // level starting from L0. A missing or corrupted table file is then only
+  // reported when it is read rather than by DB::Open(). Together with
+  // skip_checking_sst_file_sizes_on_db_open, DB::Open() does not touch the
+  // table files at all, which makes it much faster on DBs with many files.
+  //
+  // Default: false
+  bool lazy_table_open = false;
+
   // Recovery mode to control the consistency while replaying WAL
   // Default: kPointInTimeRecovery
   WALRecoveryMode wal_recovery_mode = WALRecoveryMode::kPointInTimeRecovery;
@@ -1196,6 +1243,40 @@ struct DBOptions {
   //
   // Default: hostname
   std::string db_host_id = kHostnameForDbHostId;
+
+  // EXPERIMENTAL
+  // If set, non-trivial compactions are handed to this service, which runs
+  // them outside of the DB process (see CompactionService). The compaction
+  // falls back to running locally if the service returns kUseLocal, and for
+  // compactions that cannot be described to a remote worker, e.g. ones that
+  // write or garbage collect blob files, or that use a snapshot checker.
+  //
+  // Default: nullptr
+  std::shared_ptr<CompactionService> compaction_service = nullptr;
+
+  // EXPERIMENTAL
+  // Target for the 99th percentile latency of DB::Get() (the DB_GET
+  // histogram), in microseconds. If this or write_latency_slo_micros is
+  // non-zero, a feedback controller checks the latencies recorded in
+  // `statistics` every second, and while a target is missed it cuts the
+  // share of resources given to compactions: the rate of `rate_limiter`, the
+  // number of compactions running at once and max_subcompactions. The share
+  // is given back step by step once the latencies are well within their
+  // targets, and at once whenever writes come close to being stalled by L0
+  // files or pending compaction bytes.
+  //
+  // Requires `statistics`. `rate_limiter`, if set, should not be auto-tuned,
+  // and its rate is the upper limit of the controller.
+  //
+  // Default: 0 (no target)
+  uint64_t get_latency_slo_micros = 0;
+
+  // EXPERIMENTAL
+  // Target for the 99th percentile latency of writes (the DB_WRITE
+  // histogram), in microseconds. See get_latency_slo_micros.
+  //
+  // Default: 0 (no target)
+  uint64_t write_latency_slo_micros = 0;
 };
 
 // Options to control the behavior of a database (passed to DB::Open)
@@ -1703,4 +1784,22 @@ struct SizeApproximationOptions {
   double files_size_error_margin = -1.0;
 };
 
+// Options for the worker side of a CompactionService, used with
+// DB::OpenAndCompact(). The worker loads the DB and column family options
+// from the primary's latest OPTIONS file; the fields below cannot be
+// serialized there and must be provided by the worker. Any of them left
+// unset keeps the value from the OPTIONS file (or its default).
+struct CompactionServiceOptionsOverride {
+  Env* env = Env::Default();
+  std::shared_ptr<FileChecksumGenFactory> file_checksum_gen_factory = nullptr;
+
+  const Comparator* comparator = BytewiseComparator();
+  std::shared_ptr<MergeOperator> merge_operator = nullptr;
+  const CompactionFilter* compaction_filter = nullptr;
+  std::shared_ptr<CompactionFilterFactory> compaction_filter_factory = nullptr;
+  std::shared_ptr<const SliceTransform> prefix_extractor = nullptr;
+  std::shared_ptr<TableFactory> table_factory;
+  std::shared_ptr<SstPartitionerFactory> sst_partitioner_factory = nullptr;
+};
+
 }  // namespace ROCKSDB_NAMESPACE
@@ -114,6 +114,12 @@ struct PerfContext {
   // How many values were fed into merge operator by iterators.
   //
   uint64_t internal_merge_count;
+  // Longest run of consecutive point tombstones a single table iterator
+  // stepped over, and the number of the SST file holding that run. Use them
+  // to find the files responsible when seeks are slowed down by tombstones.
+  //
+  uint64_t internal_tombstone_run_max;
+  uint64_t internal_tombstone_run_max_file_number;
 
   uint64_t get_snapshot_time;        // total nanos spent on getting snapshot
   uint64_t get_from_memtable_time;   // total nanos spent on querying memtables
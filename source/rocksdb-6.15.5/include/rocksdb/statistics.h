@@ -533,6 +533,16 @@ class Statistics {
   virtual void histogramData(uint32_t type,
                              HistogramData* const data) const = 0;
   virtual std::string getHistogramString(uint32_t /*type*/) const { return ""; }
+  // Sets `*counts` to the number of values recorded so far in each bucket of
+  // the histogram, following the bucket boundaries of the built-in
+  // implementation. The difference between two calls describes the values
+  // recorded in between, which is how the latency SLO controller (see
+  // DBOptions::get_latency_slo_micros) follows recent latencies. Returns false
+  // if the implementation does not keep such buckets.
+  virtual bool getHistogramBucketCounts(uint32_t /*type*/,
+                                        std::vector<uint64_t>* /*counts*/) const {
+    return false;
+  }
   virtual void recordTick(uint32_t tickerType, uint64_t count = 0) = 0;
   virtual void setTickerCount(uint32_t tickerType, uint64_t count) = 0;
   virtual uint64_t getAndResetTickerCount(uint32_t tickerType) = 0;
@@ -49,6 +49,10 @@ enum ChecksumType : char {
   kCRC32c = 0x1,
   kxxHash = 0x2,
   kxxHash64 = 0x3,
+  // XXH3 (64-bit, truncated to 32 bits), notably faster than the other
+  // hash based checksums on large blocks. Not readable by versions of
+  // RocksDB that predate it.
+  kXXH3 = 0x4,
 };
 
 // `PinningTier` is used to specify which tier of block-based tables should
@@ -73,6 +77,13 @@ enum class PinningTier {
 
   // This tier contains all block-based tables.
   kAll,
+
+  // This tier contains block-based tables that resided in a level up to and
+  // including `MetadataCacheOptions::max_pinned_level` when they were opened.
+  // For example, with `max_pinned_level == 3`, the tables of L0-L3 are in the
+  // tier. Note that tables keep their pinning status when they are trivially
+  // moved to a lower level.
+  kUpToMaxPinnedLevel,
 };
 
 // `MetadataCacheOptions` contains members indicating the desired caching
@@ -98,6 +109,12 @@ struct MetadataCacheOptions {
   // any effect. Otherwise the unpartitioned meta-blocks would be held in table
   // reader memory, outside the block cache.
   PinningTier unpartitioned_pinning = PinningTier::kFallback;
+
+  // The highest level whose tables are in `PinningTier::kUpToMaxPinnedLevel`.
+  // This makes it possible to pin the metadata of the upper levels, which are
+  // small and accessed by most reads, while leaving that of the lower levels
+  // subject to eviction.
+  int max_pinned_level = 0;
 };
 
 // For advanced user only
@@ -128,6 +145,17 @@ struct BlockBasedTableOptions {
   // than data blocks.
   bool cache_index_and_filter_blocks_with_high_priority = true;
 
+  // If cache_index_and_filter_blocks is enabled, cache blocks using three
+  // priority tiers instead of two: top-level indexes and unpartitioned
+  // metadata blocks are cached with the priority implied by
+  // cache_index_and_filter_blocks_with_high_priority, the partitions of
+  // partitioned indexes and filters with Cache::Priority::LOW, and data blocks
+  // with Cache::Priority::BOTTOM. With an LRU cache configured with both
+  // high_pri_pool_ratio and low_pri_pool_ratio (see LRUCacheOptions), this
+  // prevents metadata partitions from being flushed out of the cache by data
+  // blocks while still letting them be evicted when they are not used.
+  bool use_tiered_cache_priority = false;
+
   // DEPRECATED: This option will be removed in a future version. For now, this
   // option still takes effect by updating each of the following variables that
   // has the default value, `PinningTier::kFallback`:
@@ -220,6 +248,18 @@ struct BlockBasedTableOptions {
   // kDataBlockBinaryAndHash.
   double data_block_hash_table_util_ratio = 0.75;
 
+  // If true and data_block_index_type is kDataBlockBinaryAndHash, the data
+  // block hash index also maps the prefixes (as determined by the column
+  // family's prefix_extractor) of the keys in the block to the restart
+  // interval where they start. Seeks then start their search in that restart
+  // interval, typically finding the target with two key comparisons instead
+  // of a binary search over the whole block. This mostly benefits prefix
+  // seeks, e.g. with ReadOptions::prefix_same_as_start.
+  //
+  // Has no effect without a prefix_extractor. Blocks written with this option
+  // cannot be read by older versions of RocksDB.
+  bool data_block_hash_index_for_prefix_seek = false;
+
   // This option is now deprecated. No matter what value it is set to,
   // it will behave as if hash_index_allow_collision=true.
   bool hash_index_allow_collision = true;
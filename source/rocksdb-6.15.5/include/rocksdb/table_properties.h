@@ -61,6 +61,12 @@ struct TablePropertiesNames {
   static const std::string kCreationTime;
   static const std::string kOldestKeyTime;
   static const std::string kFileCreationTime;
+  // Histogram of the lengths of runs of consecutive point tombstones, written
+  // by RocksDB for tables that contain point tombstones. Runs are bucketed by
+  // length, bucket i holding runs of length [4^i, 4^(i+1)) and the last one
+  // everything longer; each bucket is encoded as two varint64s: the number of
+  // runs and the number of tombstones in them.
+  static const std::string kTombstoneRuns;
 };
 
 extern const std::string kPropertiesBlock;
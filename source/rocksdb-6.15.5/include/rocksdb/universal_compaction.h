@@ -72,6 +72,30 @@ class CompactionOptionsUniversal {
   // Default: false
   bool allow_trivial_move;
 
+  // EXPERIMENTAL
+  // If true, sorted runs are merged according to a lazy leveling policy
+  // instead of size_ratio, min_merge_width, max_merge_width and stop_style:
+  // the sorted runs other than the oldest one are grouped into tiers, with
+  // tier i holding runs about max_bytes_for_level_multiplier^i times as
+  // large as a flushed memtable. Once a tier holds max_runs_per_tier runs,
+  // they are merged into a single run of the next tier (tiering), except for
+  // the tier right above the oldest run, whose runs are merged into the
+  // oldest run (leveling). This gives write amplification close to tiered
+  // compaction with the space amplification and point lookup cost of
+  // leveling at the last level.
+  // max_size_amplification_percent is still enforced. Note that the number
+  // of sorted runs, which the level0_*_writes_trigger options limit, can
+  // reach the sum of the per tier limits.
+  // Default: false
+  bool lazy_leveling;
+
+  // Only used with lazy_leveling. The number of sorted runs tier i may hold
+  // before they are merged is max_runs_per_tier[i]; tiers beyond the end of
+  // the vector use its last element. If empty, every tier holds up to
+  // max_bytes_for_level_multiplier runs.
+  // Default: empty
+  std::vector<int> max_runs_per_tier;
+
   // Default set of parameters
   CompactionOptionsUniversal()
       : size_ratio(1),
@@ -80,7 +104,8 @@ class CompactionOptionsUniversal {
         max_size_amplification_percent(200),
         compression_size_percent(-1),
         stop_style(kCompactionStopStyleTotalSize),
-        allow_trivial_move(false) {}
+        allow_trivial_move(false),
+        lazy_leveling(false) {}
 };
 
 }  // namespace ROCKSDB_NAMESPACE
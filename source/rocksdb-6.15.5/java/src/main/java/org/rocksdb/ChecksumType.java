@@ -24,7 +24,11 @@ public enum ChecksumType {
   /**
    * XX Hash 64
    */
-  kxxHash64((byte) 3);
+  kxxHash64((byte) 3),
+  /**
+   * XX Hash 3
+   */
+  kXXH3((byte) 4);
 
   /**
    * Returns the byte value of the enumerations value
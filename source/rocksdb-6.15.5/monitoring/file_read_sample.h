@@ -20,4 +20,11 @@ inline void sample_file_read_inc(FileMetaData* meta) {
   meta->stats.num_reads_sampled.fetch_add(kFileReadSampleRate,
                                           std::memory_order_relaxed);
 }
+
+// Returns the updated estimate of seek misses on the file.
+inline uint64_t sample_file_seek_miss_inc(FileMetaData* meta) {
+  return meta->stats.num_seek_misses_sampled.fetch_add(
+             kFileReadSampleRate, std::memory_order_relaxed) +
+         kFileReadSampleRate;
+}
 }  // namespace ROCKSDB_NAMESPACE
@@ -284,4 +284,12 @@ void HistogramImpl::Data(HistogramData * const data) const {
   stats_.Data(data);
 }
 
+void HistogramImpl::BucketCounts(std::vector<uint64_t>* counts) const {
+  assert(counts);
+  counts->resize(stats_.num_buckets_);
+  for (size_t b = 0; b < stats_.num_buckets_; b++) {
+    (*counts)[b] = stats_.bucket_at(b);
+  }
+}
+
 }  // namespace ROCKSDB_NAMESPACE
@@ -139,6 +139,9 @@ class HistogramImpl : public Histogram {
   virtual double StandardDeviation() const override;
   virtual void Data(HistogramData* const data) const override;
 
+  // Number of values in each bucket of HistogramBucketMapper.
+  void BucketCounts(std::vector<uint64_t>* counts) const;
+
   virtual ~HistogramImpl() {}
 
  private:
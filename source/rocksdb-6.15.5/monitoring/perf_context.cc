@@ -60,6 +60,9 @@ PerfContext::PerfContext(const PerfContext& other) {
   internal_delete_skipped_count = other.internal_delete_skipped_count;
   internal_recent_skipped_count = other.internal_recent_skipped_count;
   internal_merge_count = other.internal_merge_count;
+  internal_tombstone_run_max = other.internal_tombstone_run_max;
+  internal_tombstone_run_max_file_number =
+      other.internal_tombstone_run_max_file_number;
   write_wal_time = other.write_wal_time;
   get_snapshot_time = other.get_snapshot_time;
   get_from_memtable_time = other.get_from_memtable_time;
@@ -157,6 +160,9 @@ PerfContext::PerfContext(PerfContext&& other) noexcept {
   internal_delete_skipped_count = other.internal_delete_skipped_count;
   internal_recent_skipped_count = other.internal_recent_skipped_count;
   internal_merge_count = other.internal_merge_count;
+  internal_tombstone_run_max = other.internal_tombstone_run_max;
+  internal_tombstone_run_max_file_number =
+      other.internal_tombstone_run_max_file_number;
   write_wal_time = other.write_wal_time;
   get_snapshot_time = other.get_snapshot_time;
   get_from_memtable_time = other.get_from_memtable_time;
@@ -256,6 +262,9 @@ PerfContext& PerfContext::operator=(const PerfContext& other) {
   internal_delete_skipped_count = other.internal_delete_skipped_count;
   internal_recent_skipped_count = other.internal_recent_skipped_count;
   internal_merge_count = other.internal_merge_count;
+  internal_tombstone_run_max = other.internal_tombstone_run_max;
+  internal_tombstone_run_max_file_number =
+      other.internal_tombstone_run_max_file_number;
   write_wal_time = other.write_wal_time;
   get_snapshot_time = other.get_snapshot_time;
   get_from_memtable_time = other.get_from_memtable_time;
@@ -352,6 +361,8 @@ void PerfContext::Reset() {
   internal_delete_skipped_count = 0;
   internal_recent_skipped_count = 0;
   internal_merge_count = 0;
+  internal_tombstone_run_max = 0;
+  internal_tombstone_run_max_file_number = 0;
   write_wal_time = 0;
 
   get_snapshot_time = 0;
@@ -472,6 +483,8 @@ std::string PerfContext::ToString(bool exclude_zero_counters) const {
   PERF_CONTEXT_OUTPUT(internal_delete_skipped_count);
   PERF_CONTEXT_OUTPUT(internal_recent_skipped_count);
   PERF_CONTEXT_OUTPUT(internal_merge_count);
+  PERF_CONTEXT_OUTPUT(internal_tombstone_run_max);
+  PERF_CONTEXT_OUTPUT(internal_tombstone_run_max_file_number);
   PERF_CONTEXT_OUTPUT(write_wal_time);
   PERF_CONTEXT_OUTPUT(get_snapshot_time);
   PERF_CONTEXT_OUTPUT(get_from_memtable_time);
@@ -293,6 +293,13 @@ std::string StatisticsImpl::getHistogramString(uint32_t histogramType) const {
   return getHistogramImplLocked(histogramType)->ToString();
 }
 
+bool StatisticsImpl::getHistogramBucketCounts(
+    uint32_t histogramType, std::vector<uint64_t>* counts) const {
+  MutexLock lock(&aggregate_lock_);
+  getHistogramImplLocked(histogramType)->BucketCounts(counts);
+  return true;
+}
+
 void StatisticsImpl::setTickerCount(uint32_t tickerType, uint64_t count) {
   {
     MutexLock lock(&aggregate_lock_);
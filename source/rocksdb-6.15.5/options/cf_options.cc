@@ -5,8 +5,10 @@
 
 #include "options/cf_options.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cinttypes>
+#include <cmath>
 #include <limits>
 #include <string>
 
@@ -208,7 +210,16 @@ static std::unordered_map<std::string, OptionTypeInfo>
         {"allow_trivial_move",
          {offsetof(class CompactionOptionsUniversal, allow_trivial_move),
           OptionType::kBoolean, OptionVerificationType::kNormal,
-          OptionTypeFlags::kMutable}}};
+          OptionTypeFlags::kMutable}},
+        {"lazy_leveling",
+         {offsetof(class CompactionOptionsUniversal, lazy_leveling),
+          OptionType::kBoolean, OptionVerificationType::kNormal,
+          OptionTypeFlags::kMutable}},
+        {"max_runs_per_tier",
+         OptionTypeInfo::Vector<int>(
+             offsetof(class CompactionOptionsUniversal, max_runs_per_tier),
+             OptionVerificationType::kNormal, OptionTypeFlags::kMutable,
+             {0, OptionType::kInt})}};
 
 static std::unordered_map<std::string, OptionTypeInfo>
     cf_mutable_options_type_info = {
@@ -392,6 +403,27 @@ static std::unordered_map<std::string, OptionTypeInfo>
          {offsetof(struct MutableCFOptions, periodic_compaction_seconds),
           OptionType::kUInt64T, OptionVerificationType::kNormal,
           OptionTypeFlags::kMutable}},
+        {"read_triggered_compaction_threshold",
+         {offsetof(struct MutableCFOptions,
+                   read_triggered_compaction_threshold),
+          OptionType::kUInt64T, OptionVerificationType::kNormal,
+          OptionTypeFlags::kMutable}},
+        {"allow_partial_trivial_move",
+         {offsetof(struct MutableCFOptions, allow_partial_trivial_move),
+          OptionType::kBoolean, OptionVerificationType::kNormal,
+          OptionTypeFlags::kMutable}},
+        {"cold_data_age_seconds",
+         {offsetof(struct MutableCFOptions, cold_data_age_seconds),
+          OptionType::kUInt64T, OptionVerificationType::kNormal,
+          OptionTypeFlags::kMutable}},
+        {"compaction_filter_batch_size",
+         {offsetof(struct MutableCFOptions, compaction_filter_batch_size),
+          OptionType::kSizeT, OptionVerificationType::kNormal,
+          OptionTypeFlags::kMutable}},
+        {"compaction_filter_batch_threads",
+         {offsetof(struct MutableCFOptions, compaction_filter_batch_threads),
+          OptionType::kInt, OptionVerificationType::kNormal,
+          OptionTypeFlags::kMutable}},
         {"enable_blob_files",
          {offsetof(struct MutableCFOptions, enable_blob_files),
           OptionType::kBoolean, OptionVerificationType::kNormal,
@@ -416,6 +448,11 @@ static std::unordered_map<std::string, OptionTypeInfo>
          {offsetof(struct MutableCFOptions, blob_garbage_collection_age_cutoff),
           OptionType::kDouble, OptionVerificationType::kNormal,
           OptionTypeFlags::kMutable}},
+        {"blob_garbage_collection_force_threshold",
+         {offsetof(struct MutableCFOptions,
+                   blob_garbage_collection_force_threshold),
+          OptionType::kDouble, OptionVerificationType::kNormal,
+          OptionTypeFlags::kMutable}},
         {"sample_for_compression",
          {offsetof(struct MutableCFOptions, sample_for_compression),
           OptionType::kUInt64T, OptionVerificationType::kNormal,
@@ -877,6 +914,33 @@ uint64_t MaxFileSizeForLevel(const MutableCFOptions& cf_options,
   }
 }
 
+int LazyLevelingTier(const MutableCFOptions& cf_options, uint64_t run_size) {
+  const double multiplier =
+      std::max(cf_options.max_bytes_for_level_multiplier, 2.0);
+  double tier_size = static_cast<double>(cf_options.write_buffer_size);
+  int tier = 0;
+  // A run belongs to the first tier whose (geometric) midpoint it does not
+  // exceed, so that merging the runs of a full tier yields a run of the next
+  // tier despite deduplication and compression.
+  while (static_cast<double>(run_size) > tier_size * std::sqrt(multiplier)) {
+    tier_size *= multiplier;
+    tier++;
+  }
+  return tier;
+}
+
+int LazyLevelingMaxRunsInTier(const MutableCFOptions& cf_options, int tier) {
+  const std::vector<int>& max_runs =
+      cf_options.compaction_options_universal.max_runs_per_tier;
+  int limit;
+  if (max_runs.empty()) {
+    limit = static_cast<int>(cf_options.max_bytes_for_level_multiplier);
+  } else {
+    limit = max_runs[std::min(static_cast<size_t>(tier), max_runs.size() - 1)];
+  }
+  return std::max(limit, 2);
+}
+
 size_t MaxFileSizeForL0MetaPin(const MutableCFOptions& cf_options) {
   // We do not want to pin meta-blocks that almost certainly came from intra-L0
   // or a former larger `write_buffer_size` value to avoid surprising users with
@@ -955,6 +1019,17 @@ void MutableCFOptions::Dump(Logger* log) const {
                  ttl);
   ROCKS_LOG_INFO(log, "              periodic_compaction_seconds: %" PRIu64,
                  periodic_compaction_seconds);
+  ROCKS_LOG_INFO(log, "      read_triggered_compaction_threshold: %" PRIu64,
+                 read_triggered_compaction_threshold);
+  ROCKS_LOG_INFO(log, "               allow_partial_trivial_move: %d",
+                 allow_partial_trivial_move);
+  ROCKS_LOG_INFO(log, "                    cold_data_age_seconds: %" PRIu64,
+                 cold_data_age_seconds);
+  ROCKS_LOG_INFO(log,
+                 "             compaction_filter_batch_size: %" ROCKSDB_PRIszt,
+                 compaction_filter_batch_size);
+  ROCKS_LOG_INFO(log, "          compaction_filter_batch_threads: %d",
+                 compaction_filter_batch_threads);
   std::string result;
   char buf[10];
   for (const auto m : max_bytes_for_level_multiplier_additional) {
@@ -998,6 +1073,18 @@ void MutableCFOptions::Dump(Logger* log) const {
   ROCKS_LOG_INFO(
       log, "compaction_options_universal.allow_trivial_move : %d",
       static_cast<int>(compaction_options_universal.allow_trivial_move));
+  ROCKS_LOG_INFO(log, "compaction_options_universal.lazy_leveling : %d",
+                 static_cast<int>(compaction_options_universal.lazy_leveling));
+  result.clear();
+  for (const auto m : compaction_options_universal.max_runs_per_tier) {
+    snprintf(buf, sizeof(buf), "%d, ", m);
+    result += buf;
+  }
+  if (result.size() >= 2) {
+    result.resize(result.size() - 2);
+  }
+  ROCKS_LOG_INFO(log, "compaction_options_universal.max_runs_per_tier : %s",
+                 result.c_str());
 
   // FIFO Compaction Options
   ROCKS_LOG_INFO(log, "compaction_options_fifo.max_table_files_size : %" PRIu64,
@@ -1018,6 +1105,8 @@ void MutableCFOptions::Dump(Logger* log) const {
                  enable_blob_garbage_collection ? "true" : "false");
   ROCKS_LOG_INFO(log, "       blob_garbage_collection_age_cutoff: %f",
                  blob_garbage_collection_age_cutoff);
+  ROCKS_LOG_INFO(log, "  blob_garbage_collection_force_threshold: %f",
+                 blob_garbage_collection_force_threshold);
 }
 
 MutableCFOptions::MutableCFOptions(const Options& options)
@@ -157,6 +157,13 @@ struct MutableCFOptions {
         max_bytes_for_level_multiplier(options.max_bytes_for_level_multiplier),
         ttl(options.ttl),
         periodic_compaction_seconds(options.periodic_compaction_seconds),
+        read_triggered_compaction_threshold(
+            options.read_triggered_compaction_threshold),
+        allow_partial_trivial_move(options.allow_partial_trivial_move),
+        cold_data_age_seconds(options.cold_data_age_seconds),
+        compaction_filter_batch_size(options.compaction_filter_batch_size),
+        compaction_filter_batch_threads(
+            options.compaction_filter_batch_threads),
         max_bytes_for_level_multiplier_additional(
             options.max_bytes_for_level_multiplier_additional),
         compaction_options_fifo(options.compaction_options_fifo),
@@ -168,6 +175,8 @@ struct MutableCFOptions {
         enable_blob_garbage_collection(options.enable_blob_garbage_collection),
         blob_garbage_collection_age_cutoff(
             options.blob_garbage_collection_age_cutoff),
+        blob_garbage_collection_force_threshold(
+            options.blob_garbage_collection_force_threshold),
         max_sequential_skip_in_iterations(
             options.max_sequential_skip_in_iterations),
         check_flush_compaction_key_order(
@@ -206,6 +215,11 @@ struct MutableCFOptions {
         max_bytes_for_level_multiplier(0),
         ttl(0),
         periodic_compaction_seconds(0),
+        read_triggered_compaction_threshold(0),
+        allow_partial_trivial_move(false),
+        cold_data_age_seconds(0),
+        compaction_filter_batch_size(0),
+        compaction_filter_batch_threads(0),
         compaction_options_fifo(),
         enable_blob_files(false),
         min_blob_size(0),
@@ -213,6 +227,7 @@ struct MutableCFOptions {
         blob_compression_type(kNoCompression),
         enable_blob_garbage_collection(false),
         blob_garbage_collection_age_cutoff(0.0),
+        blob_garbage_collection_force_threshold(0.0),
         max_sequential_skip_in_iterations(0),
         check_flush_compaction_key_order(true),
         paranoid_file_checks(false),
@@ -265,6 +280,11 @@ struct MutableCFOptions {
   double max_bytes_for_level_multiplier;
   uint64_t ttl;
   uint64_t periodic_compaction_seconds;
+  uint64_t read_triggered_compaction_threshold;
+  bool allow_partial_trivial_move;
+  uint64_t cold_data_age_seconds;
+  size_t compaction_filter_batch_size;
+  int compaction_filter_batch_threads;
   std::vector<int> max_bytes_for_level_multiplier_additional;
   CompactionOptionsFIFO compaction_options_fifo;
   CompactionOptionsUniversal compaction_options_universal;
@@ -276,6 +296,7 @@ struct MutableCFOptions {
   CompressionType blob_compression_type;
   bool enable_blob_garbage_collection;
   double blob_garbage_collection_age_cutoff;
+  double blob_garbage_collection_force_threshold;
 
   // Misc options
   uint64_t max_sequential_skip_in_iterations;
@@ -301,6 +322,15 @@ uint64_t MaxFileSizeForLevel(const MutableCFOptions& cf_options,
     int level, CompactionStyle compaction_style, int base_level = 1,
     bool level_compaction_dynamic_level_bytes = false);
 
+// With universal compaction and lazy_leveling, returns the tier of a sorted
+// run of `run_size` bytes: 0 for runs about the size of a flushed memtable,
+// and one more for every max_bytes_for_level_multiplier times larger.
+int LazyLevelingTier(const MutableCFOptions& cf_options, uint64_t run_size);
+
+// Returns the number of sorted runs lazy leveling lets `tier` accumulate
+// before merging them.
+int LazyLevelingMaxRunsInTier(const MutableCFOptions& cf_options, int tier);
+
 // Get the max size of an L0 file for which we will pin its meta-blocks when
 // `pin_l0_filter_and_index_blocks_in_cache` is set.
 size_t MaxFileSizeForL0MetaPin(const MutableCFOptions& cf_options);
@@ -215,6 +215,10 @@ static std::unordered_map<std::string, OptionTypeInfo>
                    skip_checking_sst_file_sizes_on_db_open),
           OptionType::kBoolean, OptionVerificationType::kNormal,
           OptionTypeFlags::kNone}},
+        {"lazy_table_open",
+         {offsetof(struct ImmutableDBOptions, lazy_table_open),
+          OptionType::kBoolean, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
         {"new_table_reader_for_compaction_inputs",
          {offsetof(struct ImmutableDBOptions,
                    new_table_reader_for_compaction_inputs),
@@ -392,6 +396,14 @@ static std::unordered_map<std::string, OptionTypeInfo>
         {"db_host_id",
          {offsetof(struct ImmutableDBOptions, db_host_id), OptionType::kString,
           OptionVerificationType::kNormal, OptionTypeFlags::kCompareNever}},
+        {"get_latency_slo_micros",
+         {offsetof(struct ImmutableDBOptions, get_latency_slo_micros),
+          OptionType::kUInt64T, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
+        {"write_latency_slo_micros",
+         {offsetof(struct ImmutableDBOptions, write_latency_slo_micros),
+          OptionType::kUInt64T, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
         // The following properties were handled as special cases in ParseOption
         // This means that the properties could be read from the options file
         // but never written to the file or compared to each other.
@@ -557,6 +569,7 @@ ImmutableDBOptions::ImmutableDBOptions(const DBOptions& options)
       skip_stats_update_on_db_open(options.skip_stats_update_on_db_open),
       skip_checking_sst_file_sizes_on_db_open(
           options.skip_checking_sst_file_sizes_on_db_open),
+      lazy_table_open(options.lazy_table_open),
       wal_recovery_mode(options.wal_recovery_mode),
       allow_2pc(options.allow_2pc),
       row_cache(options.row_cache),
@@ -580,7 +593,10 @@ ImmutableDBOptions::ImmutableDBOptions(const DBOptions& options)
       max_bgerror_resume_count(options.max_bgerror_resume_count),
       bgerror_resume_retry_interval(options.bgerror_resume_retry_interval),
       allow_data_in_errors(options.allow_data_in_errors),
-      db_host_id(options.db_host_id) {
+      db_host_id(options.db_host_id),
+      compaction_service(options.compaction_service),
+      get_latency_slo_micros(options.get_latency_slo_micros),
+      write_latency_slo_micros(options.write_latency_slo_micros) {
 }
 
 void ImmutableDBOptions::Dump(Logger* log) const {
@@ -602,6 +618,8 @@ void ImmutableDBOptions::Dump(Logger* log) const {
                    info_log.get());
   ROCKS_LOG_HEADER(log, "               Options.max_file_opening_threads: %d",
                    max_file_opening_threads);
+  ROCKS_LOG_HEADER(log, "                        Options.lazy_table_open: %d",
+                   lazy_table_open);
   ROCKS_LOG_HEADER(log, "                             Options.statistics: %p",
                    statistics.get());
   ROCKS_LOG_HEADER(log, "                              Options.use_fsync: %d",
@@ -744,6 +762,13 @@ void ImmutableDBOptions::Dump(Logger* log) const {
                    allow_data_in_errors);
   ROCKS_LOG_HEADER(log, "            Options.db_host_id: %s",
                    db_host_id.c_str());
+  ROCKS_LOG_HEADER(log, "            Options.compaction_service: %s",
+                   compaction_service ? compaction_service->Name() : "None");
+  ROCKS_LOG_HEADER(log, "            Options.get_latency_slo_micros: %" PRIu64,
+                   get_latency_slo_micros);
+  ROCKS_LOG_HEADER(log,
+                   "            Options.write_latency_slo_micros: %" PRIu64,
+                   write_latency_slo_micros);
 }
 
 MutableDBOptions::MutableDBOptions()
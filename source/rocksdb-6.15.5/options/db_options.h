@@ -69,6 +69,7 @@ struct ImmutableDBOptions {
   uint64_t write_thread_slow_yield_usec;
   bool skip_stats_update_on_db_open;
   bool skip_checking_sst_file_sizes_on_db_open;
+  bool lazy_table_open;
   WALRecoveryMode wal_recovery_mode;
   bool allow_2pc;
   std::shared_ptr<Cache> row_cache;
@@ -93,6 +94,9 @@ struct ImmutableDBOptions {
   uint64_t bgerror_resume_retry_interval;
   bool allow_data_in_errors;
   std::string db_host_id;
+  std::shared_ptr<CompactionService> compaction_service;
+  uint64_t get_latency_slo_micros;
+  uint64_t write_latency_slo_micros;
 };
 
 struct MutableDBOptions {
@@ -88,6 +88,12 @@ AdvancedColumnFamilyOptions::AdvancedColumnFamilyOptions(const Options& options)
       report_bg_io_stats(options.report_bg_io_stats),
       ttl(options.ttl),
       periodic_compaction_seconds(options.periodic_compaction_seconds),
+      read_triggered_compaction_threshold(
+          options.read_triggered_compaction_threshold),
+      allow_partial_trivial_move(options.allow_partial_trivial_move),
+      cold_data_age_seconds(options.cold_data_age_seconds),
+      compaction_filter_batch_size(options.compaction_filter_batch_size),
+      compaction_filter_batch_threads(options.compaction_filter_batch_threads),
       sample_for_compression(options.sample_for_compression),
       enable_blob_files(options.enable_blob_files),
       min_blob_size(options.min_blob_size),
@@ -95,7 +101,9 @@ AdvancedColumnFamilyOptions::AdvancedColumnFamilyOptions(const Options& options)
       blob_compression_type(options.blob_compression_type),
       enable_blob_garbage_collection(options.enable_blob_garbage_collection),
       blob_garbage_collection_age_cutoff(
-          options.blob_garbage_collection_age_cutoff) {
+          options.blob_garbage_collection_age_cutoff),
+      blob_garbage_collection_force_threshold(
+          options.blob_garbage_collection_force_threshold) {
   assert(memtable_factory.get() != nullptr);
   if (max_bytes_for_level_multiplier_additional.size() <
       static_cast<unsigned int>(num_levels)) {
@@ -376,6 +384,19 @@ void ColumnFamilyOptions::Dump(Logger* log) const {
     ROCKS_LOG_HEADER(log,
                      "         Options.periodic_compaction_seconds: %" PRIu64,
                      periodic_compaction_seconds);
+    ROCKS_LOG_HEADER(
+        log, " Options.read_triggered_compaction_threshold: %" PRIu64,
+        read_triggered_compaction_threshold);
+    ROCKS_LOG_HEADER(log, "          Options.allow_partial_trivial_move: %s",
+                     allow_partial_trivial_move ? "true" : "false");
+    ROCKS_LOG_HEADER(log,
+                     "               Options.cold_data_age_seconds: %" PRIu64,
+                     cold_data_age_seconds);
+    ROCKS_LOG_HEADER(
+        log, "        Options.compaction_filter_batch_size: %" ROCKSDB_PRIszt,
+        compaction_filter_batch_size);
+    ROCKS_LOG_HEADER(log, "     Options.compaction_filter_batch_threads: %d",
+                     compaction_filter_batch_threads);
     ROCKS_LOG_HEADER(log, "                   Options.enable_blob_files: %s",
                      enable_blob_files ? "true" : "false");
     ROCKS_LOG_HEADER(log,
@@ -390,6 +411,9 @@ void ColumnFamilyOptions::Dump(Logger* log) const {
                      enable_blob_garbage_collection ? "true" : "false");
     ROCKS_LOG_HEADER(log, "  Options.blob_garbage_collection_age_cutoff: %f",
                      blob_garbage_collection_age_cutoff);
+    ROCKS_LOG_HEADER(log,
+                     "Options.blob_garbage_collection_force_threshold: %f",
+                     blob_garbage_collection_force_threshold);
 }  // ColumnFamilyOptions::Dump
 
 void Options::Dump(Logger* log) const {
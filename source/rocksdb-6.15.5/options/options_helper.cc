@@ -136,6 +136,7 @@ DBOptions BuildDBOptions(const ImmutableDBOptions& immutable_db_options,
       immutable_db_options.skip_stats_update_on_db_open;
   options.skip_checking_sst_file_sizes_on_db_open =
       immutable_db_options.skip_checking_sst_file_sizes_on_db_open;
+  options.lazy_table_open = immutable_db_options.lazy_table_open;
   options.wal_recovery_mode = immutable_db_options.wal_recovery_mode;
   options.allow_2pc = immutable_db_options.allow_2pc;
   options.row_cache = immutable_db_options.row_cache;
@@ -168,6 +169,10 @@ DBOptions BuildDBOptions(const ImmutableDBOptions& immutable_db_options,
       immutable_db_options.bgerror_resume_retry_interval;
   options.db_host_id = immutable_db_options.db_host_id;
   options.allow_data_in_errors = immutable_db_options.allow_data_in_errors;
+  options.compaction_service = immutable_db_options.compaction_service;
+  options.get_latency_slo_micros = immutable_db_options.get_latency_slo_micros;
+  options.write_latency_slo_micros =
+      immutable_db_options.write_latency_slo_micros;
   return options;
 }
 
@@ -214,6 +219,15 @@ ColumnFamilyOptions BuildColumnFamilyOptions(
   cf_opts.ttl = mutable_cf_options.ttl;
   cf_opts.periodic_compaction_seconds =
       mutable_cf_options.periodic_compaction_seconds;
+  cf_opts.read_triggered_compaction_threshold =
+      mutable_cf_options.read_triggered_compaction_threshold;
+  cf_opts.allow_partial_trivial_move =
+      mutable_cf_options.allow_partial_trivial_move;
+  cf_opts.cold_data_age_seconds = mutable_cf_options.cold_data_age_seconds;
+  cf_opts.compaction_filter_batch_size =
+      mutable_cf_options.compaction_filter_batch_size;
+  cf_opts.compaction_filter_batch_threads =
+      mutable_cf_options.compaction_filter_batch_threads;
 
   cf_opts.max_bytes_for_level_multiplier_additional.clear();
   for (auto value :
@@ -234,6 +248,8 @@ ColumnFamilyOptions BuildColumnFamilyOptions(
       mutable_cf_options.enable_blob_garbage_collection;
   cf_opts.blob_garbage_collection_age_cutoff =
       mutable_cf_options.blob_garbage_collection_age_cutoff;
+  cf_opts.blob_garbage_collection_force_threshold =
+      mutable_cf_options.blob_garbage_collection_force_threshold;
 
   // Misc options
   cf_opts.max_sequential_skip_in_iterations =
@@ -278,7 +294,8 @@ std::unordered_map<std::string, ChecksumType>
     OptionsHelper::checksum_type_string_map = {{"kNoChecksum", kNoChecksum},
                                                {"kCRC32c", kCRC32c},
                                                {"kxxHash", kxxHash},
-                                               {"kxxHash64", kxxHash64}};
+                                               {"kxxHash64", kxxHash64},
+                                               {"kXXH3", kXXH3}};
 
 std::unordered_map<std::string, CompressionType>
     OptionsHelper::compression_type_string_map = {
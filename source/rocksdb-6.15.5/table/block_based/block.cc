@@ -19,6 +19,7 @@
 #include "port/port.h"
 #include "port/stack_trace.h"
 #include "rocksdb/comparator.h"
+#include "rocksdb/slice_transform.h"
 #include "table/block_based/block_prefix_index.h"
 #include "table/block_based/data_block_footer.h"
 #include "table/format.h"
@@ -242,7 +243,8 @@ void DataBlockIter::SeekImpl(const Slice& target) {
   }
   uint32_t index = 0;
   bool skip_linear_scan = false;
-  bool ok = BinarySeek<DecodeKey>(seek_key, &index, &skip_linear_scan);
+  bool ok = BinarySeek<DecodeKey>(seek_key, &index, &skip_linear_scan,
+                                  GetPrefixRestartHint(seek_key));
 
   if (!ok) {
     return;
@@ -250,6 +252,25 @@ void DataBlockIter::SeekImpl(const Slice& target) {
   FindKeyAfterBinarySeek(seek_key, index, skip_linear_scan);
 }
 
+uint32_t DataBlockIter::GetPrefixRestartHint(const Slice& target) const {
+  if (prefix_extractor_ == nullptr) {
+    return num_restarts_;
+  }
+  assert(data_block_hash_index_ != nullptr);
+  Slice target_user_key = ExtractUserKey(target);
+  if (!prefix_extractor_->InDomain(target_user_key)) {
+    return num_restarts_;
+  }
+  uint8_t entry = data_block_hash_index_->LookupPrefix(
+      data_, prefix_extractor_->Transform(target_user_key));
+  if (entry == kNoEntry) {
+    // No key in the block has the prefix, so there is no better place to
+    // start from.
+    return num_restarts_;
+  }
+  return entry;
+}
+
 // Optimized Seek for point lookup for an internal key `target`
 // target = "seek_user_key @ type | seqno".
 //
@@ -684,7 +705,8 @@ void BlockIter<TValue>::FindKeyAfterBinarySeek(const Slice& target,
 template <class TValue>
 template <typename DecodeKeyFunc>
 bool BlockIter<TValue>::BinarySeek(const Slice& target, uint32_t* index,
-                                   bool* skip_linear_scan) {
+                                   bool* skip_linear_scan,
+                                   uint32_t restart_hint) {
   if (restarts_ == 0) {
     // SST files dedicated to range tombstones are written with index blocks
     // that have no keys while also having `num_restarts_ == 1`. This would
@@ -703,9 +725,17 @@ bool BlockIter<TValue>::BinarySeek(const Slice& target, uint32_t* index,
   // - Any restart keys after index `right` are strictly greater than the target
   //   key.
   int64_t left = -1, right = num_restarts_ - 1;
+  // The restart index to compare against next instead of bisecting, if it
+  // lies in (`left`, `right`].
+  int64_t probe = restart_hint < num_restarts_ ? restart_hint : -1;
   while (left != right) {
-    // The `mid` is computed by rounding up so it lands in (`left`, `right`].
-    int64_t mid = left + (right - left + 1) / 2;
+    int64_t mid;
+    if (probe > left && probe <= right) {
+      mid = probe;
+    } else {
+      // The `mid` is computed by rounding up so it lands in (`left`, `right`].
+      mid = left + (right - left + 1) / 2;
+    }
     uint32_t region_offset = GetRestartPoint(static_cast<uint32_t>(mid));
     uint32_t shared, non_shared;
     const char* key_ptr = DecodeKeyFunc()(
@@ -721,6 +751,9 @@ bool BlockIter<TValue>::BinarySeek(const Slice& target, uint32_t* index,
       // Key at "mid" is smaller than "target". Therefore all
       // blocks before "mid" are uninteresting.
       left = mid;
+      // When the hint is right, the next restart key is greater than
+      // "target", which ends the search with one more comparison.
+      probe = mid == static_cast<int64_t>(restart_hint) ? mid + 1 : -1;
     } else if (cmp > 0) {
       // Key at "mid" is >= "target". Therefore all blocks at or
       // after "mid" are uninteresting.
@@ -942,12 +975,17 @@ Block::Block(BlockContents&& contents, size_t read_amp_bytes_per_bit,
         }
 
         uint16_t map_offset;
+        bool has_prefix_hash_index;
+        UnPackIndexTypeAndNumRestarts(
+            DecodeFixed32(data_ + size_ - sizeof(uint32_t)),
+            nullptr /* index_type */, nullptr /* num_restarts */,
+            &has_prefix_hash_index);
         data_block_hash_index_.Initialize(
             contents.data.data(),
             static_cast<uint16_t>(contents.data.size() -
                                   sizeof(uint32_t)), /*chop off
                                                  NUM_RESTARTS*/
-            &map_offset);
+            &map_offset, has_prefix_hash_index);
 
         restart_offset_ = map_offset - num_restarts_ * sizeof(uint32_t);
 
@@ -971,7 +1009,8 @@ Block::Block(BlockContents&& contents, size_t read_amp_bytes_per_bit,
 DataBlockIter* Block::NewDataIterator(const Comparator* raw_ucmp,
                                       SequenceNumber global_seqno,
                                       DataBlockIter* iter, Statistics* stats,
-                                      bool block_contents_pinned) {
+                                      bool block_contents_pinned,
+                                      const SliceTransform* prefix_extractor) {
   DataBlockIter* ret_iter;
   if (iter != nullptr) {
     ret_iter = iter;
@@ -990,7 +1029,8 @@ DataBlockIter* Block::NewDataIterator(const Comparator* raw_ucmp,
     ret_iter->Initialize(
         raw_ucmp, data_, restart_offset_, num_restarts_, global_seqno,
         read_amp_bitmap_.get(), block_contents_pinned,
-        data_block_hash_index_.Valid() ? &data_block_hash_index_ : nullptr);
+        data_block_hash_index_.Valid() ? &data_block_hash_index_ : nullptr,
+        prefix_extractor);
     if (read_amp_bitmap_) {
       if (read_amp_bitmap_->GetStatistics() != stats) {
         // DB changed the Statistics pointer, we need to notify read_amp_bitmap_
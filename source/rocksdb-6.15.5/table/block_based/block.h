@@ -16,6 +16,7 @@
 #include "db/dbformat.h"
 #include "db/pinned_iterators_manager.h"
 #include "port/malloc.h"
+#include "port/port.h"
 #include "rocksdb/iterator.h"
 #include "rocksdb/options.h"
 #include "rocksdb/statistics.h"
@@ -184,6 +185,10 @@ class Block {
   // will not go away (for example, it's from mmapped file which will not be
   // closed).
   //
+  // If `prefix_extractor` is not nullptr and the block has a prefix hash
+  // index, the index is used to speed up Seek(). `prefix_extractor` must be
+  // the one the block was built with.
+  //
   // NOTE: for the hash based lookup, if a key prefix doesn't match any key,
   // the iterator will simply be set as "invalid", rather than returning
   // the key that is just pass the target key.
@@ -191,7 +196,9 @@ class Block {
                                  SequenceNumber global_seqno,
                                  DataBlockIter* iter = nullptr,
                                  Statistics* stats = nullptr,
-                                 bool block_contents_pinned = false);
+                                 bool block_contents_pinned = false,
+                                 const SliceTransform* prefix_extractor =
+                                     nullptr);
 
   // raw_ucmp is a raw (i.e., not wrapped by `UserComparatorWrapper`) user key
   // comparator.
@@ -464,9 +471,13 @@ class BlockIter : public InternalIteratorBase<TValue> {
   void CorruptionError();
 
  protected:
+  // `restart_hint`, if less than `num_restarts_`, is a restart index that is
+  // likely to be the result. It is compared against first, followed by the
+  // restart index after it, before falling back to bisection.
   template <typename DecodeKeyFunc>
   inline bool BinarySeek(const Slice& target, uint32_t* index,
-                         bool* is_index_key_result);
+                         bool* is_index_key_result,
+                         uint32_t restart_hint = port::kMaxUint32);
 
   void FindKeyAfterBinarySeek(const Slice& target, uint32_t index,
                               bool is_index_key_result);
@@ -479,23 +490,30 @@ class DataBlockIter final : public BlockIter<Slice> {
   DataBlockIter(const Comparator* raw_ucmp, const char* data, uint32_t restarts,
                 uint32_t num_restarts, SequenceNumber global_seqno,
                 BlockReadAmpBitmap* read_amp_bitmap, bool block_contents_pinned,
-                DataBlockHashIndex* data_block_hash_index)
+                DataBlockHashIndex* data_block_hash_index,
+                const SliceTransform* prefix_extractor = nullptr)
       : DataBlockIter() {
     Initialize(raw_ucmp, data, restarts, num_restarts, global_seqno,
-               read_amp_bitmap, block_contents_pinned, data_block_hash_index);
+               read_amp_bitmap, block_contents_pinned, data_block_hash_index,
+               prefix_extractor);
   }
   void Initialize(const Comparator* raw_ucmp, const char* data,
                   uint32_t restarts, uint32_t num_restarts,
                   SequenceNumber global_seqno,
                   BlockReadAmpBitmap* read_amp_bitmap,
                   bool block_contents_pinned,
-                  DataBlockHashIndex* data_block_hash_index) {
+                  DataBlockHashIndex* data_block_hash_index,
+                  const SliceTransform* prefix_extractor = nullptr) {
     InitializeBase(raw_ucmp, data, restarts, num_restarts, global_seqno,
                    block_contents_pinned);
     raw_key_.SetIsUserKey(false);
     read_amp_bitmap_ = read_amp_bitmap;
     last_bitmap_offset_ = current_ + 1;
     data_block_hash_index_ = data_block_hash_index;
+    prefix_extractor_ = data_block_hash_index != nullptr &&
+                                data_block_hash_index->HasPrefixIndex()
+                            ? prefix_extractor
+                            : nullptr;
   }
 
   Slice value() const override {
@@ -582,11 +600,17 @@ class DataBlockIter final : public BlockIter<Slice> {
   int32_t prev_entries_idx_ = -1;
 
   DataBlockHashIndex* data_block_hash_index_;
+  // Non-null iff `data_block_hash_index_` has a prefix hash index, which was
+  // built with this prefix extractor.
+  const SliceTransform* prefix_extractor_;
 
   template <typename DecodeEntryFunc>
   inline bool ParseNextDataKey(const char* limit = nullptr);
 
   bool SeekForGetImpl(const Slice& target);
+  // Returns the restart index recorded in the prefix hash index for the prefix
+  // of `target`, or `num_restarts_` if there is none.
+  uint32_t GetPrefixRestartHint(const Slice& target) const;
   void NextOrReportImpl();
   void SeekToFirstOrReportImpl();
 };
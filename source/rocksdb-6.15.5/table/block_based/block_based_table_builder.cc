@@ -103,6 +103,61 @@ bool GoodCompressionRatio(size_t compressed_size, size_t raw_size) {
   return compressed_size < raw_size - (raw_size / 8u);
 }
 
+// Computes the checksum stored in the trailer of a block with the given
+// (possibly compressed) contents and compression type. `*contents_crc` is set
+// to the crc32c of the contents alone for kCRC32c, and to 0 otherwise.
+uint32_t ComputeBlockChecksum(ChecksumType checksum_type,
+                              const Slice& block_contents,
+                              CompressionType type, uint32_t* contents_crc) {
+  const char type_byte = static_cast<char>(type);
+  uint32_t checksum = 0;
+  *contents_crc = 0;
+  switch (checksum_type) {
+    case kNoChecksum:
+      break;
+    case kCRC32c: {
+      *contents_crc =
+          crc32c::Value(block_contents.data(), block_contents.size());
+      // Extend to cover compression type
+      uint32_t crc = crc32c::Extend(*contents_crc, &type_byte, 1);
+      checksum = crc32c::Mask(crc);
+      break;
+    }
+    case kxxHash: {
+      XXH32_state_t* const state = XXH32_createState();
+      XXH32_reset(state, 0);
+      XXH32_update(state, block_contents.data(), block_contents.size());
+      // Extend to cover compression type
+      XXH32_update(state, &type_byte, 1);
+      checksum = XXH32_digest(state);
+      XXH32_freeState(state);
+      break;
+    }
+    case kxxHash64: {
+      XXH64_state_t* const state = XXH64_createState();
+      XXH64_reset(state, 0);
+      XXH64_update(state, block_contents.data(), block_contents.size());
+      // Extend to cover compression type
+      XXH64_update(state, &type_byte, 1);
+      checksum = Lower32of64(XXH64_digest(state));
+      XXH64_freeState(state);
+      break;
+    }
+    case kXXH3:
+      // XXH3 cannot be cheaply extended by one byte, so hash the contents
+      // and fold in the compression type afterwards.
+      checksum = ModifyChecksumForLastByte(
+          Lower32of64(
+              XXH3p_64bits(block_contents.data(), block_contents.size())),
+          type_byte);
+      break;
+    default:
+      assert(false);
+      break;
+  }
+  return checksum;
+}
+
 }  // namespace
 
 // format_version is the block format as defined in include/rocksdb/table.h
@@ -424,7 +479,10 @@ struct BlockBasedTableBuilder::Rep {
                            ->CanKeysWithDifferentByteContentsBeEqual()
                        ? BlockBasedTableOptions::kDataBlockBinarySearch
                        : table_options.data_block_index_type,
-                   table_options.data_block_hash_table_util_ratio),
+                   table_options.data_block_hash_table_util_ratio,
+                   table_options.data_block_hash_index_for_prefix_seek
+                       ? _moptions.prefix_extractor.get()
+                       : nullptr),
         range_del_block(1 /* block_restart_interval */),
         internal_prefix_transform(_moptions.prefix_extractor.get()),
         compression_type(_compression_type),
@@ -559,10 +617,18 @@ struct BlockBasedTableBuilder::ParallelCompressionRep {
     std::unique_ptr<std::string> data;
     std::unique_ptr<std::string> compressed_data;
     CompressionType compression_type;
+    // Block trailer checksum of compressed_contents, computed by the
+    // compression thread. See ComputeBlockChecksum().
+    uint32_t checksum;
+    uint32_t contents_crc;
     std::unique_ptr<std::string> first_key_in_next_block;
     std::unique_ptr<Keys> keys;
     std::unique_ptr<BlockRepSlot> slot;
     Status status;
+    // Number of pipeline stages (the write thread and, if enabled, the
+    // filter thread) that have yet to finish with this block. The last one
+    // recycles it.
+    std::atomic<int> pending_stages;
   };
   // Use a vector of BlockRep as a buffer for a determined number
   // of BlockRep structures. All data referenced by pointers in
@@ -607,6 +673,15 @@ struct BlockBasedTableBuilder::ParallelCompressionRep {
   WriteQueue write_queue;
   std::unique_ptr<port::Thread> write_thread;
 
+  // Filter queue passes blocks, in order, to the filter thread, which adds
+  // their keys to the filter while the blocks are being compressed and
+  // written. Only used for full (non-partitioned) filters, as block-based and
+  // partitioned filters depend on the block offsets and index partitions
+  // determined by the write thread.
+  typedef WorkQueue<BlockRep*> FilterQueue;
+  FilterQueue filter_queue;
+  std::unique_ptr<port::Thread> filter_thread;
+
   // Estimate output file size when parallel compression is enabled. This is
   // necessary because compression & flush are no longer synchronized,
   // and BlockBasedTableBuilder::FileSize() is no longer accurate.
@@ -723,6 +798,7 @@ struct BlockBasedTableBuilder::ParallelCompressionRep {
         block_rep_pool(parallel_threads),
         compress_queue(parallel_threads),
         write_queue(parallel_threads),
+        filter_queue(parallel_threads),
         first_block_processed(false) {
     for (uint32_t i = 0; i < parallel_threads; i++) {
       block_rep_buf[i].contents = Slice();
@@ -730,6 +806,9 @@ struct BlockBasedTableBuilder::ParallelCompressionRep {
       block_rep_buf[i].data.reset(new std::string());
       block_rep_buf[i].compressed_data.reset(new std::string());
       block_rep_buf[i].compression_type = CompressionType();
+      block_rep_buf[i].checksum = 0;
+      block_rep_buf[i].contents_crc = 0;
+      block_rep_buf[i].pending_stages.store(0, std::memory_order_relaxed);
       block_rep_buf[i].first_key_in_next_block.reset(new std::string());
       block_rep_buf[i].keys.reset(new Keys());
       block_rep_buf[i].slot.reset(new BlockRepSlot());
@@ -773,9 +852,14 @@ struct BlockBasedTableBuilder::ParallelCompressionRep {
   void EmitBlock(BlockRep* block_rep) {
     assert(block_rep != nullptr);
     assert(block_rep->status.ok());
+    block_rep->pending_stages.store(filter_thread ? 2 : 1,
+                                    std::memory_order_relaxed);
     if (!write_queue.push(block_rep->slot.get())) {
       return;
     }
+    if (filter_thread && !filter_queue.push(block_rep)) {
+      return;
+    }
     if (!compress_queue.push(block_rep)) {
       return;
     }
@@ -788,6 +872,16 @@ struct BlockBasedTableBuilder::ParallelCompressionRep {
     }
   }
 
+  // Called by each of the write and filter threads once done with a block.
+  void FinishStage(BlockRep* block_rep) {
+    assert(block_rep != nullptr);
+    if (block_rep->pending_stages.fetch_sub(1, std::memory_order_acq_rel) ==
+        1) {
+      ReapBlock(block_rep);
+    }
+  }
+
+ private:
   // Reap a block from compression thread
   void ReapBlock(BlockRep* block_rep) {
     assert(block_rep != nullptr);
@@ -801,7 +895,6 @@ struct BlockBasedTableBuilder::ParallelCompressionRep {
     }
   }
 
- private:
   BlockRep* PrepareBlockInternal(CompressionType compression_type,
                                  const Slice* first_key_in_next_block) {
     BlockRep* block_rep = nullptr;
@@ -1044,6 +1137,12 @@ void BlockBasedTableBuilder::BGWorkCompression(
                            block_rep->compressed_data.get(),
                            &block_rep->compressed_contents,
                            &(block_rep->compression_type), &block_rep->status);
+    if (block_rep->status.ok()) {
+      // Take checksumming off the write thread as well.
+      block_rep->checksum = ComputeBlockChecksum(
+          rep_->table_options.checksum, block_rep->compressed_contents,
+          block_rep->compression_type, &block_rep->contents_crc);
+    }
     block_rep->slot->Fill(block_rep);
   }
 }
@@ -1159,6 +1258,22 @@ void BlockBasedTableBuilder::WriteRawBlock(const Slice& block_contents,
                                            CompressionType type,
                                            BlockHandle* handle,
                                            bool is_data_block) {
+  // crc32c of block_contents alone, handed to the file writer so that a
+  // crc32c file checksum can be combined from it instead of re-hashing
+  // the block.
+  uint32_t contents_crc = 0;
+  uint32_t checksum = ComputeBlockChecksum(
+      rep_->table_options.checksum, block_contents, type, &contents_crc);
+  WriteRawBlock(block_contents, type, checksum, contents_crc, handle,
+                is_data_block);
+}
+
+void BlockBasedTableBuilder::WriteRawBlock(const Slice& block_contents,
+                                           CompressionType type,
+                                           uint32_t checksum,
+                                           uint32_t contents_crc,
+                                           BlockHandle* handle,
+                                           bool is_data_block) {
   Rep* r = rep_;
   Status s = Status::OK();
   IOStatus io_s = IOStatus::OK();
@@ -1167,46 +1282,14 @@ void BlockBasedTableBuilder::WriteRawBlock(const Slice& block_contents,
   handle->set_size(block_contents.size());
   assert(status().ok());
   assert(io_status().ok());
-  io_s = r->file->Append(block_contents);
+  char trailer[kBlockTrailerSize];
+  trailer[0] = type;
+  if (r->table_options.checksum == kCRC32c) {
+    io_s = r->file->Append(block_contents, contents_crc);
+  } else {
+    io_s = r->file->Append(block_contents);
+  }
   if (io_s.ok()) {
-    char trailer[kBlockTrailerSize];
-    trailer[0] = type;
-    uint32_t checksum = 0;
-    switch (r->table_options.checksum) {
-      case kNoChecksum:
-        break;
-      case kCRC32c: {
-        uint32_t crc =
-            crc32c::Value(block_contents.data(), block_contents.size());
-        // Extend to cover compression type
-        crc = crc32c::Extend(crc, trailer, 1);
-        checksum = crc32c::Mask(crc);
-        break;
-      }
-      case kxxHash: {
-        XXH32_state_t* const state = XXH32_createState();
-        XXH32_reset(state, 0);
-        XXH32_update(state, block_contents.data(), block_contents.size());
-        // Extend to cover compression type
-        XXH32_update(state, trailer, 1);
-        checksum = XXH32_digest(state);
-        XXH32_freeState(state);
-        break;
-      }
-      case kxxHash64: {
-        XXH64_state_t* const state = XXH64_createState();
-        XXH64_reset(state, 0);
-        XXH64_update(state, block_contents.data(), block_contents.size());
-        // Extend to cover compression type
-        XXH64_update(state, trailer, 1);
-        checksum = Lower32of64(XXH64_digest(state));
-        XXH64_freeState(state);
-        break;
-      }
-      default:
-        assert(false);
-        break;
-    }
     EncodeFixed32(trailer + 1, checksum);
     assert(io_s.ok());
     TEST_SYNC_POINT_CALLBACK(
@@ -1267,13 +1350,16 @@ void BlockBasedTableBuilder::BGWorkWriteRawBlock() {
       // Reap block so that blocked Flush() can finish
       // if there is one, and Flush() will notice !ok() next time.
       block_rep->status = Status::OK();
-      r->pc_rep->ReapBlock(block_rep);
+      r->pc_rep->FinishStage(block_rep);
       continue;
     }
 
+    // With a filter thread, the filter builder belongs to it.
+    const bool add_to_filter =
+        r->filter_builder != nullptr && !r->pc_rep->filter_thread;
     for (size_t i = 0; i < block_rep->keys->Size(); i++) {
       auto& key = (*block_rep->keys)[i];
-      if (r->filter_builder != nullptr) {
+      if (add_to_filter) {
         size_t ts_sz =
             r->internal_comparator.user_comparator()->timestamp_size();
         r->filter_builder->Add(ExtractUserKeyAndStripTimestamp(key, ts_sz));
@@ -1283,12 +1369,13 @@ void BlockBasedTableBuilder::BGWorkWriteRawBlock() {
 
     r->pc_rep->file_size_estimator.SetCurrBlockRawSize(block_rep->data->size());
     WriteRawBlock(block_rep->compressed_contents, block_rep->compression_type,
+                  block_rep->checksum, block_rep->contents_crc,
                   &r->pending_handle, true /* is_data_block*/);
     if (!ok()) {
       break;
     }
 
-    if (r->filter_builder != nullptr) {
+    if (add_to_filter) {
       r->filter_builder->StartBlock(r->get_offset());
     }
     r->props.data_size = r->get_offset();
@@ -1305,7 +1392,23 @@ void BlockBasedTableBuilder::BGWorkWriteRawBlock() {
                                       r->pending_handle);
     }
 
-    r->pc_rep->ReapBlock(block_rep);
+    r->pc_rep->FinishStage(block_rep);
+  }
+}
+
+void BlockBasedTableBuilder::BGWorkFilter() {
+  Rep* r = rep_;
+  assert(r->filter_builder != nullptr);
+  const size_t ts_sz =
+      r->internal_comparator.user_comparator()->timestamp_size();
+  ParallelCompressionRep::BlockRep* block_rep = nullptr;
+  while (r->pc_rep->filter_queue.pop(block_rep)) {
+    assert(block_rep != nullptr);
+    for (size_t i = 0; i < block_rep->keys->Size(); i++) {
+      r->filter_builder->Add(
+          ExtractUserKeyAndStripTimestamp((*block_rep->keys)[i], ts_sz));
+    }
+    r->pc_rep->FinishStage(block_rep);
   }
 }
 
@@ -1322,6 +1425,12 @@ void BlockBasedTableBuilder::StartParallelCompression() {
   }
   rep_->pc_rep->write_thread.reset(
       new port::Thread([this] { BGWorkWriteRawBlock(); }));
+  if (rep_->filter_builder != nullptr &&
+      !rep_->filter_builder->IsBlockBased() &&
+      !rep_->table_options.partition_filters) {
+    rep_->pc_rep->filter_thread.reset(
+        new port::Thread([this] { BGWorkFilter(); }));
+  }
 }
 
 void BlockBasedTableBuilder::StopParallelCompression() {
@@ -1331,6 +1440,10 @@ void BlockBasedTableBuilder::StopParallelCompression() {
   }
   rep_->pc_rep->write_queue.finish();
   rep_->pc_rep->write_thread->join();
+  if (rep_->pc_rep->filter_thread) {
+    rep_->pc_rep->filter_queue.finish();
+    rep_->pc_rep->filter_thread->join();
+  }
 }
 
 Status BlockBasedTableBuilder::status() const { return rep_->GetStatus(); }
@@ -127,6 +127,11 @@ class BlockBasedTableBuilder : public TableBuilder {
   // Directly write data to the file.
   void WriteRawBlock(const Slice& data, CompressionType, BlockHandle* handle,
                      bool is_data_block = false);
+  // Same as above, with the block checksum (and for kCRC32c, the crc32c of
+  // `data` alone) already computed, e.g. by a compression thread.
+  void WriteRawBlock(const Slice& data, CompressionType, uint32_t checksum,
+                     uint32_t contents_crc, BlockHandle* handle,
+                     bool is_data_block);
   Status InsertBlockInCache(const Slice& block_contents,
                             const CompressionType type,
                             const BlockHandle* handle);
@@ -176,11 +181,15 @@ class BlockBasedTableBuilder : public TableBuilder {
   // Get compressed blocks from BGWorkCompression and write them into SST
   void BGWorkWriteRawBlock();
 
+  // Add the keys of the blocks emitted for compression to the filter, in
+  // parallel with compressing and writing them. Used for full filters only.
+  void BGWorkFilter();
+
   // Initialize parallel compression context and
-  // start BGWorkCompression and BGWorkWriteRawBlock threads
+  // start BGWorkCompression, BGWorkWriteRawBlock and BGWorkFilter threads
   void StartParallelCompression();
 
-  // Stop BGWorkCompression and BGWorkWriteRawBlock threads
+  // Stop BGWorkCompression, BGWorkWriteRawBlock and BGWorkFilter threads
   void StopParallelCompression();
 };
 
@@ -168,7 +168,8 @@ static std::unordered_map<std::string, PinningTier>
         {"kFallback", PinningTier::kFallback},
         {"kNone", PinningTier::kNone},
         {"kFlushedAndSimilar", PinningTier::kFlushedAndSimilar},
-        {"kAll", PinningTier::kAll}};
+        {"kAll", PinningTier::kAll},
+        {"kUpToMaxPinnedLevel", PinningTier::kUpToMaxPinnedLevel}};
 
 static std::unordered_map<std::string, BlockBasedTableOptions::IndexType>
     block_base_table_index_type_string_map = {
@@ -211,7 +212,11 @@ static std::unordered_map<std::string, OptionTypeInfo>
         {"unpartitioned_pinning",
          OptionTypeInfo::Enum<PinningTier>(
              offsetof(struct MetadataCacheOptions, unpartitioned_pinning),
-             &pinning_tier_type_string_map)}};
+             &pinning_tier_type_string_map)},
+        {"max_pinned_level",
+         {offsetof(struct MetadataCacheOptions, max_pinned_level),
+          OptionType::kInt, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}}};
 
 #endif  // ROCKSDB_LITE
 
@@ -236,6 +241,10 @@ static std::unordered_map<std::string, OptionTypeInfo>
                    cache_index_and_filter_blocks_with_high_priority),
           OptionType::kBoolean, OptionVerificationType::kNormal,
           OptionTypeFlags::kNone}},
+        {"use_tiered_cache_priority",
+         {offsetof(struct BlockBasedTableOptions, use_tiered_cache_priority),
+          OptionType::kBoolean, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
         {"pin_l0_filter_and_index_blocks_in_cache",
          {offsetof(struct BlockBasedTableOptions,
                    pin_l0_filter_and_index_blocks_in_cache),
@@ -261,6 +270,11 @@ static std::unordered_map<std::string, OptionTypeInfo>
                    data_block_hash_table_util_ratio),
           OptionType::kDouble, OptionVerificationType::kNormal,
           OptionTypeFlags::kNone}},
+        {"data_block_hash_index_for_prefix_seek",
+         {offsetof(struct BlockBasedTableOptions,
+                   data_block_hash_index_for_prefix_seek),
+          OptionType::kBoolean, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
         {"checksum",
          {offsetof(struct BlockBasedTableOptions, checksum),
           OptionType::kChecksumType, OptionVerificationType::kNormal,
@@ -581,6 +595,9 @@ std::string BlockBasedTableFactory::GetPrintableOptions() const {
            "  cache_index_and_filter_blocks_with_high_priority: %d\n",
            table_options_.cache_index_and_filter_blocks_with_high_priority);
   ret.append(buffer);
+  snprintf(buffer, kBufferSize, "  use_tiered_cache_priority: %d\n",
+           table_options_.use_tiered_cache_priority);
+  ret.append(buffer);
   snprintf(buffer, kBufferSize,
            "  pin_l0_filter_and_index_blocks_in_cache: %d\n",
            table_options_.pin_l0_filter_and_index_blocks_in_cache);
@@ -600,6 +617,10 @@ std::string BlockBasedTableFactory::GetPrintableOptions() const {
   snprintf(buffer, kBufferSize, "  data_block_hash_table_util_ratio: %lf\n",
            table_options_.data_block_hash_table_util_ratio);
   ret.append(buffer);
+  snprintf(buffer, kBufferSize,
+           "  data_block_hash_index_for_prefix_seek: %d\n",
+           table_options_.data_block_hash_index_for_prefix_seek);
+  ret.append(buffer);
   snprintf(buffer, kBufferSize, "  hash_index_allow_collision: %d\n",
            table_options_.hash_index_allow_collision);
   ret.append(buffer);
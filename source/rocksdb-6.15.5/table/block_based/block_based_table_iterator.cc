@@ -8,6 +8,8 @@
 // found in the LICENSE file. See the AUTHORS file for names of contributors.
 #include "table/block_based/block_based_table_iterator.h"
 
+#include "monitoring/perf_context_imp.h"
+
 namespace ROCKSDB_NAMESPACE {
 void BlockBasedTableIterator::Seek(const Slice& target) { SeekImpl(&target); }
 
@@ -16,6 +18,7 @@ void BlockBasedTableIterator::SeekToFirst() { SeekImpl(nullptr); }
 void BlockBasedTableIterator::SeekImpl(const Slice* target) {
   is_out_of_bound_ = false;
   is_at_first_key_from_index_ = false;
+  tombstone_run_ = 0;
   if (target && !CheckPrefixMayMatch(*target, IterDirection::kForward)) {
     ResetDataIter();
     return;
@@ -93,6 +96,7 @@ void BlockBasedTableIterator::SeekImpl(const Slice* target) {
   }
 
   CheckOutOfBound();
+  TrackTombstoneRun();
 
   if (target) {
     assert(!Valid() || icomp_.Compare(*target, key()) <= 0);
@@ -102,6 +106,7 @@ void BlockBasedTableIterator::SeekImpl(const Slice* target) {
 void BlockBasedTableIterator::SeekForPrev(const Slice& target) {
   is_out_of_bound_ = false;
   is_at_first_key_from_index_ = false;
+  tombstone_run_ = 0;
   // For now totally disable prefix seek in auto prefix mode because we don't
   // have logic
   if (!CheckPrefixMayMatch(target, IterDirection::kBackward)) {
@@ -155,6 +160,7 @@ void BlockBasedTableIterator::SeekForPrev(const Slice& target) {
 
   FindKeyBackward();
   CheckDataBlockWithinUpperBound();
+  TrackTombstoneRun();
   assert(!block_iter_.Valid() ||
          icomp_.Compare(target, block_iter_.key()) >= 0);
 }
@@ -162,6 +168,7 @@ void BlockBasedTableIterator::SeekForPrev(const Slice& target) {
 void BlockBasedTableIterator::SeekToLast() {
   is_out_of_bound_ = false;
   is_at_first_key_from_index_ = false;
+  tombstone_run_ = 0;
   SavePrevIndexValue();
   index_iter_->SeekToLast();
   if (!index_iter_->Valid()) {
@@ -172,6 +179,7 @@ void BlockBasedTableIterator::SeekToLast() {
   block_iter_.SeekToLast();
   FindKeyBackward();
   CheckDataBlockWithinUpperBound();
+  TrackTombstoneRun();
 }
 
 void BlockBasedTableIterator::Next() {
@@ -182,6 +190,7 @@ void BlockBasedTableIterator::Next() {
   block_iter_.Next();
   FindKeyForward();
   CheckOutOfBound();
+  TrackTombstoneRun();
 }
 
 bool BlockBasedTableIterator::NextAndGetResult(IterateResult* result) {
@@ -212,6 +221,7 @@ void BlockBasedTableIterator::Prev() {
   }
 
   FindKeyBackward();
+  TrackTombstoneRun();
 }
 
 void BlockBasedTableIterator::InitDataBlock() {
@@ -358,6 +368,28 @@ void BlockBasedTableIterator::FindKeyBackward() {
   // code simplicity.
 }
 
+void BlockBasedTableIterator::TrackTombstoneRun() {
+#ifndef NPERF_CONTEXT
+  if (LIKELY(perf_level < PerfLevel::kEnableCount) || !Valid()) {
+    return;
+  }
+  switch (ExtractValueType(key())) {
+    case kTypeDeletion:
+    case kTypeSingleDeletion:
+    case kTypeDeletionWithTimestamp:
+      break;
+    default:
+      tombstone_run_ = 0;
+      return;
+  }
+  if (++tombstone_run_ > perf_context.internal_tombstone_run_max) {
+    perf_context.internal_tombstone_run_max = tombstone_run_;
+    perf_context.internal_tombstone_run_max_file_number =
+        table_->get_rep()->sst_number_for_tracing();
+  }
+#endif  // NPERF_CONTEXT
+}
+
 void BlockBasedTableIterator::CheckOutOfBound() {
   if (read_options_.iterate_upper_bound != nullptr &&
       block_upper_bound_check_ != BlockUpperBound::kUpperBoundBeyondCurBlock &&
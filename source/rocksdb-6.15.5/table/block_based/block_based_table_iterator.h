@@ -211,6 +211,9 @@ class BlockBasedTableIterator : public InternalIteratorBase<Slice> {
   bool check_filter_;
   // TODO(Zhongyi): pick a better name
   bool need_upper_bound_check_;
+  // Length of the run of consecutive point tombstones ending at the current
+  // position. Only maintained when perf counters are enabled.
+  uint64_t tombstone_run_ = 0;
 
   // If `target` is null, seek to first.
   void SeekImpl(const Slice* target);
@@ -221,6 +224,9 @@ class BlockBasedTableIterator : public InternalIteratorBase<Slice> {
   void FindBlockForward();
   void FindKeyBackward();
   void CheckOutOfBound();
+  // Updates PerfContext::internal_tombstone_run_max after moving to a new
+  // position. Seeks reset tombstone_run_ before calling it.
+  void TrackTombstoneRun();
 
   // Check if data block is fully within iterate_upper_bound.
   //
@@ -994,9 +994,12 @@ Status BlockBasedTable::PrefetchIndexAndFilterBlocks(
 
   const bool maybe_flushed =
       level == 0 && file_size <= max_file_size_for_l0_meta_pin;
+  const bool up_to_max_pinned_level =
+      level >= 0 &&
+      level <= table_options.metadata_cache_options.max_pinned_level;
   std::function<bool(PinningTier, PinningTier)> is_pinned =
-      [maybe_flushed, &is_pinned](PinningTier pinning_tier,
-                                  PinningTier fallback_pinning_tier) {
+      [maybe_flushed, up_to_max_pinned_level, &is_pinned](
+          PinningTier pinning_tier, PinningTier fallback_pinning_tier) {
         // Fallback to fallback would lead to infinite recursion. Disallow it.
         assert(fallback_pinning_tier != PinningTier::kFallback);
 
@@ -1010,6 +1013,8 @@ Status BlockBasedTable::PrefetchIndexAndFilterBlocks(
             return maybe_flushed;
           case PinningTier::kAll:
             return true;
+          case PinningTier::kUpToMaxPinnedLevel:
+            return up_to_max_pinned_level;
         };
 
         // In GCC, this is needed to suppress `control reaches end of non-void
@@ -1272,6 +1277,39 @@ Status BlockBasedTable::GetDataBlockFromCache(
   return s;
 }
 
+Cache::Priority BlockBasedTable::GetCachePriority(
+    BlockType block_type, const BlockHandle& handle) const {
+  const BlockBasedTableOptions& table_options = rep_->table_options;
+  const Cache::Priority meta_priority =
+      table_options.cache_index_and_filter_blocks_with_high_priority
+          ? Cache::Priority::HIGH
+          : Cache::Priority::LOW;
+
+  switch (block_type) {
+    case BlockType::kIndex:
+    case BlockType::kFilter: {
+      if (!table_options.use_tiered_cache_priority) {
+        return meta_priority;
+      }
+      // The top-level index of a partitioned index/filter (or the
+      // unpartitioned block itself) is the one referenced from the footer or
+      // the metaindex; any other index/filter block is a partition.
+      const BlockHandle& top_level_handle = block_type == BlockType::kIndex
+                                                ? rep_->footer.index_handle()
+                                                : rep_->filter_handle;
+      return handle == top_level_handle ? meta_priority
+                                        : Cache::Priority::LOW;
+    }
+    case BlockType::kCompressionDictionary:
+      return meta_priority;
+    case BlockType::kData:
+      return table_options.use_tiered_cache_priority ? Cache::Priority::BOTTOM
+                                                     : Cache::Priority::LOW;
+    default:
+      return Cache::Priority::LOW;
+  }
+}
+
 template <typename TBlocklike>
 Status BlockBasedTable::PutDataBlockToCache(
     const Slice& block_cache_key, const Slice& compressed_block_cache_key,
@@ -1280,20 +1318,13 @@ Status BlockBasedTable::PutDataBlockToCache(
     CompressionType raw_block_comp_type,
     const UncompressionDict& uncompression_dict,
     MemoryAllocator* memory_allocator, BlockType block_type,
-    GetContext* get_context) const {
+    Cache::Priority priority, GetContext* get_context) const {
   const ImmutableCFOptions& ioptions = rep_->ioptions;
   const uint32_t format_version = rep_->table_options.format_version;
   const size_t read_amp_bytes_per_bit =
       block_type == BlockType::kData
           ? rep_->table_options.read_amp_bytes_per_bit
           : 0;
-  const Cache::Priority priority =
-      rep_->table_options.cache_index_and_filter_blocks_with_high_priority &&
-              (block_type == BlockType::kFilter ||
-               block_type == BlockType::kCompressionDictionary ||
-               block_type == BlockType::kIndex)
-          ? Cache::Priority::HIGH
-          : Cache::Priority::LOW;
   assert(cached_block);
   assert(cached_block->IsEmpty());
 
@@ -1430,7 +1461,8 @@ DataBlockIter* BlockBasedTable::InitBlockIterator<DataBlockIter>(
   return block->NewDataIterator(rep->internal_comparator.user_comparator(),
                                 rep->get_global_seqno(block_type), input_iter,
                                 rep->ioptions.statistics,
-                                block_contents_pinned);
+                                block_contents_pinned,
+                                rep->table_prefix_extractor.get());
 }
 
 template <>
@@ -1544,7 +1576,8 @@ Status BlockBasedTable::MaybeReadBlockAndLoadToCache(
         s = PutDataBlockToCache(
             key, ckey, block_cache, block_cache_compressed, block_entry,
             contents, raw_block_comp_type, uncompression_dict,
-            GetMemoryAllocator(rep_->table_options), block_type, get_context);
+            GetMemoryAllocator(rep_->table_options), block_type,
+            GetCachePriority(block_type, handle), get_context);
       }
     }
   }
@@ -2313,6 +2346,7 @@ Status BlockBasedTable::Get(const ReadOptions& read_options, const Slice& key,
   if (!may_match) {
     RecordTick(rep_->ioptions.statistics, BLOOM_FILTER_USEFUL);
     PERF_COUNTER_BY_LEVEL_ADD(bloom_filter_useful, 1, rep_->level);
+    ++get_context->get_context_stats_.num_filter_useful;
   } else {
     IndexBlockIter iiter_on_stack;
     // if prefix_extractor found in block differs from options, disable
@@ -3218,6 +3252,56 @@ uint64_t BlockBasedTable::ApproximateSize(const Slice& start, const Slice& end,
                                static_cast<double>(rep_->file_size));
 }
 
+Status BlockBasedTable::ApproximateKeyAnchors(const ReadOptions& read_options,
+                                              std::vector<Anchor>& anchors) {
+  // Enough anchors to split a single table evenly across any practical
+  // number of subcompactions, while keeping the cost of sorting the anchors
+  // of all input files of a compaction low.
+  constexpr size_t kMaxNumAnchors = 128;
+
+  BlockCacheLookupContext context(TableReaderCaller::kCompaction);
+  IndexBlockIter iiter_on_stack;
+  ReadOptions ro = read_options;
+  ro.total_order_seek = true;
+  auto index_iter =
+      NewIndexIterator(ro, /*disable_prefix_seek=*/true,
+                       /*input_iter=*/&iiter_on_stack, /*get_context=*/nullptr,
+                       /*lookup_context=*/&context);
+  std::unique_ptr<InternalIteratorBase<IndexValue>> iiter_unique_ptr;
+  if (index_iter != &iiter_on_stack) {
+    iiter_unique_ptr.reset(index_iter);
+  }
+
+  // The index of a table written by us has one entry per data block, so
+  // counting entries first lets every anchor cover the same number of
+  // blocks.
+  size_t num_blocks = 0;
+  for (index_iter->SeekToFirst(); index_iter->Valid(); index_iter->Next()) {
+    num_blocks++;
+  }
+  if (!index_iter->status().ok()) {
+    return index_iter->status();
+  }
+  const size_t blocks_per_anchor =
+      std::max<size_t>(1, (num_blocks + kMaxNumAnchors - 1) / kMaxNumAnchors);
+
+  uint64_t prev_end_offset = 0;
+  size_t block_idx = 0;
+  for (index_iter->SeekToFirst(); index_iter->Valid(); index_iter->Next()) {
+    block_idx++;
+    if (block_idx % blocks_per_anchor != 0 && block_idx != num_blocks) {
+      continue;
+    }
+    const BlockHandle& handle = index_iter->value().handle;
+    const uint64_t end_offset =
+        handle.offset() + handle.size() + kBlockTrailerSize;
+    anchors.emplace_back(index_iter->user_key(),
+                         static_cast<size_t>(end_offset - prev_end_offset));
+    prev_end_offset = end_offset;
+  }
+  return index_iter->status();
+}
+
 bool BlockBasedTable::TEST_FilterBlockInCache() const {
   assert(rep_ != nullptr);
   return TEST_BlockInCache(rep_->filter_handle);
@@ -158,6 +158,11 @@ class BlockBasedTable : public TableReader {
   uint64_t ApproximateSize(const Slice& start, const Slice& end,
                            TableReaderCaller caller) override;
 
+  // Samples the index: each anchor covers about the same number of data
+  // blocks, at most kMaxNumAnchors anchors per table.
+  Status ApproximateKeyAnchors(const ReadOptions& read_options,
+                               std::vector<Anchor>& anchors) override;
+
   bool TEST_BlockInCache(const BlockHandle& handle) const;
 
   // Returns true if the block for the specified key is in cache.
@@ -370,9 +375,16 @@ class BlockBasedTable : public TableReader {
                              CompressionType raw_block_comp_type,
                              const UncompressionDict& uncompression_dict,
                              MemoryAllocator* memory_allocator,
-                             BlockType block_type,
+                             BlockType block_type, Cache::Priority priority,
                              GetContext* get_context) const;
 
+  // Returns the block cache priority of the block of the given type residing
+  // at the given location, based on the table options (see
+  // cache_index_and_filter_blocks_with_high_priority and
+  // use_tiered_cache_priority).
+  Cache::Priority GetCachePriority(BlockType block_type,
+                                   const BlockHandle& handle) const;
+
   // Calls (*handle_result)(arg, ...) repeatedly, starting with the entry found
   // after a call to Seek(key), until handle_result returns false.
   // May not make such a call if filter policy says that key is not present.
@@ -37,6 +37,7 @@
 #include <algorithm>
 #include "db/dbformat.h"
 #include "rocksdb/comparator.h"
+#include "rocksdb/slice_transform.h"
 #include "table/block_based/data_block_footer.h"
 #include "util/coding.h"
 
@@ -46,19 +47,23 @@ BlockBuilder::BlockBuilder(
     int block_restart_interval, bool use_delta_encoding,
     bool use_value_delta_encoding,
     BlockBasedTableOptions::DataBlockIndexType index_type,
-    double data_block_hash_table_util_ratio)
+    double data_block_hash_table_util_ratio,
+    const SliceTransform* prefix_extractor)
     : block_restart_interval_(block_restart_interval),
       use_delta_encoding_(use_delta_encoding),
       use_value_delta_encoding_(use_value_delta_encoding),
       restarts_(),
       counter_(0),
-      finished_(false) {
+      finished_(false),
+      prefix_extractor_(nullptr) {
   switch (index_type) {
     case BlockBasedTableOptions::kDataBlockBinarySearch:
       break;
     case BlockBasedTableOptions::kDataBlockBinaryAndHash:
+      prefix_extractor_ = prefix_extractor;
       data_block_hash_index_builder_.Initialize(
-          data_block_hash_table_util_ratio);
+          data_block_hash_table_util_ratio,
+          prefix_extractor_ != nullptr /* with_prefix_index */);
       break;
     default:
       assert(0);
@@ -123,14 +128,17 @@ Slice BlockBuilder::Finish() {
   uint32_t num_restarts = static_cast<uint32_t>(restarts_.size());
   BlockBasedTableOptions::DataBlockIndexType index_type =
       BlockBasedTableOptions::kDataBlockBinarySearch;
+  bool has_prefix_hash_index = false;
   if (data_block_hash_index_builder_.Valid() &&
       CurrentSizeEstimate() <= kMaxBlockSizeSupportedByHashIndex) {
     data_block_hash_index_builder_.Finish(buffer_);
     index_type = BlockBasedTableOptions::kDataBlockBinaryAndHash;
+    has_prefix_hash_index = data_block_hash_index_builder_.WithPrefixIndex();
   }
 
   // footer is a packed format of data_block_index_type and num_restarts
-  uint32_t block_footer = PackIndexTypeAndNumRestarts(index_type, num_restarts);
+  uint32_t block_footer = PackIndexTypeAndNumRestarts(
+      index_type, num_restarts, has_prefix_hash_index);
 
   PutFixed32(&buffer_, block_footer);
   finished_ = true;
@@ -190,8 +198,14 @@ void BlockBuilder::Add(const Slice& key, const Slice& value,
   }
 
   if (data_block_hash_index_builder_.Valid()) {
-    data_block_hash_index_builder_.Add(ExtractUserKey(key),
-                                       restarts_.size() - 1);
+    Slice user_key = ExtractUserKey(key);
+    data_block_hash_index_builder_.Add(user_key, restarts_.size() - 1);
+    if (prefix_extractor_ != nullptr &&
+        data_block_hash_index_builder_.Valid() &&
+        prefix_extractor_->InDomain(user_key)) {
+      data_block_hash_index_builder_.AddPrefix(
+          prefix_extractor_->Transform(user_key), restarts_.size() - 1);
+    }
   }
 
   counter_++;
@@ -12,6 +12,7 @@
 
 #include <stdint.h>
 #include "rocksdb/slice.h"
+#include "rocksdb/slice_transform.h"
 #include "rocksdb/table.h"
 #include "table/block_based/data_block_hash_index.h"
 
@@ -27,7 +28,8 @@ class BlockBuilder {
                         bool use_value_delta_encoding = false,
                         BlockBasedTableOptions::DataBlockIndexType index_type =
                             BlockBasedTableOptions::kDataBlockBinarySearch,
-                        double data_block_hash_table_util_ratio = 0.75);
+                        double data_block_hash_table_util_ratio = 0.75,
+                        const SliceTransform* prefix_extractor = nullptr);
 
   // Reset the contents as if the BlockBuilder was just constructed.
   void Reset();
@@ -73,6 +75,8 @@ class BlockBuilder {
   bool finished_;  // Has Finish() been called?
   std::string last_key_;
   DataBlockHashIndexBuilder data_block_hash_index_builder_;
+  // Non-null iff the hash index is accompanied by a prefix hash index.
+  const SliceTransform* prefix_extractor_;
 };
 
 }  // namespace ROCKSDB_NAMESPACE
@@ -21,19 +21,35 @@ const uint32_t kMaxNumRestarts = (1u << kDataBlockIndexTypeBitShift) - 1u;
 // 0x7FFFFFFF
 const uint32_t kNumRestartsMask = (1u << kDataBlockIndexTypeBitShift) - 1u;
 
+// Blocks with a hash index are smaller than 64KiB, so they never use the
+// second most significant bit of num_restarts either. It is borrowed to flag
+// the prefix hash index. Readers unaware of the flag see an invalid number of
+// restarts and reject the block rather than misinterpret it.
+const int kPrefixHashIndexBitShift = 30;
+
+// 0x3FFFFFFF
+const uint32_t kHashIndexNumRestartsMask =
+    (1u << kPrefixHashIndexBitShift) - 1u;
+
 uint32_t PackIndexTypeAndNumRestarts(
     BlockBasedTableOptions::DataBlockIndexType index_type,
-    uint32_t num_restarts) {
+    uint32_t num_restarts, bool has_prefix_hash_index) {
   if (num_restarts > kMaxNumRestarts) {
     assert(0);  // mute travis "unused" warning
   }
 
   uint32_t block_footer = num_restarts;
   if (index_type == BlockBasedTableOptions::kDataBlockBinaryAndHash) {
+    assert(num_restarts <= kHashIndexNumRestartsMask);
     block_footer |= 1u << kDataBlockIndexTypeBitShift;
+    if (has_prefix_hash_index) {
+      block_footer |= 1u << kPrefixHashIndexBitShift;
+    }
   } else if (index_type != BlockBasedTableOptions::kDataBlockBinarySearch) {
     assert(0);
   }
+  assert(!has_prefix_hash_index ||
+         index_type == BlockBasedTableOptions::kDataBlockBinaryAndHash);
 
   return block_footer;
 }
@@ -41,17 +57,27 @@ uint32_t PackIndexTypeAndNumRestarts(
 void UnPackIndexTypeAndNumRestarts(
     uint32_t block_footer,
     BlockBasedTableOptions::DataBlockIndexType* index_type,
-    uint32_t* num_restarts) {
+    uint32_t* num_restarts, bool* has_prefix_hash_index) {
+  const bool has_hash_index = block_footer & 1u << kDataBlockIndexTypeBitShift;
   if (index_type) {
-    if (block_footer & 1u << kDataBlockIndexTypeBitShift) {
+    if (has_hash_index) {
       *index_type = BlockBasedTableOptions::kDataBlockBinaryAndHash;
     } else {
       *index_type = BlockBasedTableOptions::kDataBlockBinarySearch;
     }
   }
 
+  if (has_prefix_hash_index) {
+    *has_prefix_hash_index =
+        has_hash_index && (block_footer & 1u << kPrefixHashIndexBitShift);
+  }
+
   if (num_restarts) {
-    *num_restarts = block_footer & kNumRestartsMask;
+    if (has_hash_index) {
+      *num_restarts = block_footer & kHashIndexNumRestartsMask;
+    } else {
+      *num_restarts = block_footer & kNumRestartsMask;
+    }
     assert(*num_restarts <= kMaxNumRestarts);
   }
 }
@@ -13,13 +13,16 @@
 
 namespace ROCKSDB_NAMESPACE {
 
+// `has_prefix_hash_index` is only meaningful for kDataBlockBinaryAndHash; it
+// marks that the hash index is followed by a prefix hash index (see
+// data_block_hash_index.h).
 uint32_t PackIndexTypeAndNumRestarts(
     BlockBasedTableOptions::DataBlockIndexType index_type,
-    uint32_t num_restarts);
+    uint32_t num_restarts, bool has_prefix_hash_index = false);
 
 void UnPackIndexTypeAndNumRestarts(
     uint32_t block_footer,
     BlockBasedTableOptions::DataBlockIndexType* index_type,
-    uint32_t* num_restarts);
+    uint32_t* num_restarts, bool* has_prefix_hash_index = nullptr);
 
 }  // namespace ROCKSDB_NAMESPACE
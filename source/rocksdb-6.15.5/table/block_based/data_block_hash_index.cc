@@ -2,6 +2,7 @@
 //  This source code is licensed under both the GPLv2 (found in the
 //  COPYING file in the root directory) and Apache 2.0 License
 //  (found in the LICENSE.Apache file in the root directory).
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -26,6 +27,28 @@ void DataBlockHashIndexBuilder::Add(const Slice& key,
   estimated_num_buckets_ += bucket_per_key_;
 }
 
+void DataBlockHashIndexBuilder::AddPrefix(const Slice& prefix,
+                                          const size_t restart_index) {
+  assert(Valid());
+  assert(with_prefix_index_);
+  if (restart_index > kMaxRestartSupportedByHashIndex) {
+    valid_ = false;
+    return;
+  }
+
+  if (!prefix_hash_and_restart_pairs_.empty() &&
+      prefix.compare(last_prefix_) == 0) {
+    // The first key of the run already recorded the smallest restart index.
+    return;
+  }
+  last_prefix_.assign(prefix.data(), prefix.size());
+
+  uint32_t hash_value = GetSliceHash(prefix);
+  prefix_hash_and_restart_pairs_.emplace_back(
+      hash_value, static_cast<uint8_t>(restart_index));
+  estimated_num_prefix_buckets_ += bucket_per_key_;
+}
+
 void DataBlockHashIndexBuilder::Finish(std::string& buffer) {
   assert(Valid());
   uint16_t num_buckets = static_cast<uint16_t>(estimated_num_buckets_);
@@ -63,17 +86,62 @@ void DataBlockHashIndexBuilder::Finish(std::string& buffer) {
   // write NUM_BUCK
   PutFixed16(&buffer, num_buckets);
 
+  if (with_prefix_index_) {
+    uint16_t num_prefix_buckets =
+        static_cast<uint16_t>(estimated_num_prefix_buckets_);
+    if (num_prefix_buckets == 0) {
+      num_prefix_buckets = 1;  // sanity check
+    }
+    // Odd for the same reason as num_buckets.
+    num_prefix_buckets |= 1;
+
+    std::vector<uint8_t> prefix_buckets(num_prefix_buckets, kNoEntry);
+    for (auto& entry : prefix_hash_and_restart_pairs_) {
+      uint16_t buck_idx =
+          static_cast<uint16_t>(entry.first % num_prefix_buckets);
+      // kNoEntry is larger than any restart index, so taking the minimum
+      // also fills empty buckets.
+      prefix_buckets[buck_idx] = std::min(prefix_buckets[buck_idx],
+                                          entry.second);
+    }
+
+    for (uint8_t restart_index : prefix_buckets) {
+      buffer.append(
+          const_cast<const char*>(reinterpret_cast<char*>(&restart_index)),
+          sizeof(restart_index));
+    }
+
+    // write NUM_PREFIX_BUCK
+    PutFixed16(&buffer, num_prefix_buckets);
+  }
+
   assert(buffer.size() <= kMaxBlockSizeSupportedByHashIndex);
 }
 
 void DataBlockHashIndexBuilder::Reset() {
   estimated_num_buckets_ = 0;
+  estimated_num_prefix_buckets_ = 0;
   valid_ = true;
   hash_and_restart_pairs_.clear();
+  prefix_hash_and_restart_pairs_.clear();
+  last_prefix_.clear();
 }
 
 void DataBlockHashIndex::Initialize(const char* data, uint16_t size,
-                                    uint16_t* map_offset) {
+                                    uint16_t* map_offset,
+                                    bool has_prefix_index) {
+  num_prefix_buckets_ = 0;
+  prefix_map_offset_ = 0;
+  if (has_prefix_index) {
+    assert(size >= sizeof(uint16_t));  // NUM_PREFIX_BUCKETS
+    num_prefix_buckets_ = DecodeFixed16(data + size - sizeof(uint16_t));
+    assert(num_prefix_buckets_ > 0);
+    assert(size > num_prefix_buckets_ * sizeof(uint8_t));
+    prefix_map_offset_ = static_cast<uint16_t>(
+        size - sizeof(uint16_t) - num_prefix_buckets_ * sizeof(uint8_t));
+    // The hash index ends where the prefix hash index starts.
+    size = prefix_map_offset_;
+  }
   assert(size >= sizeof(uint16_t));  // NUM_BUCKETS
   num_buckets_ = DecodeFixed16(data + size - sizeof(uint16_t));
   assert(num_buckets_ > 0);
@@ -90,4 +158,13 @@ uint8_t DataBlockHashIndex::Lookup(const char* data, uint32_t map_offset,
   return static_cast<uint8_t>(*(bucket_table + idx * sizeof(uint8_t)));
 }
 
+uint8_t DataBlockHashIndex::LookupPrefix(const char* data,
+                                         const Slice& prefix) const {
+  assert(HasPrefixIndex());
+  uint32_t hash_value = GetSliceHash(prefix);
+  uint16_t idx = static_cast<uint16_t>(hash_value % num_prefix_buckets_);
+  const char* bucket_table = data + prefix_map_offset_;
+  return static_cast<uint8_t>(*(bucket_table + idx * sizeof(uint8_t)));
+}
+
 }  // namespace ROCKSDB_NAMESPACE
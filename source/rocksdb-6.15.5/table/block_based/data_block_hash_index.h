@@ -61,6 +61,26 @@ namespace ROCKSDB_NAMESPACE {
 //
 // Note that we only support blocks with #restart_interval < 254. If a block
 // has more restart interval than that, hash index will not be create for it.
+//
+// Optionally, a prefix hash index follows the hash index to accelerate
+// Seek() with a prefix extractor (e.g. `ReadOptions::prefix_same_as_start`).
+// Its presence is flagged by the second most significant bit of the FOOTER
+// (see data_block_footer.cc):
+//
+// DATA_BLOCK: [RI RI RI ... RI RI_IDX HASH_IDX PREFIX_HASH_IDX FOOTER]
+//
+// PREFIX_HASH_IDX: [P P P ... P NUM_PREFIX_BUCK]
+//
+// P:               bucket, uint8_t. The smallest restart index of the restart
+//                  intervals containing a key whose prefix hashes to the
+//                  bucket, or kNoEntry.
+// NUM_PREFIX_BUCK: Number of prefix buckets.
+//
+// Since keys sharing a prefix are adjacent in the block, the restart interval
+// of the first key having a prefix is where a seek to the prefix lands. On
+// collisions the bucket keeps the smallest restart index, so the lookup only
+// gives a hint where to start searching, which Seek() verifies against the
+// restart keys.
 
 const uint8_t kNoEntry = 255;
 const uint8_t kCollision = 254;
@@ -75,18 +95,24 @@ class DataBlockHashIndexBuilder {
   DataBlockHashIndexBuilder()
       : bucket_per_key_(-1 /*uninitialized marker*/),
         estimated_num_buckets_(0),
-        valid_(false) {}
+        estimated_num_prefix_buckets_(0),
+        valid_(false),
+        with_prefix_index_(false) {}
 
-  void Initialize(double util_ratio) {
+  void Initialize(double util_ratio, bool with_prefix_index = false) {
     if (util_ratio <= 0) {
       util_ratio = kDefaultUtilRatio;  // sanity check
     }
     bucket_per_key_ = 1 / util_ratio;
     valid_ = true;
+    with_prefix_index_ = with_prefix_index;
   }
 
   inline bool Valid() const { return valid_ && bucket_per_key_ > 0; }
+  inline bool WithPrefixIndex() const { return with_prefix_index_; }
   void Add(const Slice& key, const size_t restart_index);
+  // REQUIRES: WithPrefixIndex()
+  void AddPrefix(const Slice& prefix, const size_t restart_index);
   void Finish(std::string& buffer);
   void Reset();
   inline size_t EstimateSize() const {
@@ -96,32 +122,56 @@ class DataBlockHashIndexBuilder {
     // Maching the num_buckets number in DataBlockHashIndexBuilder::Finish.
     estimated_num_buckets |= 1;
 
-    return sizeof(uint16_t) +
-           static_cast<size_t>(estimated_num_buckets * sizeof(uint8_t));
+    size_t estimate =
+        sizeof(uint16_t) +
+        static_cast<size_t>(estimated_num_buckets * sizeof(uint8_t));
+    if (with_prefix_index_) {
+      uint16_t estimated_num_prefix_buckets =
+          static_cast<uint16_t>(estimated_num_prefix_buckets_);
+      estimated_num_prefix_buckets |= 1;
+      estimate += sizeof(uint16_t) +
+                  static_cast<size_t>(estimated_num_prefix_buckets *
+                                      sizeof(uint8_t));
+    }
+    return estimate;
   }
 
  private:
   double bucket_per_key_;  // is the multiplicative inverse of util_ratio_
   double estimated_num_buckets_;
+  double estimated_num_prefix_buckets_;
 
   // Now the only usage for `valid_` is to mark false when the inserted
   // restart_index is larger than supported. In this case HashIndex is not
   // appended to the block content.
   bool valid_;
+  bool with_prefix_index_;
 
   std::vector<std::pair<uint32_t, uint8_t>> hash_and_restart_pairs_;
+  std::vector<std::pair<uint32_t, uint8_t>> prefix_hash_and_restart_pairs_;
+  // The last prefix passed to AddPrefix(), used to record each run of keys
+  // sharing a prefix only once.
+  std::string last_prefix_;
   friend class DataBlockHashIndex_DataBlockHashTestSmall_Test;
 };
 
 class DataBlockHashIndex {
  public:
-  DataBlockHashIndex() : num_buckets_(0) {}
+  DataBlockHashIndex()
+      : num_buckets_(0), num_prefix_buckets_(0), prefix_map_offset_(0) {}
 
-  void Initialize(const char* data, uint16_t size, uint16_t* map_offset);
+  void Initialize(const char* data, uint16_t size, uint16_t* map_offset,
+                  bool has_prefix_index = false);
 
   uint8_t Lookup(const char* data, uint32_t map_offset, const Slice& key) const;
 
+  // Returns the restart index recorded for `prefix`, or kNoEntry if no key in
+  // the block has the prefix.
+  // REQUIRES: HasPrefixIndex()
+  uint8_t LookupPrefix(const char* data, const Slice& prefix) const;
+
   inline bool Valid() { return num_buckets_ != 0; }
+  inline bool HasPrefixIndex() const { return num_prefix_buckets_ != 0; }
 
  private:
   // To make the serialized hash index compact and to save the space overhead,
@@ -131,6 +181,8 @@ class DataBlockHashIndex {
   // So in other words, DataBlockHashIndex does not support block size equal
   // or greater then 64KiB.
   uint16_t num_buckets_;
+  uint16_t num_prefix_buckets_;
+  uint16_t prefix_map_offset_;
 };
 
 }  // namespace ROCKSDB_NAMESPACE
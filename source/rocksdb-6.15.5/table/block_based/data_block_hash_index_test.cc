@@ -11,6 +11,7 @@
 
 #include "db/table_properties_collector.h"
 #include "rocksdb/slice.h"
+#include "rocksdb/slice_transform.h"
 #include "table/block_based/block.h"
 #include "table/block_based/block_based_table_reader.h"
 #include "table/block_based/block_builder.h"
@@ -529,6 +530,82 @@ TEST(DataBlockHashIndex, BlockTestLarge) {
   }
 }
 
+TEST(DataBlockHashIndex, BlockTestPrefixSeek) {
+  std::unique_ptr<const SliceTransform> prefix_extractor(
+      NewFixedPrefixTransform(6));
+  const InternalKeyComparator icmp(BytewiseComparator());
+
+  // Keys with even primary keys only, so that odd ones serve as prefixes
+  // absent from the block.
+  std::vector<std::string> keys;
+  std::vector<std::string> values;
+  GenerateRandomKVs(&keys, &values, 0 /* from */, 120 /* len */, 2 /* step */,
+                    0 /* padding_size */, 5 /* keys_share_prefix */);
+
+  // A block using binary search only serves as the reference.
+  BlockBuilder ref_builder(4 /* block_restart_interval */);
+  for (size_t i = 0; i < keys.size(); i++) {
+    InternalKey ikey(keys[i], 0, kTypeValue);
+    ref_builder.Add(ikey.Encode().ToString(), values[i]);
+  }
+  BlockContents ref_contents;
+  ref_contents.data = ref_builder.Finish();
+  Block ref_reader(std::move(ref_contents));
+
+  // A high util ratio leads to many prefix hash collisions.
+  for (double util_ratio : {0.75, 10.0}) {
+    BlockBuilder builder(4 /* block_restart_interval */,
+                         true /* use_delta_encoding */,
+                         false /* use_value_delta_encoding */,
+                         BlockBasedTableOptions::kDataBlockBinaryAndHash,
+                         util_ratio, prefix_extractor.get());
+    for (size_t i = 0; i < keys.size(); i++) {
+      InternalKey ikey(keys[i], 0, kTypeValue);
+      builder.Add(ikey.Encode().ToString(), values[i]);
+    }
+    BlockContents contents;
+    contents.data = builder.Finish();
+    Block reader(std::move(contents));
+    ASSERT_EQ(BlockBasedTableOptions::kDataBlockBinaryAndHash,
+              reader.IndexType());
+    ASSERT_EQ(ref_reader.NumRestarts(), reader.NumRestarts());
+
+    std::unique_ptr<DataBlockIter> ref_iter(ref_reader.NewDataIterator(
+        icmp.user_comparator(), kDisableGlobalSequenceNumber));
+    std::unique_ptr<DataBlockIter> iter(reader.NewDataIterator(
+        icmp.user_comparator(), kDisableGlobalSequenceNumber,
+        nullptr /* iter */, nullptr /* stats */,
+        false /* block_contents_pinned */, prefix_extractor.get()));
+
+    Random rnd(301);
+    for (int primary_key = -1; primary_key <= 121; primary_key++) {
+      std::string prefix = GenerateKey(primary_key, 0, 0, &rnd).substr(0, 6);
+      for (const std::string& ukey :
+           {prefix, GenerateKey(primary_key, 2, 0, &rnd),
+            GenerateKey(primary_key, 2, 0, &rnd) + "0",
+            GenerateKey(primary_key, 9, 0, &rnd)}) {
+        InternalKey ikey(ukey, kMaxSequenceNumber, kValueTypeForSeek);
+        ref_iter->Seek(ikey.Encode());
+        iter->Seek(ikey.Encode());
+        ASSERT_OK(iter->status());
+        ASSERT_EQ(ref_iter->Valid(), iter->Valid()) << ukey;
+        if (ref_iter->Valid()) {
+          ASSERT_EQ(ref_iter->key(), iter->key()) << ukey;
+          ASSERT_EQ(ref_iter->value(), iter->value()) << ukey;
+        }
+      }
+    }
+
+    // Point lookups are unaffected by the prefix hash index.
+    for (size_t i = 0; i < keys.size(); i++) {
+      InternalKey ikey(keys[i], kMaxSequenceNumber, kValueTypeForSeek);
+      ASSERT_TRUE(iter->SeekForGet(ikey.Encode()));
+      ASSERT_TRUE(iter->Valid());
+      ASSERT_EQ(values[i], iter->value());
+    }
+  }
+}
+
 // helper routine for DataBlockHashIndex.BlockBoundary
 void TestBoundary(InternalKey& ik1, std::string& v1, InternalKey& ik2,
                   std::string& v2, InternalKey& seek_ikey,
@@ -9,6 +9,7 @@
 #include "table/block_based/reader_common.h"
 
 #include "monitoring/perf_context_imp.h"
+#include "table/format.h"
 #include "util/coding.h"
 #include "util/crc32c.h"
 #include "util/hash.h"
@@ -47,6 +48,10 @@ Status VerifyBlockChecksum(ChecksumType type, const char* data,
     case kxxHash64:
       computed = Lower32of64(XXH64(data, len, 0));
       break;
+    case kXXH3:
+      computed = ModifyChecksumForLastByte(
+          Lower32of64(XXH3p_64bits(data, block_size)), data[block_size]);
+      break;
     default:
       s = Status::Corruption(
           "unknown checksum type " + ToString(type) + " from footer of " +
@@ -0,0 +1,163 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+
+#include <cassert>
+
+#include "db/dbformat.h"
+#include "table/internal_iterator.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// Exposes only the entries of `iter` whose internal keys fall into
+// [smallest, largest]. Used for the table files of which only a key range
+// belongs to the LSM tree, see FileMetaData::virtual_range_size.
+//
+// The bounds are not copied and must outlive the iterator. `iter` is owned by
+// the ClippingIterator; if `arena_mode` is true, both iterators are allocated
+// from the same arena and `iter` is only destroyed, not deleted.
+class ClippingIterator : public InternalIterator {
+ public:
+  ClippingIterator(InternalIterator* iter, const Slice& smallest,
+                   const Slice& largest, const InternalKeyComparator* icmp,
+                   bool arena_mode)
+      : iter_(iter),
+        smallest_(smallest),
+        largest_(largest),
+        icmp_(icmp),
+        arena_mode_(arena_mode) {
+    assert(iter_ != nullptr);
+    assert(icmp_->Compare(smallest_, largest_) <= 0);
+  }
+
+  ~ClippingIterator() override {
+    if (arena_mode_) {
+      iter_->~InternalIterator();
+    } else {
+      delete iter_;
+    }
+  }
+
+  bool Valid() const override { return valid_; }
+
+  void SeekToFirst() override {
+    iter_->Seek(smallest_);
+    UpdateValidForward();
+  }
+
+  void SeekToLast() override {
+    iter_->SeekForPrev(largest_);
+    UpdateValidBackward();
+  }
+
+  void Seek(const Slice& target) override {
+    if (icmp_->Compare(target, smallest_) < 0) {
+      iter_->Seek(smallest_);
+    } else {
+      iter_->Seek(target);
+    }
+    UpdateValidForward();
+  }
+
+  void SeekForPrev(const Slice& target) override {
+    if (icmp_->Compare(target, largest_) > 0) {
+      iter_->SeekForPrev(largest_);
+    } else {
+      iter_->SeekForPrev(target);
+    }
+    UpdateValidBackward();
+  }
+
+  void Next() override {
+    assert(valid_);
+    iter_->Next();
+    UpdateValidForward();
+  }
+
+  bool NextAndGetResult(IterateResult* result) override {
+    assert(valid_);
+    valid_ = iter_->NextAndGetResult(result) &&
+             icmp_->Compare(result->key, largest_) <= 0;
+    return valid_;
+  }
+
+  void Prev() override {
+    assert(valid_);
+    iter_->Prev();
+    UpdateValidBackward();
+  }
+
+  Slice key() const override {
+    assert(valid_);
+    return iter_->key();
+  }
+
+  Slice user_key() const override {
+    assert(valid_);
+    return iter_->user_key();
+  }
+
+  Slice value() const override {
+    assert(valid_);
+    return iter_->value();
+  }
+
+  Status status() const override { return iter_->status(); }
+
+  bool PrepareValue() override {
+    assert(valid_);
+    if (!iter_->PrepareValue()) {
+      valid_ = false;
+      return false;
+    }
+    return true;
+  }
+
+  bool MayBeOutOfLowerBound() override {
+    assert(valid_);
+    return iter_->MayBeOutOfLowerBound();
+  }
+
+  IterBoundCheck UpperBoundCheckResult() override {
+    return valid_ ? iter_->UpperBoundCheckResult() : IterBoundCheck::kUnknown;
+  }
+
+  void SetPinnedItersMgr(PinnedIteratorsManager* pinned_iters_mgr) override {
+    iter_->SetPinnedItersMgr(pinned_iters_mgr);
+  }
+
+  bool IsKeyPinned() const override {
+    assert(valid_);
+    return iter_->IsKeyPinned();
+  }
+
+  bool IsValuePinned() const override {
+    assert(valid_);
+    return iter_->IsValuePinned();
+  }
+
+  Status GetProperty(std::string prop_name, std::string* prop) override {
+    return iter_->GetProperty(prop_name, prop);
+  }
+
+ private:
+  void UpdateValidForward() {
+    valid_ = iter_->Valid() && icmp_->Compare(iter_->key(), largest_) <= 0;
+  }
+
+  void UpdateValidBackward() {
+    valid_ = iter_->Valid() && icmp_->Compare(iter_->key(), smallest_) >= 0;
+  }
+
+  InternalIterator* iter_;
+  const Slice smallest_;
+  const Slice largest_;
+  const InternalKeyComparator* icmp_;
+  const bool arena_mode_;
+  bool valid_ = false;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
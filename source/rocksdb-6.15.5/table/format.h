@@ -220,6 +220,15 @@ inline uint64_t block_size(const BlockHandle& handle) {
   return handle.size() + kBlockTrailerSize;
 }
 
+// Mixes the trailing compression type byte into a block checksum that was
+// computed over the block contents only. Used by checksum types whose hash
+// cannot be cheaply extended by one byte (kXXH3), so the builder and the
+// reader both hash exactly the block contents and fold in the last byte.
+inline uint32_t ModifyChecksumForLastByte(uint32_t checksum, char last_byte) {
+  const uint32_t kRandomPrime = 0x6b9083d9;
+  return checksum ^ static_cast<uint8_t>(last_byte) * kRandomPrime;
+}
+
 inline CompressionType get_block_compression_type(const char* block_data,
                                                   size_t block_size) {
   return static_cast<CompressionType>(block_data[block_size]);
@@ -221,6 +221,8 @@ const std::string TablePropertiesNames::kNumDataBlocks =
 const std::string TablePropertiesNames::kNumEntries =
     "rocksdb.num.entries";
 const std::string TablePropertiesNames::kDeletedKeys = "rocksdb.deleted.keys";
+const std::string TablePropertiesNames::kTombstoneRuns =
+    "rocksdb.tombstone.runs";
 const std::string TablePropertiesNames::kMergeOperands =
     "rocksdb.merge.operands";
 const std::string TablePropertiesNames::kNumRangeDeletions =
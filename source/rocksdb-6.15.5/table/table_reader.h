@@ -82,6 +82,24 @@ class TableReader {
   virtual uint64_t ApproximateSize(const Slice& start, const Slice& end,
                                    TableReaderCaller caller) = 0;
 
+  struct Anchor {
+    Anchor(const Slice& _user_key, size_t _range_size)
+        : user_key(_user_key.ToString()), range_size(_range_size) {}
+    // Largest user key of the range.
+    std::string user_key;
+    // Approximate size in bytes of the range, which starts right after the
+    // previous anchor's user key.
+    size_t range_size;
+  };
+
+  // Sample the table into a bounded number of consecutive key ranges of
+  // roughly equal size, appended to `anchors` in key order. Used to split
+  // compactions into evenly sized subcompactions.
+  virtual Status ApproximateKeyAnchors(const ReadOptions& /*read_options*/,
+                                       std::vector<Anchor>& /*anchors*/) {
+    return Status::NotSupported("ApproximateKeyAnchors() not supported.");
+  }
+
   // Set up the table for Compaction. Might change some parameters with
   // posix_fadvise
   virtual void SetupForCompaction() = 0;
@@ -191,6 +191,8 @@ DEFINE_string(
     "Meta operations:\n"
     "\tcompact     -- Compact the entire DB; If multiple, randomly choose one\n"
     "\tcompactall  -- Compact the entire DB\n"
+    "\treopen      -- Close and reopen the DB, and report how long "
+    "DB::Open() took\n"
     "\tstats       -- Print DB stats\n"
     "\tresetstats  -- Reset DB stats\n"
     "\tlevelstats  -- Print the number of files and bytes per level\n"
@@ -436,6 +438,16 @@ DEFINE_int32(universal_compression_size_percent, -1,
 DEFINE_bool(universal_allow_trivial_move, false,
             "Allow trivial move in universal compaction.");
 
+DEFINE_bool(universal_lazy_leveling, false,
+            "Use lazy leveling (tiered upper runs, leveled last run) in "
+            "universal compaction.");
+
+static std::vector<int> FLAGS_universal_max_runs_per_tier_v;
+DEFINE_string(universal_max_runs_per_tier, "",
+              "Comma separated number of sorted runs each tier may hold with "
+              "--universal_lazy_leveling. Empty means "
+              "max_bytes_for_level_multiplier runs per tier.");
+
 DEFINE_int64(cache_size, 8 << 20,  // 8MB
              "Number of bytes to use as a cache of uncompressed data");
 
@@ -539,6 +551,11 @@ DEFINE_double(data_block_hash_table_util_ratio, 0.75,
               "This is only valid if use_data_block_hash_index is "
               "set to true");
 
+DEFINE_bool(data_block_hash_index_for_prefix_seek, false,
+            "Also index key prefixes in the data block hash index to speed "
+            "up seeks. This is only valid if use_data_block_hash_index is "
+            "set to true and a prefix extractor is configured");
+
 DEFINE_int64(compressed_cache_size, -1,
              "Number of bytes to use as a cache of compressed data.");
 
@@ -555,6 +572,10 @@ DEFINE_int32(file_opening_threads,
              "If open_files is set to -1, this option set the number of "
              "threads that will be used to open files during DB::Open()");
 
+DEFINE_bool(lazy_table_open, ROCKSDB_NAMESPACE::Options().lazy_table_open,
+            "Open table files on first access instead of during DB::Open(), "
+            "and warm up the table cache in the background");
+
 DEFINE_bool(new_table_reader_for_compaction_inputs, true,
              "If true, uses a separate file handle for compaction inputs");
 
@@ -613,6 +634,10 @@ DEFINE_bool(read_cache_direct_read, true,
 
 DEFINE_bool(use_keep_filter, false, "Whether to use a noop compaction filter");
 
+DEFINE_uint64(keep_filter_cpu_cost, 0,
+              "Number of times the noop compaction filter hashes each value, "
+              "to emulate a CPU-heavy compaction filter.");
+
 static bool ValidateCacheNumshardbits(const char* flagname, int32_t value) {
   if (value >= 20) {
     fprintf(stderr, "Invalid value for --%s: %d, must be < 20\n",
@@ -692,6 +717,31 @@ DEFINE_uint64(periodic_compaction_seconds,
               "Files older than this will be picked up for compaction and"
               " rewritten to the same level");
 
+DEFINE_uint64(read_triggered_compaction_threshold,
+              ROCKSDB_NAMESPACE::Options().read_triggered_compaction_threshold,
+              "Estimated number of point lookups that search a file in vain "
+              "before it gets compacted into the next level. 0 disables it.");
+
+DEFINE_bool(allow_partial_trivial_move,
+            ROCKSDB_NAMESPACE::Options().allow_partial_trivial_move,
+            "Move the parts of a file picked for leveled compaction that do "
+            "not overlap the next level without rewriting them.");
+
+DEFINE_uint64(cold_data_age_seconds,
+              ROCKSDB_NAMESPACE::Options().cold_data_age_seconds,
+              "Place leveled compaction outputs on the db_paths by the "
+              "temperature of their data; data older than this goes to the "
+              "last path. 0 disables it.");
+
+DEFINE_uint64(compaction_filter_batch_size,
+              ROCKSDB_NAMESPACE::Options().compaction_filter_batch_size,
+              "Number of keys the compaction filter is run on at once through "
+              "CompactionFilter::FilterBatch(). 0 disables batching.");
+
+DEFINE_int32(compaction_filter_batch_threads,
+             ROCKSDB_NAMESPACE::Options().compaction_filter_batch_threads,
+             "Number of threads each compaction filters its batches on.");
+
 static bool ValidateInt32Percent(const char* flagname, int32_t value) {
   if (value <= 0 || value>=100) {
     fprintf(stderr, "Invalid value for --%s: %d, 0< pct <100 \n",
@@ -1066,6 +1116,18 @@ DEFINE_bool(rate_limiter_auto_tuned, false,
             "Enable dynamic adjustment of rate limit according to demand for "
             "background I/O");
 
+DEFINE_uint64(get_latency_slo_micros,
+              ROCKSDB_NAMESPACE::Options().get_latency_slo_micros,
+              "Target p99 latency of Get() in microseconds, which compactions "
+              "are throttled to meet. Implies --statistics. Compare the tail "
+              "latencies of e.g. readwhilewriting with --histogram=1 with and "
+              "without it.");
+
+DEFINE_uint64(write_latency_slo_micros,
+              ROCKSDB_NAMESPACE::Options().write_latency_slo_micros,
+              "Target p99 latency of writes in microseconds, which compactions "
+              "are throttled to meet. Implies --statistics.");
+
 
 DEFINE_bool(sine_write_rate, false,
             "Use a sine wave write_rate_limit");
@@ -2640,13 +2702,22 @@ class Benchmark {
 
   class KeepFilter : public CompactionFilter {
    public:
-    bool Filter(int /*level*/, const Slice& /*key*/, const Slice& /*value*/,
+    bool Filter(int /*level*/, const Slice& /*key*/, const Slice& value,
                 std::string* /*new_value*/,
                 bool* /*value_changed*/) const override {
+      unsigned int hash = 0;
+      for (uint64_t i = 0; i < FLAGS_keep_filter_cpu_cost; i++) {
+        hash = XXH32(value.data(), value.size(), hash);
+      }
+      // Keeps the hashing from being optimized away.
+      hash_sink_.store(hash, std::memory_order_relaxed);
       return false;
     }
 
     const char* Name() const override { return "KeepFilter"; }
+
+   private:
+    mutable std::atomic<unsigned int> hash_sink_{0};
   };
 
   std::shared_ptr<Cache> NewCache(int64_t capacity) {
@@ -3127,6 +3198,8 @@ class Benchmark {
         method = &Benchmark::Compact;
       } else if (name == "compactall") {
         CompactAll();
+      } else if (name == "reopen") {
+        ReopenDB();
       } else if (name == "crc32c") {
         method = &Benchmark::Crc32c;
       } else if (name == "xxhash") {
@@ -3638,6 +3711,8 @@ class Benchmark {
     options.max_background_jobs = FLAGS_max_background_jobs;
     options.max_background_compactions = FLAGS_max_background_compactions;
     options.max_subcompactions = static_cast<uint32_t>(FLAGS_subcompactions);
+    options.get_latency_slo_micros = FLAGS_get_latency_slo_micros;
+    options.write_latency_slo_micros = FLAGS_write_latency_slo_micros;
     options.max_background_flushes = FLAGS_max_background_flushes;
     options.compaction_style = FLAGS_compaction_style_e;
     options.compaction_pri = FLAGS_compaction_pri_e;
@@ -3676,6 +3751,7 @@ class Benchmark {
     }
     options.bloom_locality = FLAGS_bloom_locality;
     options.max_file_opening_threads = FLAGS_file_opening_threads;
+    options.lazy_table_open = FLAGS_lazy_table_open;
     options.new_table_reader_for_compaction_inputs =
         FLAGS_new_table_reader_for_compaction_inputs;
     options.compaction_readahead_size = FLAGS_compaction_readahead_size;
@@ -3854,6 +3930,8 @@ class Benchmark {
       }
       block_based_options.data_block_hash_table_util_ratio =
           FLAGS_data_block_hash_table_util_ratio;
+      block_based_options.data_block_hash_index_for_prefix_seek =
+          FLAGS_data_block_hash_index_for_prefix_seek;
       if (FLAGS_read_cache_path != "") {
 #ifndef ROCKSDB_LITE
         Status rc_status;
@@ -3953,6 +4031,14 @@ class Benchmark {
     options.disable_auto_compactions = FLAGS_disable_auto_compactions;
     options.optimize_filters_for_hits = FLAGS_optimize_filters_for_hits;
     options.periodic_compaction_seconds = FLAGS_periodic_compaction_seconds;
+    options.read_triggered_compaction_threshold =
+        FLAGS_read_triggered_compaction_threshold;
+    options.allow_partial_trivial_move = FLAGS_allow_partial_trivial_move;
+    options.cold_data_age_seconds = FLAGS_cold_data_age_seconds;
+    options.compaction_filter_batch_size =
+        static_cast<size_t>(FLAGS_compaction_filter_batch_size);
+    options.compaction_filter_batch_threads =
+        FLAGS_compaction_filter_batch_threads;
 
     // fill storage options
     options.advise_random_on_open = FLAGS_advise_random_on_open;
@@ -3995,6 +4081,10 @@ class Benchmark {
     }
     options.compaction_options_universal.allow_trivial_move =
         FLAGS_universal_allow_trivial_move;
+    options.compaction_options_universal.lazy_leveling =
+        FLAGS_universal_lazy_leveling;
+    options.compaction_options_universal.max_runs_per_tier =
+        FLAGS_universal_max_runs_per_tier_v;
     if (FLAGS_thread_status_per_interval > 0) {
       options.enable_thread_tracking = true;
     }
@@ -7153,6 +7243,19 @@ class Benchmark {
     }
   }
 
+  void ReopenDB() {
+    if (db_.db == nullptr) {
+      fprintf(stderr, "reopen only supports a single DB (--num_multi_db)\n");
+      ErrorExit();
+    }
+    db_.DeleteDBs();
+    uint64_t start = FLAGS_env->NowMicros();
+    OpenDb(open_options_, FLAGS_db, &db_);
+    uint64_t elapsed = FLAGS_env->NowMicros() - start;
+    fprintf(stdout, "%-12s : %11.3f ms to open the DB\n", "reopen",
+            elapsed / 1000.0);
+  }
+
   void ResetStats() {
     if (db_.db != nullptr) {
       db_.db->ResetStats();
@@ -7281,6 +7384,11 @@ int db_bench_tool(int argc, char** argv) {
   if (FLAGS_statistics) {
     dbstats = ROCKSDB_NAMESPACE::CreateDBStatistics();
   }
+  if (!dbstats && (FLAGS_get_latency_slo_micros > 0 ||
+                   FLAGS_write_latency_slo_micros > 0)) {
+    // The latency SLO controller follows the latencies through statistics.
+    dbstats = ROCKSDB_NAMESPACE::CreateDBStatistics();
+  }
   if (dbstats) {
     dbstats->set_stats_level(static_cast<StatsLevel>(FLAGS_stats_level));
   }
@@ -7298,6 +7406,12 @@ int db_bench_tool(int argc, char** argv) {
 #endif
   }
 
+  std::vector<std::string> max_runs_per_tier =
+      ROCKSDB_NAMESPACE::StringSplit(FLAGS_universal_max_runs_per_tier, ',');
+  for (const auto& max_runs : max_runs_per_tier) {
+    FLAGS_universal_max_runs_per_tier_v.push_back(std::stoi(max_runs));
+  }
+
   FLAGS_compression_type_e =
     StringToCompressionType(FLAGS_compression_type.c_str());
 
@@ -1258,6 +1258,58 @@ uint32_t Extend(uint32_t crc, const char* buf, size_t size) {
   return ChosenExtend(crc, buf, size);
 }
 
+// The polynomial used by crc32c, in reversed bit order.
+static const uint32_t kCrc32cPoly = 0x82f63b78u;
+
+// kX2nTable[k] is x^(2^k) modulo the crc32c polynomial, in reversed bit
+// order (the most significant bit is the coefficient of x^0).
+static const uint32_t kX2nTable[32] = {
+    0x40000000, 0x20000000, 0x08000000, 0x00800000,
+    0x00008000, 0x82f63b78, 0x6ea2d55c, 0x18b8ea18,
+    0x510ac59a, 0xb82be955, 0xb8fdb1e7, 0x88e56f72,
+    0x74c360a4, 0xe4172b16, 0x0d65762a, 0x35d73a62,
+    0x28461564, 0xbf455269, 0xe2ea32dc, 0xfe7740e6,
+    0xf946610b, 0x3c204f8f, 0x538586e3, 0x59726915,
+    0x734d5309, 0xbc1ac763, 0x7d0722cc, 0xd289cabe,
+    0xe94ca9bc, 0x05b74f3f, 0xa51e1f42, 0x40000000,
+};
+
+// Returns a(x) * b(x) modulo the crc32c polynomial.
+static inline uint32_t MultModP(uint32_t a, uint32_t b) {
+  uint32_t m = 1u << 31;
+  uint32_t p = 0;
+  for (;;) {
+    if (a & m) {
+      p ^= b;
+      if ((a & (m - 1)) == 0) {
+        break;
+      }
+    }
+    m >>= 1;
+    b = (b & 1) ? (b >> 1) ^ kCrc32cPoly : b >> 1;
+  }
+  return p;
+}
+
+// Returns x^(8 * n) modulo the crc32c polynomial, i.e. the operator that
+// shifts a crc past n zero bytes.
+static inline uint32_t X8nModP(size_t n) {
+  uint32_t xp = 1u << 31;  // x^0
+  int k = 3;
+  while (n) {
+    if (n & 1) {
+      xp = MultModP(kX2nTable[k & 31], xp);
+    }
+    n >>= 1;
+    k++;
+  }
+  return xp;
+}
+
+uint32_t Crc32cCombine(uint32_t crc1, uint32_t crc2, size_t crc2len) {
+  return MultModP(X8nModP(crc2len), crc1) ^ crc2;
+}
+
 
 }  // namespace crc32c
 }  // namespace ROCKSDB_NAMESPACE
@@ -29,6 +29,13 @@ inline uint32_t Value(const char* data, size_t n) {
   return Extend(0, data, n);
 }
 
+// Return the crc32c of concat(A, B) where crc1 is the crc32c of A and crc2
+// is the crc32c of B, which is crc2len bytes long. B itself is not needed,
+// so checksums computed over adjacent buffers (e.g. the blocks of a file) can
+// be stitched together in O(log(crc2len)) time instead of re-reading the
+// data.
+extern uint32_t Crc32cCombine(uint32_t crc1, uint32_t crc2, size_t crc2len);
+
 static const uint32_t kMaskDelta = 0xa282ead8ul;
 
 // Return a masked representation of crc.
@@ -129,6 +129,23 @@ TEST(CRC, Extend) {
             Extend(Value("hello ", 6), "world", 5));
 }
 
+TEST(CRC, Combine) {
+  ASSERT_EQ(Value("hello world", 11),
+            Crc32cCombine(Value("hello ", 6), Value("world", 5), 5));
+  ASSERT_EQ(Value("hello", 5), Crc32cCombine(Value("hello", 5), 0, 0));
+  ASSERT_EQ(Value("hello", 5), Crc32cCombine(0, Value("hello", 5), 5));
+
+  // Stitch the 3-way test buffer back together from uneven pieces
+  for (auto expected : expectedResults) {
+    const char* data = buffer + expected.offset;
+    size_t first = expected.length / 3;
+    size_t second = expected.length - first;
+    uint32_t result = Crc32cCombine(Value(data, first),
+                                    Value(data + first, second), second);
+    EXPECT_EQ(~expected.crc32c, result);
+  }
+}
+
 TEST(CRC, Mask) {
   uint32_t crc = Value("foo", 3);
   ASSERT_NE(crc, Mask(crc));
@@ -27,6 +27,11 @@ class FileChecksumGenCrc32c : public FileChecksumGenerator {
     checksum_ = crc32c::Extend(checksum_, data, n);
   }
 
+  void UpdateWithCrc32c(const char* /*data*/, size_t n,
+                        uint32_t data_crc32c) override {
+    checksum_ = crc32c::Crc32cCombine(checksum_, data_crc32c, n);
+  }
+
   void Finalize() override {
     assert(checksum_str_.empty());
     // Store as big endian raw bytes
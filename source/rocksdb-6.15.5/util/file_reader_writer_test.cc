@@ -229,6 +229,153 @@ TEST_F(WritableFileWriterTest, AppendStatusReturn) {
   static_cast<FakeWF*>(file->target())->SetIOError(true);
   ASSERT_NOK(writer->Append(std::string(2 * kMb, 'b')));
 }
+
+TEST_F(WritableFileWriterTest, DoubleBufferedDirectWrites) {
+  // The asynchronous writes are only carried out when polled, so the buffer
+  // they write must be left alone until then.
+  struct FakeWrite {
+    std::string* contents;
+    Slice data;
+    uint64_t offset;
+    std::function<void(const IOStatus&, void*)> cb;
+    void* cb_arg;
+    bool done;
+  };
+  struct Counters {
+    int async_writes = 0;
+    int sync_writes = 0;
+    int rewrites = 0;
+    int in_flight = 0;
+    int max_in_flight = 0;
+  };
+  auto write_to = [](std::string* contents, const Slice& data,
+                     uint64_t offset) {
+    if (contents->size() < offset + data.size()) {
+      contents->resize(offset + data.size());
+    }
+    memcpy(&(*contents)[offset], data.data(), data.size());
+  };
+
+  class FakeFile : public FSWritableFile {
+   public:
+    FakeFile(std::string* contents, Counters* counters,
+             std::function<void(std::string*, const Slice&, uint64_t)> write)
+        : contents_(contents), counters_(counters), write_(write) {}
+
+    using FSWritableFile::Append;
+    using FSWritableFile::PositionedAppend;
+
+    bool use_direct_io() const override { return true; }
+    IOStatus Append(const Slice& /*data*/, const IOOptions& /*options*/,
+                    IODebugContext* /*dbg*/) override {
+      return IOStatus::NotSupported("Append");
+    }
+    IOStatus PositionedAppend(const Slice& data, uint64_t offset,
+                              const IOOptions& /*options*/,
+                              IODebugContext* /*dbg*/) override {
+      counters_->sync_writes++;
+      if (offset < contents_->size()) {
+        counters_->rewrites++;
+      }
+      write_(contents_, data, offset);
+      return IOStatus::OK();
+    }
+    IOStatus PositionedAppendAsync(
+        const Slice& data, uint64_t offset, const IOOptions& /*options*/,
+        std::function<void(const IOStatus&, void*)> cb, void* cb_arg,
+        void** io_handle, IOHandleDeleter* del_fn,
+        IODebugContext* /*dbg*/) override {
+      counters_->async_writes++;
+      counters_->in_flight++;
+      counters_->max_in_flight =
+          std::max(counters_->max_in_flight, counters_->in_flight);
+      *io_handle = new FakeWrite{contents_, data, offset, cb, cb_arg, false};
+      *del_fn = [](void* handle) { delete static_cast<FakeWrite*>(handle); };
+      return IOStatus::OK();
+    }
+    IOStatus Truncate(uint64_t size, const IOOptions& /*options*/,
+                      IODebugContext* /*dbg*/) override {
+      contents_->resize(size);
+      return IOStatus::OK();
+    }
+    IOStatus Close(const IOOptions& /*options*/,
+                   IODebugContext* /*dbg*/) override {
+      return IOStatus::OK();
+    }
+    IOStatus Flush(const IOOptions& /*options*/,
+                   IODebugContext* /*dbg*/) override {
+      return IOStatus::OK();
+    }
+    IOStatus Sync(const IOOptions& /*options*/,
+                  IODebugContext* /*dbg*/) override {
+      return IOStatus::OK();
+    }
+
+   private:
+    std::string* contents_;
+    Counters* counters_;
+    std::function<void(std::string*, const Slice&, uint64_t)> write_;
+  };
+
+  class FakeFS : public FileSystemWrapper {
+   public:
+    FakeFS(Counters* counters,
+           std::function<void(std::string*, const Slice&, uint64_t)> write)
+        : FileSystemWrapper(FileSystem::Default()),
+          counters_(counters),
+          write_(write) {}
+
+    IOStatus Poll(std::vector<void*>& io_handles,
+                  size_t /*min_completions*/) override {
+      for (void* handle : io_handles) {
+        FakeWrite* w = static_cast<FakeWrite*>(handle);
+        if (w != nullptr && !w->done) {
+          write_(w->contents, w->data, w->offset);
+          w->done = true;
+          counters_->in_flight--;
+          w->cb(IOStatus::OK(), w->cb_arg);
+        }
+      }
+      return IOStatus::OK();
+    }
+
+   private:
+    Counters* counters_;
+    std::function<void(std::string*, const Slice&, uint64_t)> write_;
+  };
+
+  std::string contents;
+  Counters counters;
+  FakeFS fs(&counters, write_to);
+  FileOptions file_options;
+  file_options.writable_file_max_buffer_size = 64 << 10;
+  std::unique_ptr<WritableFileWriter> writer(new WritableFileWriter(
+      std::unique_ptr<FSWritableFile>(
+          new FakeFile(&contents, &counters, write_to)),
+      "" /* don't care */, file_options, nullptr /* env */,
+      nullptr /* io_tracer */, nullptr /* stats */, {} /* listeners */,
+      nullptr /* file_checksum_gen_factory */, &fs));
+
+  Random r(301);
+  std::string expected;
+  for (int i = 0; i < 200; i++) {
+    std::string chunk = r.RandomString(r.Uniform(10000) + 1);
+    ASSERT_OK(writer->Append(chunk));
+    expected.append(chunk);
+    if (i % 20 == 0) {
+      ASSERT_OK(writer->Flush());
+      ASSERT_EQ(0, counters.in_flight);
+      // Only whole pages are written by Flush().
+      ASSERT_EQ(0, contents.size() % kDefaultPageSize);
+      ASSERT_EQ(expected.substr(0, contents.size()), contents);
+    }
+  }
+  ASSERT_GT(counters.async_writes, 0);
+  ASSERT_EQ(1, counters.max_in_flight);
+  ASSERT_OK(writer->Close());
+  ASSERT_EQ(0, counters.rewrites);
+  ASSERT_EQ(expected, contents);
+}
 #endif
 
 class ReadaheadRandomAccessFileTest